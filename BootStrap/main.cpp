@@ -59,8 +59,13 @@ void on_app_cmd(android_app *p_state, int32_t cmd)
             is_initialized = true;
             break;
         }
-        case APP_CMD_CONTENT_RECT_CHANGED: {
-
+        case APP_CMD_CONTENT_RECT_CHANGED:
+        case APP_CMD_WINDOW_REDRAW_NEEDED: {
+            //the surface may have lost the pixels a partial redraw would keep
+            if (is_initialized)
+            {
+                DoDo::Application::get().On_Window_Exposed(DoDo::Application::get().get_first_window()->get_native_window());
+            }
             break;
         }
         case APP_CMD_GAINED_FOCUS: {
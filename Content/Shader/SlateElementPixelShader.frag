@@ -12,7 +12,14 @@ layout(set = 0, binding = 0) uniform ShaderParams{
 	vec4 shader_param2;
 	int shader_type;
 } shader_param;
-layout(set = 0, binding = 1) uniform sampler2D element_texture;
+//bindless, size matches SLATE_VULKAN_MAX_BINDLESS_TEXTURES
+layout(set = 0, binding = 1) uniform sampler2D element_textures[4096];
+
+//follows the view projection matrix of the vertex shader
+layout( push_constant ) uniform constants
+{
+	layout(offset = 64) uint texture_index;
+} PushConstants;
 
 void main()
 {
@@ -20,7 +27,7 @@ void main()
 
 	//todo:gamma correct
 
-	vec4 texture_color = texture(element_texture, texcoords.xy + texcoords.zw) * color;
+	vec4 texture_color = texture(element_textures[PushConstants.texture_index], texcoords.xy + texcoords.zw) * color;
 
 	out_color = texture_color;
 }
\ No newline at end of file
@@ -0,0 +1,43 @@
+#version 450
+
+//one FSlateQuadInstance per instance, expanded to two triangles
+layout(location = 0) in vec2 in_origin;
+layout(location = 1) in vec2 in_axis_x;
+layout(location = 2) in vec2 in_axis_y;
+layout(location = 3) in vec4 in_uv_rect;
+layout(location = 4) in vec4 in_color;
+
+//same outputs as SlateDefaultVertexShader, so the pixel shader is shared
+layout(location = 0) out vec4 texcoords;
+layout(location = 1) out vec2 position;
+layout(location = 2) out vec4 color;
+layout(location = 3) out vec4 secondary_color;
+
+//push constants block
+layout( push_constant ) uniform constants
+{
+	mat4 view_projection_matrix;
+} PushConstants;
+
+//corners in the order of the quad indices of the batcher: top left, top right, bottom left, bottom left, top right, bottom right
+const vec2 corners[6] = vec2[](
+	vec2(0.0f, 0.0f), vec2(1.0f, 0.0f), vec2(0.0f, 1.0f),
+	vec2(0.0f, 1.0f), vec2(1.0f, 0.0f), vec2(1.0f, 1.0f)
+);
+
+void main()
+{
+	vec2 corner = corners[gl_VertexIndex];
+
+	vec2 quad_position = in_origin + corner.x * in_axis_x + corner.y * in_axis_y;
+
+	texcoords = vec4(mix(in_uv_rect.xy, in_uv_rect.zw, corner), 0.0f, 0.0f);
+
+	color = in_color;
+
+	secondary_color = vec4(0.0f);
+
+	position = quad_position;
+
+	gl_Position = PushConstants.view_projection_matrix * vec4(quad_position, 0.0f, 1.0f);
+}
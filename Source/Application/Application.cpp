@@ -226,7 +226,7 @@ namespace DoDo
 
     Application::Application()
 	    : m_last_tick_time(0.0f)
-        , m_current_time(std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count())
+        , m_current_time(s_platform_application ? s_platform_application->get_current_time() : 0.0)
 		, m_average_delta_time(1.0f / 30.0f)
     {
         //m_p_vk_instance = CreateScope<VkInstance>();
@@ -613,6 +613,10 @@ namespace DoDo
 	void Application::Tick()
     {
         const float delta_time = get_delta_time();
+
+        //frame pacing delays the frame here, before the input is read
+        m_renderer->wait_for_next_frame();
+
         //todo:implement TickPlatform
         //TickPlatform is just something to handle message
         tick_platform(delta_time);
@@ -677,8 +681,7 @@ namespace DoDo
     {
         m_last_tick_time = m_current_time;
         //m_current_time =
-        //todo:implement FPlatformTime
-        m_current_time = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+        m_current_time = s_platform_application->get_current_time();
     }
 
     void Application::tick_platform(float delta_time)
@@ -891,7 +894,11 @@ namespace DoDo
         //todo:implement arrange window to front
         m_windows.push_back(in_slate_window);
 
-        std::shared_ptr<Window> new_window = make_window(in_slate_window, b_show_immediately);
+        //offscreen windows draw into an image and need no native window
+        if (!in_slate_window->is_offscreen())
+        {
+            make_window(in_slate_window, b_show_immediately);
+        }
 
         if (b_show_immediately)
         {
@@ -1149,6 +1156,48 @@ namespace DoDo
         return process_mouse_button_up_event(mouse_event);
     }
 
+    static std::shared_ptr<SWindow> find_slate_window_by_native_window(const std::vector<std::shared_ptr<SWindow>>& windows_to_search, const std::shared_ptr<Window>& native_window_to_find)
+    {
+        for (const std::shared_ptr<SWindow>& slate_window : windows_to_search)
+        {
+            if (slate_window->get_native_window() == native_window_to_find)
+            {
+                return slate_window;
+            }
+        }
+
+        return std::shared_ptr<SWindow>();
+    }
+
+    void Application::On_Window_Exposed(const std::shared_ptr<Window>& window)
+    {
+        const std::shared_ptr<SWindow> slate_window = find_slate_window_by_native_window(m_windows, window);
+
+        //the os may have dropped the pixels a partial redraw would keep
+        if (slate_window && m_renderer)
+        {
+            m_renderer->invalidate_view_port(slate_window.get());
+        }
+    }
+
+    bool Application::On_Size_Changed(const std::shared_ptr<Window>& window, const int32_t width, const int32_t height)
+    {
+        const std::shared_ptr<SWindow> slate_window = find_slate_window_by_native_window(m_windows, window);
+
+        if (!slate_window)
+        {
+            return false;
+        }
+
+        //todo:resize the swap chain, until then only the damage is reset
+        if (m_renderer)
+        {
+            m_renderer->invalidate_view_port(slate_window.get());
+        }
+
+        return true;
+    }
+
     std::shared_ptr<SWindow> Application::get_first_window() {
         //todo:fix me
         return m_windows[0];//return first window
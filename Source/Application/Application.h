@@ -223,6 +223,10 @@ namespace DoDo
 
 		virtual bool On_Mouse_Up(const EMouseButtons::Type button, const glm::vec2 cursor_pos) override;
 
+		virtual void On_Window_Exposed(const std::shared_ptr<Window>& window) override;
+
+		virtual bool On_Size_Changed(const std::shared_ptr<Window>& window, const int32_t width, const int32_t height) override;
+
 		//------------------------FGenericApplicationMessageHandler Interface------------------------
 	public:
 		const static uint32_t m_cursor_pointer_index;
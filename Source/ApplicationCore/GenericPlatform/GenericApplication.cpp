@@ -10,6 +10,8 @@
 
 #include "Core/Window.h"
 
+#include <chrono>//get_current_time depends on it
+
 namespace DoDo {
 	GenericApplication::GenericApplication(const std::shared_ptr<ICursor>& in_cursor)
 		: m_cursor(in_cursor)
@@ -21,6 +23,11 @@ namespace DoDo {
 	void GenericApplication::Tick(const float time_delta)
 	{
 	}
+	double GenericApplication::get_current_time() const
+	{
+		//todo:implement FPlatformTime
+		return (double)std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+	}
 	std::shared_ptr<Window> GenericApplication::make_window()
 	{
 		return std::make_shared<Window>();//todo:implement platform application's make window
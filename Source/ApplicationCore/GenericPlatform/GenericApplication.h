@@ -104,6 +104,12 @@ namespace DoDo {
 		virtual std::shared_ptr<Window> get_window_under_cursor() { return std::shared_ptr<Window>(nullptr); }
 
 		virtual FModifierKeyState get_modifier_keys() const { return FModifierKeyState(); }
+
+		/*
+		 * seconds the slate application ticks with, read once per frame
+		 * a platform with a fixed clock returns its own time so frames are reproducible
+		 */
+		virtual double get_current_time() const;
 	public:
 		const std::shared_ptr<ICursor> m_cursor;//note:slate application will from there to get the ICursor
 	protected:
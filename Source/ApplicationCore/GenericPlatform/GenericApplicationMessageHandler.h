@@ -60,5 +60,17 @@ namespace DoDo
 		{
 			return false;
 		}
+
+		/*the os asks to repaint the window, e.g. it was uncovered or restored from minimized*/
+		virtual void On_Window_Exposed(const std::shared_ptr<Window>& window)
+		{
+
+		}
+
+		/*the client area of the window changed its size*/
+		virtual bool On_Size_Changed(const std::shared_ptr<Window>& window, const int32_t width, const int32_t height)
+		{
+			return false;
+		}
 	};
 }
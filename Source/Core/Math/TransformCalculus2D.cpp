@@ -0,0 +1,84 @@
+#include <PreCompileHeader.h>
+
+#include "TransformCalculus2D.h"
+
+//set by SLATE_USE_AVX2 in the cmake lists, sse2 is always there on x64
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define DODO_TRANSFORM_POINTS_AVX2 1
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define DODO_TRANSFORM_POINTS_SSE2 1
+#endif
+
+namespace DoDo
+{
+	/*
+	 * row vector times matrix plus translation:
+	 * x' = x * m00 + y * m10 + tx
+	 * y' = x * m01 + y * m11 + ty
+	 * points are interleaved [x0 y0 x1 y1 ...], so one register holds whole points and the matrix columns are repeated per point
+	 */
+	void transform_points(const FTransform2D& transform, const glm::vec2* in_points, glm::vec2* out_points, int32_t num_points)
+	{
+		float m00, m01, m10, m11;
+		transform.get_matrix().get_matrix(m00, m01, m10, m11);
+		const glm::vec2 translation = transform.get_translation();
+
+		const float* in_data = &in_points[0].x;
+		float* out_data = &out_points[0].x;
+
+		int32_t point_index = 0;
+
+#if DODO_TRANSFORM_POINTS_AVX2
+		{
+			const __m256 row0 = _mm256_setr_ps(m00, m01, m00, m01, m00, m01, m00, m01);
+			const __m256 row1 = _mm256_setr_ps(m10, m11, m10, m11, m10, m11, m10, m11);
+			const __m256 trans = _mm256_setr_ps(translation.x, translation.y, translation.x, translation.y, translation.x, translation.y, translation.x, translation.y);
+
+			//4 points a iteration
+			for (; point_index + 4 <= num_points; point_index += 4)
+			{
+				const __m256 points = _mm256_loadu_ps(in_data + point_index * 2);
+				const __m256 xx = _mm256_permute_ps(points, _MM_SHUFFLE(2, 2, 0, 0));
+				const __m256 yy = _mm256_permute_ps(points, _MM_SHUFFLE(3, 3, 1, 1));
+
+				const __m256 result = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(xx, row0), _mm256_mul_ps(yy, row1)), trans);
+				_mm256_storeu_ps(out_data + point_index * 2, result);
+			}
+		}
+#endif
+
+#if DODO_TRANSFORM_POINTS_SSE2
+		{
+			const __m128 row0 = _mm_setr_ps(m00, m01, m00, m01);
+			const __m128 row1 = _mm_setr_ps(m10, m11, m10, m11);
+			const __m128 trans = _mm_setr_ps(translation.x, translation.y, translation.x, translation.y);
+
+			//2 points a iteration
+			for (; point_index + 2 <= num_points; point_index += 2)
+			{
+				const __m128 points = _mm_loadu_ps(in_data + point_index * 2);
+				const __m128 xx = _mm_shuffle_ps(points, points, _MM_SHUFFLE(2, 2, 0, 0));
+				const __m128 yy = _mm_shuffle_ps(points, points, _MM_SHUFFLE(3, 3, 1, 1));
+
+				const __m128 result = _mm_add_ps(_mm_add_ps(_mm_mul_ps(xx, row0), _mm_mul_ps(yy, row1)), trans);
+				_mm_storeu_ps(out_data + point_index * 2, result);
+			}
+		}
+#endif
+
+		//remaining points, or everything when there is no simd
+		transform_points_scalar(transform, in_points + point_index, out_points + point_index, num_points - point_index);
+	}
+
+	void transform_points_scalar(const FTransform2D& transform, const glm::vec2* in_points, glm::vec2* out_points, int32_t num_points)
+	{
+		for (int32_t point_index = 0; point_index < num_points; ++point_index)
+		{
+			out_points[point_index] = transform.transform_point(in_points[point_index]);
+		}
+	}
+}
@@ -224,7 +224,7 @@ namespace DoDo
 		glm::vec2 transform_point(const glm::vec2& point) const
 		{
 			return glm::vec2(point.x * m_m[0][0] + point.y * m_m[1][0],
-				point.y * m_m[0][1] + point.y * m_m[1][1]);
+				point.x * m_m[0][1] + point.y * m_m[1][1]);
 		}
 
 		/*vector transformation is equivalent to point transformation as our matrix is not homogeneous*/
@@ -345,6 +345,16 @@ namespace DoDo
 	}
 
 	//if two types don't equal, then return FTransform2D
+	/*
+	 * transforms num_points points with the same transform, uses sse2/avx2 when the build enables them
+	 * this is what the element batcher uses to transform all corners of a box at once
+	 * in_points and out_points may be the same array
+	 */
+	void transform_points(const FTransform2D& transform, const glm::vec2* in_points, glm::vec2* out_points, int32_t num_points);
+
+	/*scalar version of transform_points, always available, used as the fallback and as the reference*/
+	void transform_points_scalar(const FTransform2D& transform, const glm::vec2* in_points, glm::vec2* out_points, int32_t num_points);
+
 	template<typename TransformType> struct ConcatenateRules<TransformType, typename std::enable_if<!std::is_same<FTransform2D, TransformType>::value, FTransform2D>::type> { typedef FTransform2D ResultType; };
 	template<typename TransformType> struct ConcatenateRules<typename std::enable_if<!std::is_same<FTransform2D, TransformType>::value, FTransform2D>::type, TransformType> { typedef FTransform2D ResultType; };
 	template<> struct ConcatenateRules <FMatrix2x2, FTransform2D> { typedef FTransform2D ResultType; };
@@ -0,0 +1,125 @@
+#include <PreCompileHeader.h>
+
+#include "MappedFile.h"
+
+#ifdef WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace DoDo {
+	FMappedFile::FMappedFile()
+		: m_data(nullptr)
+		, m_size(0)
+#ifdef WIN32
+		, m_file_handle(INVALID_HANDLE_VALUE)
+		, m_mapping_handle(nullptr)
+#endif
+	{
+	}
+
+	FMappedFile::~FMappedFile()
+	{
+		close();
+	}
+
+	bool FMappedFile::open(const char* file_path)
+	{
+		close();
+
+#ifdef WIN32
+		m_file_handle = CreateFileA(file_path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (m_file_handle == INVALID_HANDLE_VALUE)
+		{
+			return false;
+		}
+
+		LARGE_INTEGER file_size;
+		if (!GetFileSizeEx(m_file_handle, &file_size) || file_size.QuadPart == 0)
+		{
+			close();
+			return false;
+		}
+
+		m_mapping_handle = CreateFileMappingA(m_file_handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (m_mapping_handle == nullptr)
+		{
+			close();
+			return false;
+		}
+
+		m_data = (const uint8_t*)MapViewOfFile(m_mapping_handle, FILE_MAP_READ, 0, 0, 0);
+		if (m_data == nullptr)
+		{
+			close();
+			return false;
+		}
+
+		m_size = (size_t)file_size.QuadPart;
+#else
+		const int file_descriptor = ::open(file_path, O_RDONLY);
+		if (file_descriptor < 0)
+		{
+			return false;
+		}
+
+		struct stat file_stat;
+		if (fstat(file_descriptor, &file_stat) != 0 || file_stat.st_size == 0)
+		{
+			::close(file_descriptor);
+			return false;
+		}
+
+		void* data = mmap(nullptr, (size_t)file_stat.st_size, PROT_READ, MAP_PRIVATE, file_descriptor, 0);
+
+		//the mapping keeps its own reference to the file
+		::close(file_descriptor);
+
+		if (data == MAP_FAILED)
+		{
+			return false;
+		}
+
+		m_data = (const uint8_t*)data;
+		m_size = (size_t)file_stat.st_size;
+#endif
+
+		return true;
+	}
+
+	void FMappedFile::close()
+	{
+#ifdef WIN32
+		if (m_data != nullptr)
+		{
+			UnmapViewOfFile(m_data);
+		}
+
+		if (m_mapping_handle != nullptr)
+		{
+			CloseHandle(m_mapping_handle);
+			m_mapping_handle = nullptr;
+		}
+
+		if (m_file_handle != INVALID_HANDLE_VALUE)
+		{
+			CloseHandle(m_file_handle);
+			m_file_handle = INVALID_HANDLE_VALUE;
+		}
+#else
+		if (m_data != nullptr)
+		{
+			munmap((void*)m_data, m_size);
+		}
+#endif
+
+		m_data = nullptr;
+		m_size = 0;
+	}
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+namespace DoDo {
+	/*
+	 * read only memory mapping of a whole file
+	 * the pages are loaded by the os on first access, so opening a large file costs no copy
+	 */
+	class FMappedFile
+	{
+	public:
+		FMappedFile();
+
+		~FMappedFile();
+
+		FMappedFile(const FMappedFile&) = delete;
+
+		FMappedFile& operator=(const FMappedFile&) = delete;
+
+		/*
+		 * maps the file, a mapped file is closed first
+		 *
+		 * @return false if the file doesn't exist, is empty or can't be mapped
+		 */
+		bool open(const char* file_path);
+
+		/*unmaps the file, pointers into the mapping are invalid afterwards*/
+		void close();
+
+		bool is_open() const { return m_data != nullptr; }
+
+		const uint8_t* get_data() const { return m_data; }
+
+		size_t get_size() const { return m_size; }
+	private:
+		const uint8_t* m_data;
+
+		size_t m_size;
+
+#ifdef WIN32
+		void* m_file_handle;
+
+		void* m_mapping_handle;
+#endif
+	};
+}
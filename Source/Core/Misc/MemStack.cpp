@@ -0,0 +1,77 @@
+#include <PreCompileHeader.h>
+
+#include "MemStack.h"
+
+namespace DoDo {
+	FMemStackBase::FMemStackBase(size_t in_page_size)
+		: m_current_page(-1)
+		, m_top(nullptr)
+		, m_end(nullptr)
+		, m_page_size(in_page_size)
+		, m_reserved_size(0)
+	{
+	}
+
+	FMemStackBase::~FMemStackBase()
+	{
+		flush();
+
+		for(FPage& page : m_pages)
+		{
+			::operator delete(page.m_data);
+		}
+		m_pages.clear();
+	}
+
+	void FMemStackBase::flush()
+	{
+		//destruct in reverse order of construction
+		for(auto it = m_destructors.rbegin(); it != m_destructors.rend(); ++it)
+		{
+			it->m_destruct(it->m_object);
+		}
+		m_destructors.clear();
+
+		if(!m_pages.empty())
+		{
+			m_current_page = 0;
+			m_top = m_pages[0].m_data;
+			m_end = m_pages[0].m_data + m_pages[0].m_size;
+		}
+	}
+
+	size_t FMemStackBase::get_byte_count() const
+	{
+		size_t byte_count = 0;
+		for(int32_t page_index = 0; page_index < m_current_page; ++page_index)
+		{
+			byte_count += m_pages[page_index].m_size;
+		}
+		if(m_current_page >= 0)
+		{
+			byte_count += m_top - m_pages[m_current_page].m_data;
+		}
+		return byte_count;
+	}
+
+	void FMemStackBase::allocate_new_page(size_t min_size)
+	{
+		const int32_t next_page = m_current_page + 1;
+
+		//reuse the pages from the last frame
+		if(next_page >= m_pages.size() || m_pages[next_page].m_size < min_size)
+		{
+			FPage new_page;
+			new_page.m_size = std::max(m_page_size, min_size);
+			new_page.m_data = (uint8_t*)::operator new(new_page.m_size);
+
+			m_reserved_size += new_page.m_size;
+
+			m_pages.insert(m_pages.begin() + next_page, new_page);
+		}
+
+		m_current_page = next_page;
+		m_top = m_pages[next_page].m_data;
+		m_end = m_pages[next_page].m_data + m_pages[next_page].m_size;
+	}
+}
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace DoDo {
+	/*
+	 * simple linear allocator for memory that lives for one frame
+	 * memory is handed out from big pages and is released all at once by flush
+	 * the pages are kept between flushes, so after warm up there is no heap allocation
+	 */
+	class FMemStackBase
+	{
+	public:
+		FMemStackBase(size_t in_page_size = 64 * 1024);
+
+		~FMemStackBase();
+
+		FMemStackBase(const FMemStackBase&) = delete;
+
+		FMemStackBase& operator=(const FMemStackBase&) = delete;
+
+		/*
+		 * returns uninitialized memory that is valid until the next flush
+		 */
+		void* push_bytes(size_t allocated_size, size_t alignment)
+		{
+			uint8_t* result = align_pointer(m_top, alignment);
+			if(result + allocated_size > m_end)
+			{
+				allocate_new_page(allocated_size + alignment);
+				result = align_pointer(m_top, alignment);
+			}
+			m_top = result + allocated_size;
+			return result;
+		}
+
+		/*
+		 * constructs a object in the stack, the destructor is called on flush
+		 * trivially destructible types are not tracked at all
+		 */
+		template<typename T, typename... Args>
+		T* construct(Args&&... args)
+		{
+			T* object = new (push_bytes(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+
+			if constexpr (!std::is_trivially_destructible_v<T>)
+			{
+				m_destructors.push_back({ object, [](void* in_object) { static_cast<T*>(in_object)->~T(); } });
+			}
+
+			return object;
+		}
+
+		/*
+		 * calls the destructors of the non trivial objects and rewinds to the first page, the pages are kept
+		 */
+		void flush();
+
+		/*bytes handed out since the last flush*/
+		size_t get_byte_count() const;
+
+		/*total size of the pages owned by this stack*/
+		size_t get_reserved_size() const { return m_reserved_size; }
+
+	private:
+		static uint8_t* align_pointer(uint8_t* ptr, size_t alignment)
+		{
+			return (uint8_t*)(((uintptr_t)ptr + alignment - 1) & ~(uintptr_t)(alignment - 1));
+		}
+
+		void allocate_new_page(size_t min_size);
+
+		struct FPage
+		{
+			uint8_t* m_data;
+			size_t m_size;
+		};
+
+		struct FDestructor
+		{
+			void* m_object;
+			void(*m_destruct)(void*);
+		};
+
+		std::vector<FPage> m_pages;
+
+		/*index of the page currently being filled*/
+		int32_t m_current_page;
+
+		uint8_t* m_top;
+		uint8_t* m_end;
+
+		size_t m_page_size;
+
+		size_t m_reserved_size;
+
+		std::vector<FDestructor> m_destructors;
+	};
+}
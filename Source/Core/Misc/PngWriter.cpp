@@ -0,0 +1,128 @@
+#include <PreCompileHeader.h>
+
+#include "PngWriter.h"
+
+namespace DoDo {
+	static uint32_t png_crc32(uint32_t crc, const uint8_t* data, size_t size)
+	{
+		static uint32_t crc_table[256];
+		static bool b_crc_table_computed = false;
+
+		if (!b_crc_table_computed)
+		{
+			for (uint32_t n = 0; n < 256; ++n)
+			{
+				uint32_t c = n;
+				for (int32_t k = 0; k < 8; ++k)
+				{
+					c = (c & 1) ? 0xedb88320u ^ (c >> 1) : c >> 1;
+				}
+				crc_table[n] = c;
+			}
+			b_crc_table_computed = true;
+		}
+
+		crc = ~crc;
+		for (size_t i = 0; i < size; ++i)
+		{
+			crc = crc_table[(crc ^ data[i]) & 0xff] ^ (crc >> 8);
+		}
+		return ~crc;
+	}
+
+	static void append_big_endian(std::vector<uint8_t>& out, uint32_t value)
+	{
+		out.push_back((uint8_t)(value >> 24));
+		out.push_back((uint8_t)(value >> 16));
+		out.push_back((uint8_t)(value >> 8));
+		out.push_back((uint8_t)value);
+	}
+
+	static void append_chunk(std::vector<uint8_t>& out, const char* type, const std::vector<uint8_t>& data)
+	{
+		append_big_endian(out, (uint32_t)data.size());
+
+		//the crc covers the type and the data
+		const size_t type_offset = out.size();
+		out.insert(out.end(), type, type + 4);
+		out.insert(out.end(), data.begin(), data.end());
+
+		append_big_endian(out, png_crc32(0, out.data() + type_offset, out.size() - type_offset));
+	}
+
+	bool FPngWriter::write_rgba(const char* file_path, uint32_t width, uint32_t height, const uint8_t* pixels)
+	{
+		if (width == 0 || height == 0 || pixels == nullptr)
+		{
+			return false;
+		}
+
+		//every row starts with its filter type, 0 is none
+		const size_t row_size = (size_t)width * 4;
+		std::vector<uint8_t> filtered((row_size + 1) * height);
+		for (uint32_t row = 0; row < height; ++row)
+		{
+			uint8_t* dest = filtered.data() + row * (row_size + 1);
+			dest[0] = 0;
+			std::memcpy(dest + 1, pixels + row * row_size, row_size);
+		}
+
+		//zlib stream of stored deflate blocks, 65535 bytes at most each
+		std::vector<uint8_t> image_data;
+		image_data.reserve(filtered.size() + filtered.size() / 65535 * 5 + 16);
+		image_data.push_back(0x78);
+		image_data.push_back(0x01);
+
+		uint32_t adler_a = 1;
+		uint32_t adler_b = 0;
+		size_t offset = 0;
+		do
+		{
+			const uint16_t block_size = (uint16_t)std::min<size_t>(filtered.size() - offset, 65535);
+			const bool b_final_block = offset + block_size == filtered.size();
+
+			image_data.push_back(b_final_block ? 1 : 0);
+			image_data.push_back((uint8_t)block_size);
+			image_data.push_back((uint8_t)(block_size >> 8));
+			image_data.push_back((uint8_t)~block_size);
+			image_data.push_back((uint8_t)(~block_size >> 8));
+			image_data.insert(image_data.end(), filtered.begin() + offset, filtered.begin() + offset + block_size);
+
+			for (size_t i = offset; i < offset + block_size; ++i)
+			{
+				adler_a = (adler_a + filtered[i]) % 65521;
+				adler_b = (adler_b + adler_a) % 65521;
+			}
+
+			offset += block_size;
+		} while (offset < filtered.size());
+
+		append_big_endian(image_data, (adler_b << 16) | adler_a);
+
+		std::vector<uint8_t> header;
+		append_big_endian(header, width);
+		append_big_endian(header, height);
+		header.push_back(8);//bit depth
+		header.push_back(6);//rgba
+		header.push_back(0);//deflate
+		header.push_back(0);//adaptive filtering
+		header.push_back(0);//no interlace
+
+		static const uint8_t png_signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n' };
+
+		std::vector<uint8_t> file_data(png_signature, png_signature + 8);
+		append_chunk(file_data, "IHDR", header);
+		append_chunk(file_data, "IDAT", image_data);
+		append_chunk(file_data, "IEND", std::vector<uint8_t>());
+
+		std::ofstream file(file_path, std::ios::binary | std::ios::trunc);
+		if (!file.is_open())
+		{
+			return false;
+		}
+
+		file.write((const char*)file_data.data(), (std::streamsize)file_data.size());
+
+		return file.good();
+	}
+}
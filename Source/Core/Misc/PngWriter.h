@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cstdint>
+
+namespace DoDo {
+	/*
+	 * writes 8 bit rgba png files
+	 * the image data is stored in uncompressed deflate blocks, the files are large but need no compression library
+	 * meant for screenshots and test output, not for shipped content
+	 */
+	class FPngWriter
+	{
+	public:
+		/*
+		 * @param pixels tightly packed rgba rows, top row first
+		 * @return false if the file can't be written
+		 */
+		static bool write_rgba(const char* file_path, uint32_t width, uint32_t height, const uint8_t* pixels);
+	};
+}
@@ -0,0 +1,136 @@
+#include <PreCompileHeader.h>
+
+#include "QueuedThreadPool.h"
+
+namespace DoDo {
+	FQueuedThreadPool::FQueuedThreadPool(int32_t in_num_threads)
+		: m_job_body(nullptr)
+		, m_job_num(0)
+		, m_next_index(0)
+		, m_num_finished(0)
+		, m_num_active_workers(0)
+		, m_job_serial(0)
+		, m_b_stopping(false)
+	{
+		for(int32_t thread_index = 0; thread_index < in_num_threads; ++thread_index)
+		{
+			m_threads.emplace_back([this]() { worker_loop(); });
+		}
+	}
+
+	FQueuedThreadPool::~FQueuedThreadPool()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_b_stopping = true;
+		}
+		m_job_ready.notify_all();
+
+		for(std::thread& thread : m_threads)
+		{
+			thread.join();
+		}
+	}
+
+	void FQueuedThreadPool::parallel_for(int32_t num, const std::function<void(int32_t)>& body)
+	{
+		if(num <= 0)
+		{
+			return;
+		}
+
+		//not worth waking the workers
+		if(num == 1 || m_threads.empty())
+		{
+			for(int32_t index = 0; index < num; ++index)
+			{
+				body(index);
+			}
+			return;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_job_body = &body;
+			m_job_num = num;
+			m_next_index.store(0);
+			m_num_finished = 0;
+			++m_job_serial;
+		}
+		m_job_ready.notify_all();
+
+		//the calling thread helps instead of idling
+		const int32_t num_run = run_job_indices();
+
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_num_finished += num_run;
+		m_job_done.wait(lock, [this]() { return m_num_finished == m_job_num && m_num_active_workers == 0; });
+
+		//close the job, late workers see no body and go back to sleep
+		m_job_body = nullptr;
+		m_job_num = 0;
+	}
+
+	int32_t FQueuedThreadPool::get_default_num_threads()
+	{
+		const int32_t num_cores = (int32_t)std::thread::hardware_concurrency();
+
+		return std::max(num_cores - 1, 1);
+	}
+
+	void FQueuedThreadPool::worker_loop()
+	{
+		uint64_t last_job_serial = 0;
+
+		while(true)
+		{
+			{
+				std::unique_lock<std::mutex> lock(m_mutex);
+				m_job_ready.wait(lock, [&]() { return m_b_stopping || m_job_serial != last_job_serial; });
+
+				if(m_b_stopping)
+				{
+					return;
+				}
+
+				last_job_serial = m_job_serial;
+
+				if(m_job_body == nullptr)
+				{
+					continue;
+				}
+
+				++m_num_active_workers;
+			}
+
+			const int32_t num_run = run_job_indices();
+
+			bool b_job_done = false;
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				m_num_finished += num_run;
+				--m_num_active_workers;
+				b_job_done = m_num_finished == m_job_num && m_num_active_workers == 0;
+			}
+
+			if(b_job_done)
+			{
+				m_job_done.notify_one();
+			}
+		}
+	}
+
+	int32_t FQueuedThreadPool::run_job_indices()
+	{
+		int32_t num_run = 0;
+
+		//m_job_body and m_job_num don't change while a worker is active
+		for(int32_t index = m_next_index.fetch_add(1); index < m_job_num; index = m_next_index.fetch_add(1))
+		{
+			(*m_job_body)(index);
+			++num_run;
+		}
+
+		return num_run;
+	}
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace DoDo {
+	/*
+	 * a small pool of worker threads for fork/join work inside a frame
+	 * parallel_for hands out the indices to the workers and the calling thread, and returns after all of them are done
+	 * only one parallel_for can run at a time, it is meant to be driven from the render thread
+	 */
+	class FQueuedThreadPool
+	{
+	public:
+		/*@param in_num_threads number of worker threads, the calling thread works as well*/
+		explicit FQueuedThreadPool(int32_t in_num_threads);
+
+		~FQueuedThreadPool();
+
+		FQueuedThreadPool(const FQueuedThreadPool&) = delete;
+
+		FQueuedThreadPool& operator=(const FQueuedThreadPool&) = delete;
+
+		/*
+		 * calls body for every index in [0, num), blocks until all calls are finished
+		 * the order and the thread of the calls are not defined
+		 */
+		void parallel_for(int32_t num, const std::function<void(int32_t)>& body);
+
+		int32_t get_num_threads() const { return (int32_t)m_threads.size(); }
+
+		/*worker count that leaves one core for the calling thread*/
+		static int32_t get_default_num_threads();
+
+	private:
+		void worker_loop();
+
+		/*runs indices of the current job until there are no more, @return the number of indices run*/
+		int32_t run_job_indices();
+
+		std::vector<std::thread> m_threads;
+
+		std::mutex m_mutex;
+
+		/*workers wait for a new job*/
+		std::condition_variable m_job_ready;
+
+		/*the caller waits for the job to finish*/
+		std::condition_variable m_job_done;
+
+		const std::function<void(int32_t)>* m_job_body;
+
+		int32_t m_job_num;
+
+		std::atomic<int32_t> m_next_index;
+
+		/*indices finished, guarded by m_mutex*/
+		int32_t m_num_finished;
+
+		/*workers inside run_job_indices, the job is only closed after they left, guarded by m_mutex*/
+		int32_t m_num_active_workers;
+
+		/*increased for every job, so workers can tell a new job from a spurious wake up*/
+		uint64_t m_job_serial;
+
+		bool m_b_stopping;
+	};
+}
@@ -56,6 +56,37 @@ namespace DoDo {
 		}
 	}
 
+	static void window_refresh_call_back(GLFWwindow* native_window)
+	{
+		GLFWApplication* application = (GLFWApplication*)glfwGetWindowUserPointer(native_window);
+
+		const std::shared_ptr<WindowsWindow> window = find_window_by_glfw_window(application->get_native_windows(), native_window);
+
+		application->get_message_handler()->On_Window_Exposed(window);
+	}
+
+	static void window_iconify_call_back(GLFWwindow* native_window, int32_t iconified)
+	{
+		GLFWApplication* application = (GLFWApplication*)glfwGetWindowUserPointer(native_window);
+
+		//a restored window shows what the os kept of it
+		if (iconified == GLFW_FALSE)
+		{
+			const std::shared_ptr<WindowsWindow> window = find_window_by_glfw_window(application->get_native_windows(), native_window);
+
+			application->get_message_handler()->On_Window_Exposed(window);
+		}
+	}
+
+	static void framebuffer_size_call_back(GLFWwindow* native_window, int32_t width, int32_t height)
+	{
+		GLFWApplication* application = (GLFWApplication*)glfwGetWindowUserPointer(native_window);
+
+		const std::shared_ptr<WindowsWindow> window = find_window_by_glfw_window(application->get_native_windows(), native_window);
+
+		application->get_message_handler()->On_Size_Changed(window, width, height);
+	}
+
 	GLFWApplication::GLFWApplication()
 		: GenericApplication(std::make_shared<FWindowsCursor>())
 	{
@@ -90,6 +121,13 @@ namespace DoDo {
 		glfwSetCursorPosCallback(native_window_handle, cursor_position_call_back);//register message call back
 
 		glfwSetMouseButtonCallback(native_window_handle, mouse_button_call_back);//register mouse button call back
+
+		//the window's pixels may be gone after these, a partial redraw would keep the holes
+		glfwSetWindowRefreshCallback(native_window_handle, window_refresh_call_back);
+
+		glfwSetWindowIconifyCallback(native_window_handle, window_iconify_call_back);
+
+		glfwSetFramebufferSizeCallback(native_window_handle, framebuffer_size_call_back);
 	}
 
 	int32_t GLFWApplication::process_message()
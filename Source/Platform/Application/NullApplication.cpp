@@ -0,0 +1,103 @@
+#include <PreCompileHeader.h>
+
+#include "NullApplication.h"
+
+#include "Platform/Window/NullCursor.h"//FNullCursor depends on it
+#include "Platform/Window/NullWindow.h"
+
+namespace DoDo {
+	FNullApplication::FNullApplication(double in_fixed_delta_time)
+		: GenericApplication(std::make_shared<FNullCursor>())
+		, m_queued_cursor_position(0.0f, 0.0f)
+		, m_fixed_delta_time(in_fixed_delta_time)
+		, m_current_time(0.0)
+	{
+	}
+
+	FNullApplication::~FNullApplication()
+	{
+	}
+
+	void FNullApplication::pump_messages(const float time_delta)
+	{
+		//handlers may queue more input, those messages wait for the next pump
+		std::vector<FNullMessage> messages;
+		messages.swap(m_messages);
+
+		for (const FNullMessage& message : messages)
+		{
+			switch (message.m_type)
+			{
+			case ENullMessageType::MouseMove:
+				m_cursor->set_position((int32_t)message.m_cursor_position.x, (int32_t)message.m_cursor_position.y);
+				m_message_handler->set_cursor_pos(message.m_cursor_position);
+				m_message_handler->On_Mouse_Move();
+				break;
+			case ENullMessageType::MouseDown:
+				m_message_handler->On_Mouse_Down(get_window_under_cursor(), message.m_button, message.m_cursor_position);
+				break;
+			case ENullMessageType::MouseUp:
+				m_message_handler->On_Mouse_Up(message.m_button, message.m_cursor_position);
+				break;
+			}
+		}
+	}
+
+	void FNullApplication::Tick(const float time_delta)
+	{
+		//the slate application reads the time after the platform ticked
+		m_current_time += m_fixed_delta_time;
+	}
+
+	std::shared_ptr<Window> FNullApplication::make_window()
+	{
+		return std::make_shared<FNullWindow>();
+	}
+
+	void FNullApplication::initialize_window(const std::shared_ptr<Window>& in_window, const std::shared_ptr<FGenericWindowDefinition>& in_definition, const std::shared_ptr<Window>& in_parent, const bool b_show_immediately)
+	{
+		const std::shared_ptr<FNullWindow> window = std::static_pointer_cast<FNullWindow>(in_window);
+
+		m_windows.push_back(window);
+
+		window->initialize(in_definition);
+	}
+
+	std::shared_ptr<Window> FNullApplication::get_window_under_cursor()
+	{
+		const glm::vec2 cursor_position = m_cursor->get_position();
+
+		//windows created later are on top
+		for (int32_t window_index = (int32_t)m_windows.size() - 1; window_index >= 0; --window_index)
+		{
+			if (m_windows[window_index]->is_screen_point_in_window(cursor_position))
+			{
+				return m_windows[window_index];
+			}
+		}
+
+		return std::shared_ptr<Window>(nullptr);
+	}
+
+	void FNullApplication::move_cursor(const glm::vec2& screen_position)
+	{
+		m_queued_cursor_position = screen_position;
+
+		m_messages.emplace_back(ENullMessageType::MouseMove, screen_position, EMouseButtons::Invalid);
+	}
+
+	void FNullApplication::press_mouse_button(EMouseButtons::Type button)
+	{
+		m_messages.emplace_back(ENullMessageType::MouseDown, m_queued_cursor_position, button);
+	}
+
+	void FNullApplication::release_mouse_button(EMouseButtons::Type button)
+	{
+		m_messages.emplace_back(ENullMessageType::MouseUp, m_queued_cursor_position, button);
+	}
+
+	std::shared_ptr<FNullApplication> FNullApplication::create_null_application(double in_fixed_delta_time)
+	{
+		return std::make_shared<FNullApplication>(in_fixed_delta_time);
+	}
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "ApplicationCore/GenericPlatform/GenericApplication.h"
+
+#include "ApplicationCore/GenericPlatform/GenericApplicationMessageHandler.h"//EMouseButtons depends on it
+
+namespace DoDo {
+	class FNullWindow;
+	class FNullCursor;
+	/*
+	 * a platform application without a window system
+	 * windows only exist in memory, the input is scripted and the clock advances by a fixed step every tick
+	 * so layout, paint, hit testing and batching can run in a container without a display
+	 */
+	class FNullApplication : public GenericApplication
+	{
+	public:
+		/*@param in_fixed_delta_time seconds the clock advances every tick*/
+		explicit FNullApplication(double in_fixed_delta_time = 1.0 / 60.0);
+
+		virtual ~FNullApplication() override;
+
+		/*sends the scripted input to the message handler, in the order it was queued*/
+		virtual void pump_messages(const float time_delta) override;
+
+		virtual void Tick(const float time_delta) override;
+
+		virtual std::shared_ptr<Window> make_window() override;
+
+		virtual void initialize_window(const std::shared_ptr<Window>& window, const std::shared_ptr<FGenericWindowDefinition>& in_definition, const std::shared_ptr<Window>& in_parent, const bool b_show_immediately) override;
+
+		virtual std::shared_ptr<Window> get_window_under_cursor() override;
+
+		virtual double get_current_time() const override { return m_current_time; }
+
+		/*queues a move of the cursor to the screen space position*/
+		void move_cursor(const glm::vec2& screen_position);
+
+		/*queues a press of the button at the cursor position*/
+		void press_mouse_button(EMouseButtons::Type button);
+
+		/*queues a release of the button at the cursor position*/
+		void release_mouse_button(EMouseButtons::Type button);
+
+		static std::shared_ptr<FNullApplication> create_null_application(double in_fixed_delta_time = 1.0 / 60.0);
+
+	private:
+		enum class ENullMessageType : uint8_t
+		{
+			MouseMove,
+			MouseDown,
+			MouseUp
+		};
+
+		struct FNullMessage
+		{
+			ENullMessageType m_type;
+
+			glm::vec2 m_cursor_position;
+
+			EMouseButtons::Type m_button;
+
+			FNullMessage(ENullMessageType in_type, const glm::vec2& in_cursor_position, EMouseButtons::Type in_button)
+				: m_type(in_type)
+				, m_cursor_position(in_cursor_position)
+				, m_button(in_button)
+			{}
+		};
+
+		std::vector<std::shared_ptr<FNullWindow>> m_windows;
+
+		/*input queued since the last pump_messages*/
+		std::vector<FNullMessage> m_messages;
+
+		/*position of the last queued move, presses happen there*/
+		glm::vec2 m_queued_cursor_position;
+
+		double m_fixed_delta_time;
+
+		double m_current_time;
+	};
+}
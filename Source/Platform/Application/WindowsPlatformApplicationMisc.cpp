@@ -55,7 +55,11 @@ namespace DoDo {
 			}
 		}
 
-		assert(find_monitor != nullptr);
+		//no display, e.g. with the null application
+		if (find_monitor == nullptr)
+		{
+			return 1.0f;
+		}
 
 		//to get dpi scale
 		glfwGetMonitorContentScale(find_monitor, &scale_x, &scale_y);
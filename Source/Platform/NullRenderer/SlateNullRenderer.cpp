@@ -0,0 +1,149 @@
+#include <PreCompileHeader.h>
+
+#include "SlateNullRenderer.h"
+
+#include "SlateCore/Rendering/DrawElements.h"
+
+#include "SlateCore/Styling/SlateBrush.h"
+
+#include <chrono>//batching time depends on it
+
+namespace DoDo {
+	FSlateShaderResourceProxy* FSlateNullTextureManager::get_shader_resource(const FSlateBrush& in_brush, glm::vec2 local_size, float draw_scale)
+	{
+		FSlateShaderResourceProxy* texture = nullptr;
+
+		if (in_brush.get_image_type() != ESlateBrushImageType::Vector && in_brush.get_resource_name() != "")
+		{
+			auto it = m_resource_map.find(in_brush.get_resource_name());
+			if (it != m_resource_map.end())
+			{
+				texture = it->second;
+			}
+			else
+			{
+				texture = new FSlateShaderResourceProxy;
+				texture->m_resource = &m_null_texture;
+				texture->m_actual_size = FIntPoint(1, 1);
+
+				m_resource_map.insert({ in_brush.get_resource_name(), texture });
+			}
+		}
+
+		return texture;
+	}
+
+	FSlateNullRenderer::FSlateNullRenderer()
+	{
+	}
+
+	FSlateNullRenderer::~FSlateNullRenderer()
+	{
+	}
+
+	FSlateDrawBuffer& FSlateNullRenderer::get_draw_buffer()
+	{
+		m_draw_buffer.clear_buffer();
+		return m_draw_buffer;
+	}
+
+	void FSlateNullRenderer::draw_windows(FSlateDrawBuffer& in_window_draw_buffer)
+	{
+		const std::vector<std::shared_ptr<FSlateWindowElementList>>& window_element_lists = in_window_draw_buffer.get_window_element_lists();
+
+		const std::chrono::high_resolution_clock::time_point start_time = std::chrono::high_resolution_clock::now();
+
+		const int32_t num_lists = (int32_t)window_element_lists.size();
+
+		while ((int32_t)m_element_batchers.size() < num_lists)
+		{
+			m_element_batchers.push_back(std::make_unique<FSlateElementBatcher>());
+			m_element_batchers.back()->set_use_instanced_quads(true);
+		}
+
+		//batching marks the caches as batched
+		uint32_t num_rebatched_windows = 0;
+		for (int32_t list_index = 0; list_index < num_lists; ++list_index)
+		{
+			const FSlateCachedElementData* cached_element_data = window_element_lists[list_index]->get_cached_element_data();
+			if (cached_element_data && cached_element_data->needs_rebatch())
+			{
+				++num_rebatched_windows;
+			}
+		}
+
+		m_batching_thread_pool->parallel_for(num_lists, [&](int32_t list_index)
+		{
+			FSlateWindowElementList& element_list = *window_element_lists[list_index];
+
+			if (element_list.get_render_window())
+			{
+				m_element_batchers[list_index]->add_elements(element_list);
+			}
+		});
+
+		m_frame_stats = FSlateNullFrameStats();
+		m_frame_stats.m_num_rebatched_windows = num_rebatched_windows;
+
+		for (int32_t list_index = 0; list_index < num_lists; ++list_index)
+		{
+			FSlateWindowElementList& element_list = *window_element_lists[list_index];
+
+			if (!element_list.get_render_window())
+			{
+				continue;
+			}
+
+			if (FSlateCachedElementData* cached_element_data = element_list.get_cached_element_data())
+			{
+				m_frame_stats.m_num_cached_batches += (uint32_t)cached_element_data->get_cached_batch_data().get_render_batches().size();
+			}
+
+			FSlateBatchData& batch_data = element_list.get_batch_data();
+
+			batch_data.merge_render_batches();
+
+			m_vertices.resize(batch_data.get_num_final_vertices());
+			m_indices.resize(batch_data.get_num_final_indices());
+			m_instances.resize(batch_data.get_num_final_instances());
+
+			batch_data.copy_final_data(m_vertices.data(), m_indices.data(), m_instances.data());
+
+			++m_frame_stats.m_num_windows;
+			m_frame_stats.m_num_batches += batch_data.get_num_final_batches();
+			m_frame_stats.m_num_vertices += batch_data.get_num_final_vertices();
+			m_frame_stats.m_num_indices += batch_data.get_num_final_indices();
+			m_frame_stats.m_num_instances += batch_data.get_num_final_instances();
+			m_frame_stats.m_num_culled_widgets += (uint32_t)element_list.get_num_culled_widgets();
+			m_frame_stats.m_num_culled_elements += (uint32_t)element_list.get_num_culled_elements();
+		}
+
+		m_frame_stats.m_batching_time = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start_time).count();
+	}
+
+	FSlateResourceHandle FSlateNullRenderer::get_resource_handle(const FSlateBrush& brush, glm::vec2 local_size, float draw_scale)
+	{
+		return m_texture_manager->get_resource_handle(brush, local_size, draw_scale);
+	}
+
+	bool FSlateNullRenderer::initialize()
+	{
+		if (!m_batching_thread_pool)
+		{
+			m_batching_thread_pool = std::make_unique<FQueuedThreadPool>(FQueuedThreadPool::get_default_num_threads());
+
+			m_texture_manager = std::make_unique<FSlateNullTextureManager>();
+		}
+
+		return true;
+	}
+
+	void FSlateNullRenderer::destroy()
+	{
+		m_element_batchers.clear();
+
+		m_texture_manager.reset();
+
+		m_batching_thread_pool.reset();
+	}
+}
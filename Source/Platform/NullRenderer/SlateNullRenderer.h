@@ -0,0 +1,123 @@
+#pragma once
+
+#include "Core/Core.h"
+
+#include "SlateCore/Rendering/SlateDrawBuffer.h"
+
+#include "SlateCore/Rendering/ElementBatcher.h"//FSlateElementBatcher and unique_ptr need this
+
+#include "SlateCore/Rendering/ShaderResourceManager.h"//FSlateNullTextureManager depends on it
+
+#include "Renderer/Renderer.h"//slate renderer
+
+#include "Core/Misc/QueuedThreadPool.h"//FQueuedThreadPool depends on it
+
+namespace DoDo {
+	/*stands in for every texture, images aren't decoded*/
+	class FSlateNullTexture : public FSlateShaderResource
+	{
+	public:
+		virtual uint32_t get_width() const override { return 1; }
+
+		virtual uint32_t get_height() const override { return 1; }
+
+		virtual ESlateShaderResource::Type get_type() const override { return ESlateShaderResource::NativeTexture; }
+	};
+
+	/*hands out a valid proxy for every brush, so the batcher batches the elements like with a real renderer*/
+	class FSlateNullTextureManager : public FSlateShaderResourceManager
+	{
+	public:
+		virtual FSlateShaderResourceProxy* get_shader_resource(const FSlateBrush& in_brush, glm::vec2 local_size, float draw_scale) override;
+
+	private:
+		FSlateNullTexture m_null_texture;
+	};
+
+	/*what the null renderer batched in the last draw_windows*/
+	struct FSlateNullFrameStats
+	{
+		uint32_t m_num_windows;
+
+		uint32_t m_num_batches;
+
+		uint32_t m_num_vertices;
+
+		uint32_t m_num_indices;
+
+		uint32_t m_num_instances;
+
+		/*windows whose cached elements were batched again, the others reused the cached batches*/
+		uint32_t m_num_rebatched_windows;
+
+		/*render batches that came from the caches of the invalidation roots*/
+		uint32_t m_num_cached_batches;
+
+		/*children skipped by their parents and elements skipped by MakeBox, counted while painting*/
+		uint32_t m_num_culled_widgets;
+
+		uint32_t m_num_culled_elements;
+
+		/*wall time of batching and merging, in milliseconds*/
+		double m_batching_time;
+
+		FSlateNullFrameStats()
+			: m_num_windows(0)
+			, m_num_batches(0)
+			, m_num_vertices(0)
+			, m_num_indices(0)
+			, m_num_instances(0)
+			, m_num_rebatched_windows(0)
+			, m_num_cached_batches(0)
+			, m_num_culled_widgets(0)
+			, m_num_culled_elements(0)
+			, m_batching_time(0.0)
+		{}
+	};
+
+	/*
+	 * a renderer without an output
+	 * it batches the draw buffers with FSlateElementBatcher like the vulkan renderer, writes the merged data to memory and discards it
+	 * so the cpu cost of a whole frame can be measured without a gpu or a display
+	 */
+	class FSlateNullRenderer : public Renderer
+	{
+	public:
+		FSlateNullRenderer();
+
+		virtual ~FSlateNullRenderer();
+
+		/*FSlateRenderer Interface*/
+		FSlateDrawBuffer& get_draw_buffer() override;
+
+		void create_view_port(const std::shared_ptr<SWindow> in_window) override {}
+
+		void draw_windows(FSlateDrawBuffer& in_window_draw_buffer) override;
+
+		virtual FSlateResourceHandle get_resource_handle(const FSlateBrush& brush, glm::vec2 local_size, float draw_scale) override;
+
+		bool initialize() override;
+
+		virtual void destroy() override;
+		/*FSlateRenderer Interface*/
+
+		const FSlateNullFrameStats& get_frame_stats() const { return m_frame_stats; }
+
+	private:
+		FSlateDrawBuffer m_draw_buffer;
+
+		/*one per window element list, the lists are batched in parallel*/
+		std::vector<std::unique_ptr<FSlateElementBatcher>> m_element_batchers;
+
+		std::unique_ptr<FQueuedThreadPool> m_batching_thread_pool;
+
+		std::unique_ptr<FSlateNullTextureManager> m_texture_manager;
+
+		/*the merged data is written here instead of to vertex buffers*/
+		std::vector<FSlateVertex> m_vertices;
+		std::vector<SlateIndex> m_indices;
+		std::vector<FSlateQuadInstance> m_instances;
+
+		FSlateNullFrameStats m_frame_stats;
+	};
+}
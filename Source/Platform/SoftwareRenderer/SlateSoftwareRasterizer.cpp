@@ -0,0 +1,338 @@
+#include <PreCompileHeader.h>
+
+#include "SlateSoftwareRasterizer.h"
+
+#include "SlateSoftwareTextureManager.h"//FSlateSoftwareTexture depends on it
+
+#include "Core/Misc/QueuedThreadPool.h"
+
+#include <cmath>
+
+namespace DoDo {
+	/*textures are srgb, the vulkan sampler returns linear colors, alpha is linear already*/
+	static const float* get_srgb_to_linear_table()
+	{
+		static float table[256];
+		static const bool b_table_built = []()
+		{
+			for (int32_t value = 0; value < 256; ++value)
+			{
+				const float srgb = value / 255.0f;
+				table[value] = srgb <= 0.04045f ? srgb / 12.92f : std::pow((srgb + 0.055f) / 1.055f, 2.4f);
+			}
+			return true;
+		}();
+		(void)b_table_built;
+
+		return table;
+	}
+
+#if SLATE_USE_PACKED_VERTEX_COLOR
+	static glm::vec4 unpack_vertex_color(const FSlateVertexColor& color)
+	{
+		return glm::vec4(color.r, color.g, color.b, color.a) * (1.0f / 255.0f);
+	}
+#else
+	static glm::vec4 unpack_vertex_color(const FSlateVertexColor& color)
+	{
+		return color;
+	}
+#endif
+
+	static uint8_t to_unorm8(float value)
+	{
+		return (uint8_t)(glm::clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f);
+	}
+
+	/*> 0 if p is right of a->b in window space (y down), the interior of a clockwise triangle*/
+	static float edge_function(const glm::vec2& a, const glm::vec2& b, const glm::vec2& p)
+	{
+		return (b.x - a.x) * (p.y - a.y) - (b.y - a.y) * (p.x - a.x);
+	}
+
+	/*pixels exactly on a top or a left edge belong to the triangle, so the shared edge of two triangles is drawn once*/
+	static bool is_top_left_edge(const glm::vec2& a, const glm::vec2& b)
+	{
+		return (a.y == b.y && b.x > a.x) || b.y < a.y;
+	}
+
+	FSlateSoftwareRasterizer::FSlateSoftwareRasterizer(FQueuedThreadPool* in_thread_pool)
+		: m_thread_pool(in_thread_pool)
+		, m_num_tiles_x(0)
+		, m_num_tiles_y(0)
+	{
+	}
+
+	void FSlateSoftwareRasterizer::clear(FSlateSoftwareFramebuffer& framebuffer, const uint8_t clear_color[4]) const
+	{
+		uint8_t* pixel = framebuffer.m_pixels.data();
+		const size_t num_pixels = (size_t)framebuffer.m_width * framebuffer.m_height;
+
+		for (size_t pixel_index = 0; pixel_index < num_pixels; ++pixel_index, pixel += 4)
+		{
+			std::memcpy(pixel, clear_color, 4);
+		}
+	}
+
+	void FSlateSoftwareRasterizer::draw_batches(const FSlateBatchData& batch_data, const FSlateVertex* vertices, const SlateIndex* indices, const FSlateQuadInstance* instances,
+		const FSlateSoftwareTexture* white_texture, FSlateSoftwareFramebuffer& framebuffer)
+	{
+		const int32_t width = (int32_t)framebuffer.m_width;
+		const int32_t height = (int32_t)framebuffer.m_height;
+
+		if (width == 0 || height == 0)
+		{
+			return;
+		}
+
+		m_num_tiles_x = (width + tile_size - 1) / tile_size;
+		m_num_tiles_y = (height + tile_size - 1) / tile_size;
+
+		const int32_t num_tiles = m_num_tiles_x * m_num_tiles_y;
+
+		if ((int32_t)m_tile_triangles.size() < num_tiles)
+		{
+			m_tile_triangles.resize(num_tiles);
+		}
+
+		for (int32_t tile_index = 0; tile_index < num_tiles; ++tile_index)
+		{
+			m_tile_triangles[tile_index].clear();
+		}
+
+		m_triangles.clear();
+
+		//set up and bin the triangles in batch order
+		const std::vector<FSlateRenderBatch>& render_batches = batch_data.get_render_batches();
+
+		int32_t next_render_batch_index = batch_data.get_first_render_batch_index();
+		while (next_render_batch_index != -1)
+		{
+			const FSlateRenderBatch& render_batch = render_batches[next_render_batch_index];
+
+			next_render_batch_index = render_batch.m_next_batch_index;
+
+			const FSlateSoftwareTexture* batch_texture = render_batch.get_shader_resource() != nullptr ? (const FSlateSoftwareTexture*)render_batch.get_shader_resource() : white_texture;
+
+			glm::vec2 positions[3];
+			glm::vec2 uvs[3];
+			glm::vec4 colors[3];
+
+			if (render_batch.is_instanced())
+			{
+				const FSlateQuadInstance* batch_instances = instances + render_batch.m_instance_offset;
+
+				for (int32_t instance_index = 0; instance_index < render_batch.m_num_instances; ++instance_index)
+				{
+					const FSlateQuadInstance& instance = batch_instances[instance_index];
+
+					const glm::vec2 start_uv = glm::vec2(instance.m_uv_rect[0], instance.m_uv_rect[1]) * (1.0f / 65535.0f);
+					const glm::vec2 end_uv = glm::vec2(instance.m_uv_rect[2], instance.m_uv_rect[3]) * (1.0f / 65535.0f);
+
+					const glm::vec2 corner_positions[4] = { instance.m_origin, instance.m_origin + instance.m_axis_x, instance.m_origin + instance.m_axis_y, instance.m_origin + instance.m_axis_x + instance.m_axis_y };
+					const glm::vec2 corner_uvs[4] = { start_uv, glm::vec2(end_uv.x, start_uv.y), glm::vec2(start_uv.x, end_uv.y), end_uv };
+
+					const glm::vec4 color = unpack_vertex_color(instance.m_color);
+					colors[0] = colors[1] = colors[2] = color;
+
+					//top left, top right, bottom left and bottom left, top right, bottom right, like the instanced quad vertex shader
+					static const int32_t quad_corners[6] = { 0, 1, 2, 2, 1, 3 };
+					for (int32_t triangle = 0; triangle < 2; ++triangle)
+					{
+						for (int32_t corner = 0; corner < 3; ++corner)
+						{
+							positions[corner] = corner_positions[quad_corners[triangle * 3 + corner]];
+							uvs[corner] = corner_uvs[quad_corners[triangle * 3 + corner]];
+						}
+
+						add_triangle(positions, uvs, colors, batch_texture, width, height);
+					}
+				}
+			}
+			else
+			{
+				//indices of a batch are local to its first vertex
+				const FSlateVertex* batch_vertices = vertices + render_batch.m_vertex_offset;
+				const SlateIndex* batch_indices = indices + render_batch.m_index_offset;
+
+				for (int32_t index = 0; index + 2 < render_batch.m_num_indices; index += 3)
+				{
+					for (int32_t corner = 0; corner < 3; ++corner)
+					{
+						const FSlateVertex& vertex = batch_vertices[batch_indices[index + corner]];
+
+						positions[corner] = vertex.m_position;
+						uvs[corner] = glm::vec2(vertex.tex_coords[0] + vertex.tex_coords[2], vertex.tex_coords[1] + vertex.tex_coords[3]);
+						colors[corner] = unpack_vertex_color(vertex.m_color);
+					}
+
+					add_triangle(positions, uvs, colors, batch_texture, width, height);
+				}
+			}
+		}
+
+		//every pixel belongs to one tile, so the tiles don't need to synchronize
+		m_thread_pool->parallel_for(num_tiles, [&](int32_t tile_index)
+		{
+			draw_tile(tile_index, framebuffer);
+		});
+	}
+
+	void FSlateSoftwareRasterizer::add_triangle(const glm::vec2 positions[3], const glm::vec2 uvs[3], const glm::vec4 colors[3], const FSlateSoftwareTexture* texture, int32_t width, int32_t height)
+	{
+		//the pipelines cull back faces with clockwise front faces, degenerate and nan triangles are dropped as well
+		const float area = edge_function(positions[0], positions[1], positions[2]);
+		if (!(area > 0.0f))
+		{
+			return;
+		}
+
+		FTriangle triangle;
+
+		for (int32_t corner = 0; corner < 3; ++corner)
+		{
+			triangle.m_positions[corner] = positions[corner];
+			triangle.m_uvs[corner] = uvs[corner];
+			triangle.m_colors[corner] = colors[corner];
+		}
+
+		triangle.m_texture = texture;
+		triangle.m_area = area;
+
+		const glm::vec2 min_position = glm::min(positions[0], glm::min(positions[1], positions[2]));
+		const glm::vec2 max_position = glm::max(positions[0], glm::max(positions[1], positions[2]));
+
+		//pixels whose center can be inside, clamped before the cast so triangles far outside don't overflow
+		triangle.m_min_x = (int32_t)glm::clamp(std::floor(min_position.x - 0.5f), 0.0f, (float)width);
+		triangle.m_min_y = (int32_t)glm::clamp(std::floor(min_position.y - 0.5f), 0.0f, (float)height);
+		triangle.m_max_x = (int32_t)glm::clamp(std::ceil(max_position.x - 0.5f), -1.0f, (float)(width - 1));
+		triangle.m_max_y = (int32_t)glm::clamp(std::ceil(max_position.y - 0.5f), -1.0f, (float)(height - 1));
+
+		if (triangle.m_min_x > triangle.m_max_x || triangle.m_min_y > triangle.m_max_y)
+		{
+			return;
+		}
+
+		const uint32_t triangle_index = (uint32_t)m_triangles.size();
+		m_triangles.push_back(triangle);
+
+		for (int32_t tile_y = triangle.m_min_y / tile_size; tile_y <= triangle.m_max_y / tile_size; ++tile_y)
+		{
+			for (int32_t tile_x = triangle.m_min_x / tile_size; tile_x <= triangle.m_max_x / tile_size; ++tile_x)
+			{
+				m_tile_triangles[tile_y * m_num_tiles_x + tile_x].push_back(triangle_index);
+			}
+		}
+	}
+
+	void FSlateSoftwareRasterizer::draw_tile(int32_t tile_index, FSlateSoftwareFramebuffer& framebuffer) const
+	{
+		const float* srgb_to_linear = get_srgb_to_linear_table();
+
+		const int32_t tile_min_x = (tile_index % m_num_tiles_x) * tile_size;
+		const int32_t tile_min_y = (tile_index / m_num_tiles_x) * tile_size;
+		const int32_t tile_max_x = std::min(tile_min_x + tile_size, (int32_t)framebuffer.m_width) - 1;
+		const int32_t tile_max_y = std::min(tile_min_y + tile_size, (int32_t)framebuffer.m_height) - 1;
+
+		for (const uint32_t triangle_index : m_tile_triangles[tile_index])
+		{
+			const FTriangle& triangle = m_triangles[triangle_index];
+
+			const int32_t min_x = std::max(triangle.m_min_x, tile_min_x);
+			const int32_t min_y = std::max(triangle.m_min_y, tile_min_y);
+			const int32_t max_x = std::min(triangle.m_max_x, tile_max_x);
+			const int32_t max_y = std::min(triangle.m_max_y, tile_max_y);
+
+			//edge k is opposite to corner k, its function divided by the area is the weight of corner k
+			glm::vec2 edge_start[3];
+			glm::vec2 edge_end[3];
+			float edge_step_x[3];
+			bool b_top_left[3];
+			for (int32_t edge = 0; edge < 3; ++edge)
+			{
+				const glm::vec2& a = triangle.m_positions[(edge + 1) % 3];
+				const glm::vec2& b = triangle.m_positions[(edge + 2) % 3];
+
+				edge_start[edge] = a;
+				edge_end[edge] = b;
+				edge_step_x[edge] = a.y - b.y;
+				b_top_left[edge] = is_top_left_edge(a, b);
+			}
+
+			const float inv_area = 1.0f / triangle.m_area;
+
+			const FSlateSoftwareTexture* texture = triangle.m_texture;
+			const int32_t texture_width = (int32_t)texture->get_width();
+			const int32_t texture_height = (int32_t)texture->get_height();
+			const uint8_t* texels = texture->get_pixels();
+
+			//solid boxes sample one texel with one color, the pixel is the same everywhere
+			const bool b_constant = texture_width == 1 && texture_height == 1 && triangle.m_colors[0] == triangle.m_colors[1] && triangle.m_colors[0] == triangle.m_colors[2];
+
+			uint8_t constant_pixel[4];
+			if (b_constant)
+			{
+				const glm::vec4& color = triangle.m_colors[0];
+				constant_pixel[0] = to_unorm8(srgb_to_linear[texels[0]] * color.r);
+				constant_pixel[1] = to_unorm8(srgb_to_linear[texels[1]] * color.g);
+				constant_pixel[2] = to_unorm8(srgb_to_linear[texels[2]] * color.b);
+				constant_pixel[3] = to_unorm8(texels[3] * (1.0f / 255.0f) * color.a);
+			}
+
+			for (int32_t y = min_y; y <= max_y; ++y)
+			{
+				const glm::vec2 row_start((float)min_x + 0.5f, (float)y + 0.5f);
+
+				float weights[3];
+				for (int32_t edge = 0; edge < 3; ++edge)
+				{
+					weights[edge] = edge_function(edge_start[edge], edge_end[edge], row_start);
+				}
+
+				uint8_t* pixel = framebuffer.m_pixels.data() + ((size_t)y * framebuffer.m_width + min_x) * 4;
+
+				for (int32_t x = min_x; x <= max_x; ++x, pixel += 4)
+				{
+					const bool b_inside =
+						(weights[0] > 0.0f || (weights[0] == 0.0f && b_top_left[0])) &&
+						(weights[1] > 0.0f || (weights[1] == 0.0f && b_top_left[1])) &&
+						(weights[2] > 0.0f || (weights[2] == 0.0f && b_top_left[2]));
+
+					if (b_inside)
+					{
+						if (b_constant)
+						{
+							std::memcpy(pixel, constant_pixel, 4);
+						}
+						else
+						{
+							const float weight0 = weights[0] * inv_area;
+							const float weight1 = weights[1] * inv_area;
+							const float weight2 = weights[2] * inv_area;
+
+							const glm::vec2 uv = triangle.m_uvs[0] * weight0 + triangle.m_uvs[1] * weight1 + triangle.m_uvs[2] * weight2;
+							const glm::vec4 color = triangle.m_colors[0] * weight0 + triangle.m_colors[1] * weight1 + triangle.m_colors[2] * weight2;
+
+							//nearest texel with repeat addressing
+							const float wrapped_u = uv.x - std::floor(uv.x);
+							const float wrapped_v = uv.y - std::floor(uv.y);
+							const int32_t texel_x = std::min((int32_t)(wrapped_u * texture_width), texture_width - 1);
+							const int32_t texel_y = std::min((int32_t)(wrapped_v * texture_height), texture_height - 1);
+
+							const uint8_t* texel = texels + ((size_t)texel_y * texture_width + texel_x) * 4;
+
+							pixel[0] = to_unorm8(srgb_to_linear[texel[0]] * color.r);
+							pixel[1] = to_unorm8(srgb_to_linear[texel[1]] * color.g);
+							pixel[2] = to_unorm8(srgb_to_linear[texel[2]] * color.b);
+							pixel[3] = to_unorm8(texel[3] * (1.0f / 255.0f) * color.a);
+						}
+					}
+
+					weights[0] += edge_step_x[0];
+					weights[1] += edge_step_x[1];
+					weights[2] += edge_step_x[2];
+				}
+			}
+		}
+	}
+}
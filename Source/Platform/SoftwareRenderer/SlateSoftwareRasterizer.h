@@ -0,0 +1,101 @@
+#pragma once
+
+#include "glm/glm.hpp"
+
+#include "SlateCore/Rendering/ElementBatcher.h"//FSlateBatchData, FSlateVertex and SlateIndex depend on it
+
+namespace DoDo {
+	class FQueuedThreadPool;
+	class FSlateSoftwareTexture;
+
+	/*
+	 * pixels of a window drawn by the software renderer
+	 * r8g8b8a8 unorm, tightly packed rows, top row first
+	 */
+	struct FSlateSoftwareFramebuffer
+	{
+		uint32_t m_width;
+
+		uint32_t m_height;
+
+		std::vector<uint8_t> m_pixels;
+
+		FSlateSoftwareFramebuffer()
+			: m_width(0)
+			, m_height(0)
+		{}
+
+		void resize(uint32_t in_width, uint32_t in_height)
+		{
+			m_width = in_width;
+			m_height = in_height;
+			m_pixels.resize((size_t)in_width * in_height * 4);
+		}
+	};
+
+	/*
+	 * draws the merged render batches of a window on the cpu
+	 * the framebuffer is split into tiles, the triangles are binned to the tiles they touch and the tiles are drawn in parallel
+	 * every tile draws its triangles in batch order, so the result doesn't depend on the number of threads
+	 * the rules follow the vulkan pipeline: pixel centers at +0.5, top left fill rule, back faces culled, nearest repeat sampling
+	 * of srgb textures, texture * vertex color written without blending
+	 */
+	class FSlateSoftwareRasterizer
+	{
+	public:
+		/*width and height of a tile in pixels*/
+		static const int32_t tile_size = 64;
+
+		explicit FSlateSoftwareRasterizer(FQueuedThreadPool* in_thread_pool);
+
+		/*fills the framebuffer with the clear color, r8g8b8a8*/
+		void clear(FSlateSoftwareFramebuffer& framebuffer, const uint8_t clear_color[4]) const;
+
+		/*
+		 * draws the batches of the batch data, vertices, indices and instances are the arrays written by copy_final_data
+		 *
+		 * @param white_texture drawn by batches without a texture
+		 */
+		void draw_batches(const FSlateBatchData& batch_data, const FSlateVertex* vertices, const SlateIndex* indices, const FSlateQuadInstance* instances,
+			const FSlateSoftwareTexture* white_texture, FSlateSoftwareFramebuffer& framebuffer);
+
+	private:
+		/*a triangle after setup, the edge functions and the attributes are ready for the tiles*/
+		struct FTriangle
+		{
+			glm::vec2 m_positions[3];
+
+			/*sum of both texture coordinates, the pixel shader samples at their sum*/
+			glm::vec2 m_uvs[3];
+
+			glm::vec4 m_colors[3];
+
+			const FSlateSoftwareTexture* m_texture;
+
+			/*twice the area, always positive, back faces are culled in setup*/
+			float m_area;
+
+			/*pixel bounds, inclusive*/
+			int32_t m_min_x;
+			int32_t m_min_y;
+			int32_t m_max_x;
+			int32_t m_max_y;
+		};
+
+		void add_triangle(const glm::vec2 positions[3], const glm::vec2 uvs[3], const glm::vec4 colors[3], const FSlateSoftwareTexture* texture, int32_t width, int32_t height);
+
+		void draw_tile(int32_t tile_index, FSlateSoftwareFramebuffer& framebuffer) const;
+
+		FQueuedThreadPool* m_thread_pool;
+
+		/*triangles of the current draw_batches in batch order*/
+		std::vector<FTriangle> m_triangles;
+
+		/*triangle indices per tile, ascending, kept between draws to keep their memory*/
+		std::vector<std::vector<uint32_t>> m_tile_triangles;
+
+		int32_t m_num_tiles_x;
+
+		int32_t m_num_tiles_y;
+	};
+}
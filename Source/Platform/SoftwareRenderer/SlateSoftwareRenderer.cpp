@@ -0,0 +1,189 @@
+#include <PreCompileHeader.h>
+
+#include "SlateSoftwareRenderer.h"
+
+#include "SlateCore/Widgets/SWindow.h"
+
+#include "SlateCore/Rendering/DrawElements.h"
+
+#include "SlateSoftwareTextureManager.h"
+
+#include "Core/Misc/PngWriter.h"//save_view_port_png depends on it
+
+#include <chrono>//batching time depends on it
+
+namespace DoDo {
+	/*the clear color of the vulkan render pass, 0.4 blue*/
+	static const uint8_t software_clear_color[4] = { 0, 0, 102, 255 };
+
+	FSlateSoftwareRenderer::FSlateSoftwareRenderer()
+		: m_batching_time(0.0)
+		, m_rasterization_time(0.0)
+		, m_b_has_attempted_initialization(false)
+	{
+	}
+
+	FSlateSoftwareRenderer::~FSlateSoftwareRenderer()
+	{
+	}
+
+	FSlateDrawBuffer& FSlateSoftwareRenderer::get_draw_buffer()
+	{
+		m_draw_buffer.clear_buffer();
+		return m_draw_buffer;
+	}
+
+	void FSlateSoftwareRenderer::create_view_port(const std::shared_ptr<SWindow> in_window)
+	{
+		const glm::vec2 window_size = in_window->get_size_in_screen();
+
+		FSlateSoftwareViewport& view_port = m_window_to_viewport_map[in_window.get()];
+		view_port.m_framebuffer.resize((uint32_t)window_size.x, (uint32_t)window_size.y);
+	}
+
+	void FSlateSoftwareRenderer::draw_windows(FSlateDrawBuffer& in_window_draw_buffer)
+	{
+		const std::vector<std::shared_ptr<FSlateWindowElementList>>& window_element_lists = in_window_draw_buffer.get_window_element_lists();
+
+		const std::chrono::high_resolution_clock::time_point start_time = std::chrono::high_resolution_clock::now();
+
+		batch_window_element_lists(window_element_lists);
+
+		const std::chrono::high_resolution_clock::time_point batched_time = std::chrono::high_resolution_clock::now();
+
+		//the windows are drawn one after another, each one uses all threads for its tiles
+		for (size_t list_index = 0; list_index < window_element_lists.size(); ++list_index)
+		{
+			FSlateWindowElementList& element_list = *window_element_lists[list_index];
+
+			SWindow* window_to_draw = element_list.get_render_window();
+			if (window_to_draw == nullptr)
+			{
+				continue;
+			}
+
+			auto view_port_it = m_window_to_viewport_map.find(window_to_draw);
+			if (view_port_it == m_window_to_viewport_map.end())
+			{
+				continue;
+			}
+
+			FSlateSoftwareViewport& view_port = view_port_it->second;
+
+			//resizing is free here, unlike a swap chain
+			const glm::vec2 window_size = window_to_draw->get_size_in_screen();
+			if ((uint32_t)window_size.x != view_port.m_framebuffer.m_width || (uint32_t)window_size.y != view_port.m_framebuffer.m_height)
+			{
+				view_port.m_framebuffer.resize((uint32_t)window_size.x, (uint32_t)window_size.y);
+			}
+
+			FSlateBatchData& batch_data = element_list.get_batch_data();
+
+			//sort and merge the render batches, then write them out like the vulkan buffers, offsets start at 0
+			batch_data.merge_render_batches();
+
+			m_vertices.resize(batch_data.get_num_final_vertices());
+			m_indices.resize(batch_data.get_num_final_indices());
+			m_instances.resize(batch_data.get_num_final_instances());
+
+			batch_data.copy_final_data(m_vertices.data(), m_indices.data(), m_instances.data());
+
+			m_rasterizer->clear(view_port.m_framebuffer, software_clear_color);
+
+			m_rasterizer->draw_batches(batch_data, m_vertices.data(), m_indices.data(), m_instances.data(), m_texture_manager->get_white_texture(), view_port.m_framebuffer);
+
+			view_port.m_b_drawn = true;
+		}
+
+		const std::chrono::high_resolution_clock::time_point end_time = std::chrono::high_resolution_clock::now();
+
+		m_batching_time = std::chrono::duration<double, std::milli>(batched_time - start_time).count();
+		m_rasterization_time = std::chrono::duration<double, std::milli>(end_time - batched_time).count();
+	}
+
+	void FSlateSoftwareRenderer::batch_window_element_lists(const std::vector<std::shared_ptr<FSlateWindowElementList>>& window_element_lists)
+	{
+		const int32_t num_lists = (int32_t)window_element_lists.size();
+
+		while ((int32_t)m_element_batchers.size() < num_lists)
+		{
+			//the rasterizer expands instanced quads itself, they save the vertex setup
+			m_element_batchers.push_back(std::make_unique<FSlateElementBatcher>());
+			m_element_batchers.back()->set_use_instanced_quads(true);
+		}
+
+		m_thread_pool->parallel_for(num_lists, [&](int32_t list_index)
+		{
+			FSlateWindowElementList& element_list = *window_element_lists[list_index];
+
+			if (element_list.get_render_window())
+			{
+				m_element_batchers[list_index]->add_elements(element_list);
+			}
+		});
+	}
+
+	FSlateResourceHandle FSlateSoftwareRenderer::get_resource_handle(const FSlateBrush& brush, glm::vec2 local_size, float draw_scale)
+	{
+		return m_texture_manager->get_resource_handle(brush, local_size, draw_scale);
+	}
+
+	bool FSlateSoftwareRenderer::initialize()
+	{
+		if (!m_b_has_attempted_initialization)
+		{
+			m_thread_pool = std::make_unique<FQueuedThreadPool>(FQueuedThreadPool::get_default_num_threads());
+
+			m_texture_manager = std::make_unique<FSlateSoftwareTextureManager>();
+
+			m_rasterizer = std::make_unique<FSlateSoftwareRasterizer>(m_thread_pool.get());
+
+			m_b_has_attempted_initialization = true;
+		}
+
+		return true;
+	}
+
+	void FSlateSoftwareRenderer::destroy()
+	{
+		m_window_to_viewport_map.clear();
+
+		m_element_batchers.clear();
+
+		m_rasterizer.reset();
+
+		m_texture_manager.reset();
+
+		m_thread_pool.reset();
+	}
+
+	bool FSlateSoftwareRenderer::read_back_view_port(const SWindow* window, std::vector<uint8_t>& out_pixels, uint32_t& out_width, uint32_t& out_height)
+	{
+		auto view_port_it = m_window_to_viewport_map.find(window);
+		if (view_port_it == m_window_to_viewport_map.end() || !view_port_it->second.m_b_drawn)
+		{
+			return false;
+		}
+
+		const FSlateSoftwareFramebuffer& framebuffer = view_port_it->second.m_framebuffer;
+
+		out_width = framebuffer.m_width;
+		out_height = framebuffer.m_height;
+		out_pixels = framebuffer.m_pixels;
+
+		return true;
+	}
+
+	bool FSlateSoftwareRenderer::save_view_port_png(const SWindow* window, const char* file_path)
+	{
+		auto view_port_it = m_window_to_viewport_map.find(window);
+		if (view_port_it == m_window_to_viewport_map.end() || !view_port_it->second.m_b_drawn)
+		{
+			return false;
+		}
+
+		const FSlateSoftwareFramebuffer& framebuffer = view_port_it->second.m_framebuffer;
+
+		return FPngWriter::write_rgba(file_path, framebuffer.m_width, framebuffer.m_height, framebuffer.m_pixels.data());
+	}
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "Core/Core.h"
+
+#include "SlateCore/Rendering/SlateDrawBuffer.h"
+
+#include "SlateCore/Rendering/ElementBatcher.h"//FSlateElementBatcher and unique_ptr need this
+
+#include "Renderer/Renderer.h"//slate renderer
+
+#include "Core/Misc/QueuedThreadPool.h"//FQueuedThreadPool depends on it
+
+#include "SlateSoftwareRasterizer.h"//FSlateSoftwareFramebuffer depends on it
+
+namespace DoDo {
+	class FSlateSoftwareTextureManager;
+	/*
+	 * renders the windows on the cpu into framebuffers in memory
+	 * it consumes the same batch data as the vulkan renderer and needs no gpu, no driver and no display
+	 * the pixels aren't presented, read them with read_back_view_port
+	 */
+	class FSlateSoftwareRenderer : public Renderer
+	{
+	public:
+		FSlateSoftwareRenderer();
+
+		virtual ~FSlateSoftwareRenderer();
+
+		/*FSlateRenderer Interface*/
+		FSlateDrawBuffer& get_draw_buffer() override;
+
+		/*the framebuffer follows the size of the window*/
+		void create_view_port(const std::shared_ptr<SWindow> in_window) override;
+
+		void draw_windows(FSlateDrawBuffer& in_window_draw_buffer) override;
+
+		virtual FSlateResourceHandle get_resource_handle(const FSlateBrush& brush, glm::vec2 local_size, float draw_scale) override;
+
+		bool initialize() override;
+
+		virtual void destroy() override;
+
+		/*every view port is drawn in memory, so any view port of a drawn window can be read back*/
+		bool read_back_view_port(const SWindow* window, std::vector<uint8_t>& out_pixels, uint32_t& out_width, uint32_t& out_height) override;
+
+		bool save_view_port_png(const SWindow* window, const char* file_path) override;
+		/*FSlateRenderer Interface*/
+
+		/*wall time of the last draw_windows, in milliseconds*/
+		double get_batching_time() const { return m_batching_time; }
+		double get_rasterization_time() const { return m_rasterization_time; }
+
+	private:
+		void batch_window_element_lists(const std::vector<std::shared_ptr<FSlateWindowElementList>>& window_element_lists);
+
+		struct FSlateSoftwareViewport
+		{
+			FSlateSoftwareFramebuffer m_framebuffer;
+
+			bool m_b_drawn;
+
+			FSlateSoftwareViewport()
+				: m_b_drawn(false)
+			{}
+		};
+
+		std::map<const SWindow*, FSlateSoftwareViewport> m_window_to_viewport_map;
+
+		FSlateDrawBuffer m_draw_buffer;
+
+		/*one per window element list, the lists are batched in parallel*/
+		std::vector<std::unique_ptr<FSlateElementBatcher>> m_element_batchers;
+
+		/*batches the element lists and rasterizes the tiles*/
+		std::unique_ptr<FQueuedThreadPool> m_thread_pool;
+
+		std::unique_ptr<FSlateSoftwareTextureManager> m_texture_manager;
+
+		std::unique_ptr<FSlateSoftwareRasterizer> m_rasterizer;
+
+		/*merged batch data of the window being drawn, kept between frames to keep their memory*/
+		std::vector<FSlateVertex> m_vertices;
+		std::vector<SlateIndex> m_indices;
+		std::vector<FSlateQuadInstance> m_instances;
+
+		double m_batching_time;
+
+		double m_rasterization_time;
+
+		bool m_b_has_attempted_initialization;
+	};
+}
@@ -0,0 +1,83 @@
+#include <PreCompileHeader.h>
+
+#include "SlateSoftwareTextureManager.h"
+
+#include "SlateCore/Styling/SlateBrush.h"
+
+#include "stb_image.h"
+
+namespace DoDo {
+	FSlateSoftwareTextureManager::FSlateSoftwareTextureManager()
+	{
+		std::vector<uint8_t> white_pixels(4, 255);
+
+		m_white_texture = (const FSlateSoftwareTexture*)create_texture_resource("DefaultWhite", 1, 1, std::move(white_pixels))->m_resource;
+	}
+
+	FSlateSoftwareTextureManager::~FSlateSoftwareTextureManager()
+	{
+	}
+
+	FSlateShaderResourceProxy* FSlateSoftwareTextureManager::get_shader_resource(const FSlateBrush& in_brush, glm::vec2 local_size, float draw_scale)
+	{
+		FSlateShaderResourceProxy* texture = nullptr;
+
+		if (in_brush.get_image_type() == ESlateBrushImageType::Vector)
+		{
+			//todo:
+		}
+		else if (in_brush.get_resource_name() != "")
+		{
+			auto it = m_resource_map.find(in_brush.get_resource_name());
+			if (it != m_resource_map.end())
+			{
+				texture = it->second;
+			}
+			else
+			{
+				//first use, decode it right away, there is nothing to upload
+				const DoDoUtf8String resource_path = get_resource_path(in_brush);
+
+				int32_t x = 0, y = 0, n = 0;
+				unsigned char* data = stbi_load(resource_path.c_str(), &x, &y, &n, 4);
+
+				if (data != nullptr)
+				{
+					std::vector<uint8_t> pixels(data, data + (size_t)x * y * 4);
+
+					stbi_image_free(data);
+
+					texture = create_texture_resource(in_brush.get_resource_name(), x, y, std::move(pixels));
+				}
+				else
+				{
+					std::cout << "failed to load texture " << resource_path.c_str() << std::endl;
+
+					//draws white, like brushes without a texture
+					texture = new FSlateShaderResourceProxy;
+					texture->m_resource = const_cast<FSlateSoftwareTexture*>(m_white_texture);
+					texture->m_actual_size = FIntPoint(1, 1);
+
+					m_resource_map.insert({ in_brush.get_resource_name(), texture });
+				}
+			}
+		}
+
+		return texture;
+	}
+
+	FSlateShaderResourceProxy* FSlateSoftwareTextureManager::create_texture_resource(const DoDoUtf8String& texture_name, uint32_t width, uint32_t height, std::vector<uint8_t>&& pixels)
+	{
+		m_textures.push_back(std::make_unique<FSlateSoftwareTexture>(width, height, std::move(pixels)));
+
+		FSlateShaderResourceProxy* new_proxy = new FSlateShaderResourceProxy;
+		new_proxy->m_resource = m_textures.back().get();
+		new_proxy->m_start_uv = glm::vec2(0.0f, 0.0f);
+		new_proxy->m_size_uv = glm::vec2(1.0f, 1.0f);
+		new_proxy->m_actual_size = FIntPoint(width, height);
+
+		m_resource_map.insert({ texture_name, new_proxy });
+
+		return new_proxy;
+	}
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "SlateCore/Rendering/ShaderResourceManager.h"
+
+#include "SlateCore/Textures/SlateShaderResource.h"//FSlateShaderResource depends on it
+
+namespace DoDo {
+	/*
+	* a texture in system memory, the software rasterizer samples it directly
+	* pixels are r8g8b8a8 in srgb space, like the images the vulkan renderer uploads
+	*/
+	class FSlateSoftwareTexture : public FSlateShaderResource
+	{
+	public:
+		FSlateSoftwareTexture(uint32_t in_width, uint32_t in_height, std::vector<uint8_t>&& in_pixels)
+			: m_width(in_width)
+			, m_height(in_height)
+			, m_pixels(std::move(in_pixels))
+		{}
+
+		virtual uint32_t get_width() const override { return m_width; }
+
+		virtual uint32_t get_height() const override { return m_height; }
+
+		virtual ESlateShaderResource::Type get_type() const override { return ESlateShaderResource::NativeTexture; }
+
+		/*tightly packed rows, top row first*/
+		const uint8_t* get_pixels() const { return m_pixels.data(); }
+
+	private:
+		uint32_t m_width;
+
+		uint32_t m_height;
+
+		std::vector<uint8_t> m_pixels;
+	};
+
+	/*
+	* texture manager of the software renderer
+	* textures are decoded on first use and never atlased, there is no upload so they are valid right away
+	*/
+	class FSlateSoftwareTextureManager : public FSlateShaderResourceManager
+	{
+	public:
+		FSlateSoftwareTextureManager();
+
+		virtual ~FSlateSoftwareTextureManager();
+
+		virtual FSlateShaderResourceProxy* get_shader_resource(const FSlateBrush& in_brush, glm::vec2 local_size, float draw_scale) override;
+
+		/*batches without a texture are drawn with it*/
+		const FSlateSoftwareTexture* get_white_texture() const { return m_white_texture; }
+
+	private:
+		FSlateShaderResourceProxy* create_texture_resource(const DoDoUtf8String& texture_name, uint32_t width, uint32_t height, std::vector<uint8_t>&& pixels);
+
+		/*all textures, the proxies in m_resource_map point to them*/
+		std::vector<std::unique_ptr<FSlateSoftwareTexture>> m_textures;
+
+		const FSlateSoftwareTexture* m_white_texture;
+	};
+}
@@ -6,6 +6,7 @@ namespace DoDo
 {
 	FSlateVulkanIndexBuffer::FSlateVulkanIndexBuffer()
 		: m_max_num_indices(0)
+		, m_mapped_data(nullptr)
 	{
 	}
 
@@ -19,7 +20,7 @@ namespace DoDo
 			m_max_num_indices = 1000;
 		}
 
-		uint32_t size_bytes = m_max_num_indices * sizeof(uint16_t);
+		uint32_t size_bytes = m_max_num_indices * sizeof(SlateIndex);
 
 		upload_mesh(allocator, size_bytes);
 	}
@@ -39,9 +40,14 @@ namespace DoDo
 		//let the vma library know that this data should be writeable by cpu, but also readable by gpu
 		VmaAllocationCreateInfo vma_allocation_info = {};
 		vma_allocation_info.usage = VMA_MEMORY_USAGE_CPU_TO_GPU;
+		//keep it mapped, so there is no map and unmap every frame
+		vma_allocation_info.flags = VMA_ALLOCATION_CREATE_MAPPED_BIT;
 
 		//allocate the buffer
-		vmaCreateBuffer(allocator, &buffer_info, &vma_allocation_info, &m_buffer.m_buffer, &m_buffer.m_allocation, nullptr);
+		VmaAllocationInfo allocation_info = {};
+		vmaCreateBuffer(allocator, &buffer_info, &vma_allocation_info, &m_buffer.m_buffer, &m_buffer.m_allocation, &allocation_info);
+
+		m_mapped_data = (uint8_t*)allocation_info.pMappedData;
 
 		//copy cpu to gpu
 		//void* data;
@@ -56,60 +62,33 @@ namespace DoDo
 	void FSlateVulkanIndexBuffer::destroy_buffer(VmaAllocator& allocator)
 	{
 		vmaDestroyBuffer(allocator, m_buffer.m_buffer, m_buffer.m_allocation);
-	}
-
-	void* FSlateVulkanIndexBuffer::lock(VmaAllocator& allocator, uint32_t offset)
-	{
-		void* data;
-		vmaMapMemory(allocator, m_buffer.m_allocation, &data);
 
-		//memcpy(data, vertex_array.data(), vertex_array.size() * sizeof(FSlateVertex));
-
-		//vmaUnmapMemory(allocator, m_vertex_buffer.m_buffer.m_allocation);
-		return (void*)((uint8_t*)data + offset);//todo:one byte offset
+		m_mapped_data = nullptr;
 	}
-	void FSlateVulkanIndexBuffer::unlock(VmaAllocator& allocator)
+
+	void FSlateVulkanIndexBuffer::flush(VmaAllocator& allocator, uint32_t offset, uint32_t size)
 	{
-		vmaUnmapMemory(allocator, m_buffer.m_allocation);
+		vmaFlushAllocation(allocator, m_buffer.m_allocation, offset, size);
 	}
 
-	void FSlateVulkanIndexBuffer::resize_buffer(VmaAllocator& allocator, uint32_t num_indices)
+	void FSlateVulkanIndexBuffer::resize_buffer(VmaAllocator& allocator, uint32_t num_indices, std::vector<AllocatedBuffer>& retired_buffers)
 	{
 		//buffer should be created first
 
 		if (num_indices > m_max_num_indices)
 		{
-			//todo:first to copy the already have buffer's data, then copy to new buffer
-
-			uint32_t buffer_size = m_max_num_indices * sizeof(uint16_t);
-
-			uint8_t* saved_indices = nullptr;
-
-			{
-				void* indices = lock(allocator, 0);
-
-				saved_indices = new uint8_t[m_max_num_indices * sizeof(uint16_t)];
-				std::memcpy(saved_indices, indices, buffer_size);
-
-				unlock(allocator);
-			}
-
-			vmaDestroyBuffer(allocator, m_buffer.m_buffer, m_buffer.m_allocation);
-			if (saved_indices)
-			{
-				//copy to new buffer
-				upload_mesh(allocator, num_indices * sizeof(uint16_t));//create new buffer
-
-				void* indices = lock(allocator, 0);
+			//the old buffer is still mapped, copy straight from it into the new one
+			uint8_t* old_mapped_data = m_mapped_data;
+			AllocatedBuffer old_buffer = m_buffer;
 
-				std::memcpy(indices, saved_indices, buffer_size);
+			upload_mesh(allocator, num_indices * sizeof(SlateIndex));//create new buffer
 
-				unlock(allocator);
+			std::memcpy(m_mapped_data, old_mapped_data, m_max_num_indices * sizeof(SlateIndex));
 
-				m_max_num_indices = num_indices;
-			}
+			//windows drawn before the resize bound the old buffer
+			retired_buffers.push_back(old_buffer);
 
-			delete[] saved_indices;
+			m_max_num_indices = num_indices;
 		}
 	}
 }
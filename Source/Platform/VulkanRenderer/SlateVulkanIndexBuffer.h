@@ -2,6 +2,8 @@
 
 #include "Utils.h"
 
+#include "SlateCore/Rendering/RenderingCommon.h"//SlateIndex
+
 namespace DoDo
 {
 	class FSlateVulkanIndexBuffer
@@ -18,11 +20,17 @@ namespace DoDo
 
 		void destroy_buffer(VmaAllocator& allocator);
 
-		void* lock(VmaAllocator& allocator, uint32_t offset);
+		/*@return the persistently mapped memory at offset bytes*/
+		void* get_mapped_data(uint32_t offset) const { return m_mapped_data + offset; }
 
-		void unlock(VmaAllocator& allocator);
+		/*makes the written range visible to the gpu, does nothing for host coherent memory*/
+		void flush(VmaAllocator& allocator, uint32_t offset, uint32_t size);
 
-		void resize_buffer(VmaAllocator& allocator, uint32_t num_indices);
+		/*
+		 * grows the buffer and keeps its contents
+		 * commands recorded earlier in the frame may still read the old buffer, so it is added to retired buffers instead of destroyed
+		 */
+		void resize_buffer(VmaAllocator& allocator, uint32_t num_indices, std::vector<AllocatedBuffer>& retired_buffers);
 
 		uint32_t get_max_num_indices() const { return m_max_num_indices; }
 
@@ -30,5 +38,7 @@ namespace DoDo
 		uint32_t m_max_num_indices;
 
 		AllocatedBuffer m_buffer;
+
+		uint8_t* m_mapped_data;
 	};
 }
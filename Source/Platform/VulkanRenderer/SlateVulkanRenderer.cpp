@@ -22,8 +22,13 @@
 
 #include "Core/Misc/Paths.h"//shader path depends on it
 
+#include "Core/Misc/PngWriter.h"//save_view_port_png depends on it
+
 #include "VulkanInitializers.h"
 
+#include <chrono>//batching time depends on it
+#include <thread>//frame pacing sleeps
+
 #ifdef WIN32
 //------vulkan for glfw------
 #define VK_USE_PLATFORM_WIN32_KHR
@@ -48,6 +53,34 @@
 #endif
 
 namespace DoDo {
+#ifndef Android
+	static DoDoUtf8String get_shader_path(const char* shader_file_name)
+	{
+#ifdef SLATE_SHADER_DIR
+		//set from the build, the shaders are compiled into the build directory, see the compile shaders section in the cmake lists
+		return DoDoUtf8String((std::string(SLATE_SHADER_DIR) + shader_file_name).c_str());
+#else
+		return FPaths::engine_dir() / (std::string("Shader//") + shader_file_name).c_str();
+#endif
+	}
+#endif
+
+#if SLATE_USE_TEXTURE_CACHE
+	static DoDoUtf8String get_texture_cache_path()
+	{
+		return FPaths::engine_dir() / "Saved//SlateTextureCache.bin";
+	}
+#endif
+
+	/*frames the latency percentiles are taken over*/
+	static const uint32_t frame_latency_sample_count = 256;
+
+	/*frames the vblank prediction of the frame pacing looks back*/
+	static const uint32_t frame_pacing_sample_count = 32;
+
+	/*the frame pacing wakes up this much earlier than the work needs, covers the jitter of the sleep, in milliseconds*/
+	static const double frame_pacing_margin = 2.0;
+
 #define VK_CHECK(x) \
 	do \
 	{ \
@@ -170,9 +203,40 @@ namespace DoDo {
 			-(right + left) / (right - left), -(bottom + top) / (bottom - top), -zNear / (-zNear + zFar), 1.0f);
 	}
 
+	/*the pixels of a damage rect inside the image, the rects of the damage tracker are whole pixels*/
+	static VkRect2D get_damage_scissor(const FSlateRect& damage_rect, VkExtent2D extent)
+	{
+		const int32_t left = std::clamp((int32_t)damage_rect.left, 0, (int32_t)extent.width);
+		const int32_t top = std::clamp((int32_t)damage_rect.top, 0, (int32_t)extent.height);
+		const int32_t right = std::clamp((int32_t)std::ceil(damage_rect.right), left, (int32_t)extent.width);
+		const int32_t bottom = std::clamp((int32_t)std::ceil(damage_rect.bottom), top, (int32_t)extent.height);
+
+		VkRect2D scissor;
+		scissor.offset = { left, top };
+		scissor.extent = { (uint32_t)(right - left), (uint32_t)(bottom - top) };
+		return scissor;
+	}
+
 	FSlateVulkanRenderer::FSlateVulkanRenderer()
 	{
 		m_b_has_attempted_initialization = false;
+		m_b_initialized = false;
+		m_b_use_instanced_quads = false;
+		m_frame_number = 0;
+		m_num_frames_in_flight = SLATE_VULKAN_FRAMES_IN_FLIGHT;
+		m_fence_wait_time = 0.0;
+		m_timestamp_period = 0.0;
+		m_timestamp_mask = 0;
+		m_num_bindless_textures = 0;
+		m_pipeline_creation_time = 0.0;
+		m_b_frame_started = false;
+		m_frame_input_times.resize(m_num_frames_in_flight);
+		m_frame_latency_pending.resize(m_num_frames_in_flight, false);
+		m_frame_latencies.resize(frame_latency_sample_count, 0.0);
+		m_num_frame_latencies = 0;
+		m_acquire_intervals.resize(frame_pacing_sample_count, 0.0);
+		m_frame_work_times.resize(frame_pacing_sample_count, 0.0);
+		m_num_pacing_samples = 0;
 		m_view_matrix = glm::mat4x4(1.0f);//identity view matrix
 	}
 
@@ -205,6 +269,13 @@ namespace DoDo {
 
 	void FSlateVulkanRenderer::draw_windows(FSlateDrawBuffer& in_window_draw_buffer)
 	{
+		//without wait_for_next_frame the latency counts from here
+		if(!m_b_frame_started)
+		{
+			m_frame_start_time = std::chrono::high_resolution_clock::now();
+		}
+		m_b_frame_started = false;
+
 		//iterate through each element list and set up an rhi window for it if needed
 		const std::vector<std::shared_ptr<FSlateWindowElementList>>& window_element_lists = in_window_draw_buffer.get_window_element_lists();
 
@@ -223,6 +294,46 @@ namespace DoDo {
 		//	}
 		//}
 
+		//textures whose upload finished become valid for the batchers
+		m_upload_queue->submit();
+		m_upload_queue->process_completed_uploads();
+
+		//the batchers only touch their own element list, buffer upload and submission stay in order afterwards
+		batch_window_element_lists(window_element_lists);
+
+		VkDevice device = *(VkDevice*)m_logic_device->get_native_handle();
+
+		const uint32_t frame_index = (uint32_t)(m_frame_number % m_num_frames_in_flight);
+
+		//cpu wait gpu, the frame's buffers and command buffers are reused only after the gpu finished with them
+		VkFence frame_fence = m_frame_fences[frame_index];
+
+		const std::chrono::high_resolution_clock::time_point wait_start_time = std::chrono::high_resolution_clock::now();
+
+		VK_CHECK(vkWaitForFences(device, 1, &frame_fence, true, UINT64_MAX));
+
+		m_fence_wait_time = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - wait_start_time).count();
+
+		record_frame_latency(frame_index);
+
+		read_back_gpu_times(device, frame_index);
+
+		//frames up to m_frame_number - m_num_frames_in_flight finished, their textures can be released
+		m_texture_manager->update_residency(m_frame_number);
+
+		m_rendering_policy->begin_frame(m_allocator, frame_index, m_frame_number);
+
+		//the command buffers of all windows go to the gpu in one submit and the swap chains in one present
+		std::vector<VkCommandBuffer> submit_command_buffers;
+		std::vector<VkSemaphore> submit_wait_semaphores;
+		std::vector<VkPipelineStageFlags> submit_wait_stages;
+		std::vector<VkSemaphore> submit_signal_semaphores;
+		std::vector<VkSwapchainKHR> present_swap_chains;
+		std::vector<uint32_t> present_image_indices;
+		std::vector<FSlateVulkanViewport*> present_view_ports;
+
+		bool b_first_acquire = true;
+
 		for(size_t list_index = 0; list_index < window_element_lists.size(); ++list_index)
 		{
 			FSlateWindowElementList& element_list = *window_element_lists[list_index];
@@ -232,11 +343,6 @@ namespace DoDo {
 			{
 				SWindow* window_to_draw = element_list.get_render_window();
 
-				//add all elements for this window to the element batcher
-				
-				//add_elements will add render batch to the element list's batch data array
-				m_element_batcher->add_elements(element_list);
-
 				FSlateBatchData& batch_data = element_list.get_batch_data();//get the batch data(this is generated by the all elements)
 
 				m_rendering_policy->build_rendering_buffers(m_allocator, batch_data);//generate the vulkan buffer (video memory) to draw
@@ -245,25 +351,60 @@ namespace DoDo {
 
 				FSlateVulkanViewport& view_port = m_window_to_viewport_map.find(window_to_draw)->second;
 
-				VkDevice device = *(VkDevice*)m_logic_device->get_native_handle();
-				VkSwapchainKHR swap_chain = *(VkSwapchainKHR*)view_port.m_vulkan_swap_chain->get_native_handle();
+				FSlateVulkanViewportFrame& frame = view_port.m_frames[frame_index];
 
-				//note:also wait the all windows element fence, but don't reset last fence
+				VkSwapchainKHR swap_chain = VK_NULL_HANDLE;
 
-				//wait until the gpu has finished rendering the last frame, timeout of 1 second
-				//cpu wait gpu
-				VK_CHECK(vkWaitForFences(device, 1, &view_port.m_fence, true, UINT64_MAX));
-				VK_CHECK(vkResetFences(device, 1, &view_port.m_fence));
+				uint32_t swap_chain_image_index = 0;
 
-				//request image from the swap chain, one second timeout
-				uint32_t swap_chain_image_index;
-				//1 seconds is our fps lock
-				//image available semaphore
-				vkAcquireNextImageKHR(device, swap_chain, UINT64_MAX, view_port.m_present_semaphore, VK_NULL_HANDLE, &swap_chain_image_index);
+				VkExtent2D vk_extent;
+
+				if(view_port.m_b_offscreen)
+				{
+					//one image for all frames in flight, the render pass waits for the copy of the frame before
+					vk_extent.width = view_port.m_width;
+					vk_extent.height = view_port.m_height;
+				}
+				else
+				{
+					swap_chain = *(VkSwapchainKHR*)view_port.m_vulkan_swap_chain->get_native_handle();
 
-				VK_CHECK(vkResetCommandBuffer(view_port.m_command_buffer, 0));
+					//request image from the swap chain, one second timeout
+					//1 seconds is our fps lock
+					//image available semaphore
+					const std::chrono::high_resolution_clock::time_point acquire_start_time = std::chrono::high_resolution_clock::now();
 
-				VkCommandBuffer cmd = view_port.m_command_buffer;
+					const VkResult acquire_result = vkAcquireNextImageKHR(device, swap_chain, UINT64_MAX, frame.m_present_semaphore, VK_NULL_HANDLE, &swap_chain_image_index);
+
+					//with fifo the first acquire of a frame returns when the display released an image, that is at vblank
+					if(b_first_acquire)
+					{
+						const std::chrono::high_resolution_clock::time_point acquire_time = std::chrono::high_resolution_clock::now();
+
+						const uint32_t sample_index = m_num_pacing_samples % frame_pacing_sample_count;
+						m_acquire_intervals[sample_index] = std::chrono::duration<double, std::milli>(acquire_time - m_last_acquire_time).count();
+						m_frame_work_times[sample_index] = std::chrono::duration<double, std::milli>(acquire_start_time - m_frame_start_time).count();
+						++m_num_pacing_samples;
+
+						m_last_acquire_time = acquire_time;
+						b_first_acquire = false;
+					}
+
+					//an out of date swap chain fails right away, only this window misses the frame
+					if(acquire_result != VK_SUCCESS && acquire_result != VK_SUBOPTIMAL_KHR)
+					{
+						view_port.m_present_result = acquire_result;
+						continue;
+					}
+
+					std::pair<uint32_t, uint32_t> extent = view_port.m_vulkan_swap_chain->get_swap_chain_extent();
+					vk_extent.width = extent.first;
+					vk_extent.height = extent.second;//todo:reinterpret cast
+				}
+
+				VK_CHECK(vkResetCommandBuffer(frame.m_command_buffer, 0));
+
+				VkCommandBuffer cmd = frame.m_command_buffer;
 
 				VkCommandBufferBeginInfo cmd_begin_info = {};
 				cmd_begin_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
@@ -274,101 +415,409 @@ namespace DoDo {
 
 				VK_CHECK(vkBeginCommandBuffer(cmd, &cmd_begin_info));
 
-				VkClearValue clearValue;
-				//float flash = abs(sin(m_frame_number / 120.f));
-				clearValue.color = { { 0.0f, 0.0f, 0.4, 1.0f } };
-
-				VkRenderPassBeginInfo rpInfo = {};
-				rpInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
-				rpInfo.pNext = nullptr;
+				//queries are reset outside of the render pass, the timestamps bracket the whole pass
+				//the submit waits for the acquired image at the color attachment output stage, a top of pipe timestamp would count that wait
+				if(frame.m_timestamp_query_pool != VK_NULL_HANDLE)
+				{
+					vkCmdResetQueryPool(cmd, frame.m_timestamp_query_pool, 0, 2);
+					vkCmdWriteTimestamp(cmd, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, frame.m_timestamp_query_pool, 0);
+				}
 
-				rpInfo.renderPass = m_render_pass;
-				rpInfo.renderArea.offset.x = 0;
-				rpInfo.renderArea.offset.y = 0;
-				std::pair<uint32_t, uint32_t> extent = view_port.m_vulkan_swap_chain->get_swap_chain_extent();
-				VkExtent2D vk_extent;
-				vk_extent.width = extent.first;
-				vk_extent.height = extent.second;//todo:reinterpret cast
-				rpInfo.renderArea.extent = vk_extent;
-				rpInfo.framebuffer = view_port.m_vulkan_framebuffer[swap_chain_image_index];//frame buffer
+				//the image still holds the frame it was drawn with last time, only what changed since then is drawn again
+				bool b_redraw_damage = false;
+#if SLATE_USE_DAMAGE_REDRAW
+				b_redraw_damage = view_port.m_damage_tracker.get_damage_since(view_port.m_image_damage_frames[swap_chain_image_index], m_damage_rects);
 
-				//connect clear values
-				rpInfo.clearValueCount = 1;
-				rpInfo.pClearValues = &clearValue;
+				view_port.m_image_damage_frames[swap_chain_image_index] = view_port.m_damage_tracker.get_frame_number();
+#endif
+				//a full redraw has one scissor over the view port
+				if(!b_redraw_damage)
+				{
+					m_damage_rects.assign(1, FSlateRect(0.0f, 0.0f, view_port.m_view_port_info.width, view_port.m_view_port_info.height));
+				}
 
-				vkCmdBeginRenderPass(cmd, &rpInfo, VK_SUBPASS_CONTENTS_INLINE);
+				//a damage redraw only loads and stores the bounds of the damage, a full redraw clears the whole image
+				VkRect2D render_area = { { 0, 0 }, vk_extent };
+				if(b_redraw_damage && !m_damage_rects.empty())
+				{
+					FSlateRect damage_bounds = m_damage_rects[0];
+					for(const FSlateRect& damage_rect : m_damage_rects)
+					{
+						damage_bounds = FSlateRect(std::min(damage_bounds.left, damage_rect.left), std::min(damage_bounds.top, damage_rect.top),
+							std::max(damage_bounds.right, damage_rect.right), std::max(damage_bounds.bottom, damage_rect.bottom));
+					}
+					render_area = get_damage_scissor(damage_bounds, vk_extent);
+				}
+
+				float redrawn_pixels = 0.0f;
+
+				//nothing changed since the image was drawn, it is presented again as it is
+				if(!m_damage_rects.empty())
+				{
+					VkClearValue clearValue;
+					//float flash = abs(sin(m_frame_number / 120.f));
+					clearValue.color = { { 0.0f, 0.0f, 0.4, 1.0f } };
+
+					VkRenderPassBeginInfo rpInfo = {};
+					rpInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+					rpInfo.pNext = nullptr;
+
+					if(view_port.m_b_offscreen)
+					{
+						rpInfo.renderPass = b_redraw_damage ? m_offscreen_load_render_pass : m_offscreen_render_pass;
+					}
+					else
+					{
+						rpInfo.renderPass = b_redraw_damage ? m_load_render_pass : m_render_pass;
+					}
+					rpInfo.renderArea = render_area;
+					rpInfo.framebuffer = view_port.m_vulkan_framebuffer[swap_chain_image_index];//frame buffer, offscreen view ports have one
+
+					//connect clear values, the load pass ignores them
+					rpInfo.clearValueCount = 1;
+					rpInfo.pClearValues = &clearValue;
+
+					vkCmdBeginRenderPass(cmd, &rpInfo, VK_SUBPASS_CONTENTS_INLINE);
+
+					//pso is bound by the rendering policy, it switches to the instanced quad pipeline when needed
+
+					//todo:bind vertex buffer
+
+					//todo:bind view port
+					vkCmdSetViewport(cmd, 0, 1, &view_port.m_view_port_info);
+
+					const VkPipeline pipeline = *static_cast<VkPipeline*>(m_pipeline_state_object->get_native_handle());
+					const VkPipeline instanced_quad_pipeline = m_b_use_instanced_quads ? *static_cast<VkPipeline*>(m_instanced_quad_pipeline_state_object->get_native_handle()) : VK_NULL_HANDLE;
+
+					bool b_drew_all_batches = true;
+
+					//every damage rect draws the batches again under its scissor, the rects don't overlap
+					for(const FSlateRect& damage_rect : m_damage_rects)
+					{
+						const VkRect2D scissor = get_damage_scissor(damage_rect, vk_extent);
+
+						vkCmdSetScissor(cmd, 0, 1, &scissor);
+
+						//the window paints no background, what moved away or was removed is only covered by the clear color
+						if(b_redraw_damage)
+						{
+							VkClearAttachment clear_attachment = {};
+							clear_attachment.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+							clear_attachment.colorAttachment = 0;
+							clear_attachment.clearValue = clearValue;
+
+							VkClearRect clear_rect = {};
+							clear_rect.rect = scissor;
+							clear_rect.baseArrayLayer = 0;
+							clear_rect.layerCount = 1;
+
+							vkCmdClearAttachments(cmd, 1, &clear_attachment, 1, &clear_rect);
+						}
+
+						if(!m_rendering_policy->draw_elements(cmd, pipeline, instanced_quad_pipeline, *(VkPipelineLayout*)(m_pipeline_state_object->get_pipeline_layout()), m_bindless_descriptor_set, m_view_matrix * view_port.m_projection_matrix, batch_data))
+						{
+							b_drew_all_batches = false;
+						}
+
+						redrawn_pixels += (float)scissor.extent.width * (float)scissor.extent.height;
+					}
+
+					vkCmdEndRenderPass(cmd);
+
+#if SLATE_USE_DAMAGE_REDRAW
+					//the left out batches show up once their texture is resident, the batches themselves don't change then
+					if(!b_drew_all_batches)
+					{
+						view_port.m_damage_tracker.invalidate_all();
+					}
+#endif
+				}
 
-				//todo:bind pso
-				vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, *static_cast<VkPipeline*>(m_pipeline_state_object->get_native_handle()));
+				view_port.m_redraw_fraction = b_redraw_damage ? redrawn_pixels / std::max((float)vk_extent.width * (float)vk_extent.height, 1.0f) : 1.0f;
 
-				//todo:bind vertex buffer
+				if(frame.m_timestamp_query_pool != VK_NULL_HANDLE)
+				{
+					vkCmdWriteTimestamp(cmd, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, frame.m_timestamp_query_pool, 1);
+					frame.m_b_timestamps_pending = true;
+				}
 
-				//todo:bind view port
-				vkCmdSetViewport(cmd, 0, 1, &view_port.m_view_port_info);
+				if(view_port.m_b_offscreen)
+				{
+					//the render pass left the image in transfer source layout
+					VkBufferImageCopy copy_region = {};
+					copy_region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+					copy_region.imageSubresource.layerCount = 1;
+					copy_region.imageExtent = { vk_extent.width, vk_extent.height, 1 };
 
-				VkRect2D scissor{};
-				scissor.offset = { 0, 0 };
-				scissor.extent.width = view_port.m_view_port_info.width;
-				scissor.extent.height = view_port.m_view_port_info.height;
+					vkCmdCopyImageToBuffer(cmd, view_port.m_offscreen_image._image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, view_port.m_readback_buffers[frame_index].m_buffer, 1, &copy_region);
 
-				vkCmdSetScissor(cmd, 0, 1, &scissor);
+					//makes the copy visible to the host once the frame fence signaled
+					VkBufferMemoryBarrier readback_barrier = {};
+					readback_barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+					readback_barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+					readback_barrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+					readback_barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+					readback_barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+					readback_barrier.buffer = view_port.m_readback_buffers[frame_index].m_buffer;
+					readback_barrier.size = VK_WHOLE_SIZE;
 
-				//todo:draw
-				m_rendering_policy->draw_elements(device,  cmd, *(VkPipelineLayout*)(m_pipeline_state_object->get_pipeline_layout()),m_sampler,m_view_matrix * view_port.m_projection_matrix, batch_data.get_first_render_batch_index(), batch_data.get_render_batches(), batch_data.get_total_vertex_offset(), batch_data.get_total_index_offset());
+					vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_HOST_BIT, 0, 0, nullptr, 1, &readback_barrier, 0, nullptr);
 
-				vkCmdEndRenderPass(cmd);
+					view_port.m_last_drawn_frame = m_frame_number;
+				}
 
 				VK_CHECK(vkEndCommandBuffer(cmd));
 
-				VkSubmitInfo submit = {};
-				submit.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-				submit.pNext = nullptr;
+				submit_command_buffers.push_back(cmd);
 
-				VkPipelineStageFlags waitStage = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+				if(!view_port.m_b_offscreen)
+				{
+					//the window's commands wait for its image, the present waits for its commands
+					submit_wait_semaphores.push_back(frame.m_present_semaphore);//image available semaphore
+					submit_wait_stages.push_back(VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT);
+					submit_signal_semaphores.push_back(frame.m_render_semaphore);
 
-				submit.pWaitDstStageMask = &waitStage;
+					present_swap_chains.push_back(swap_chain);
+					present_image_indices.push_back(swap_chain_image_index);
+					present_view_ports.push_back(&view_port);
+				}
 
-				submit.waitSemaphoreCount = 1;
-				submit.pWaitSemaphores = &view_port.m_present_semaphore;//image available semaphore
+				//all elements have been drawn, reset all cached data
+				//m_element_batcher->reset
+			}
+		}
 
-				submit.signalSemaphoreCount = 1;
-				submit.pSignalSemaphores = &view_port.m_render_semaphore;
+		if(!submit_command_buffers.empty())
+		{
+			VkSubmitInfo submit = {};
+			submit.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+			submit.pNext = nullptr;
+
+			submit.pWaitDstStageMask = submit_wait_stages.data();
+
+			submit.waitSemaphoreCount = (uint32_t)submit_wait_semaphores.size();
+			submit.pWaitSemaphores = submit_wait_semaphores.data();
+
+			submit.signalSemaphoreCount = (uint32_t)submit_signal_semaphores.size();
+			submit.pSignalSemaphores = submit_signal_semaphores.data();
 
-				submit.commandBufferCount = 1;
-				submit.pCommandBuffers = &cmd;
+			submit.commandBufferCount = (uint32_t)submit_command_buffers.size();
+			submit.pCommandBuffers = submit_command_buffers.data();
 
-				VkQueue queue = *(VkQueue*)m_logic_device->get_graphics_queue();//all commands submit to one queue
+			VkQueue queue = *(VkQueue*)m_logic_device->get_graphics_queue();//all commands submit to one queue
 
-				VK_CHECK(vkQueueSubmit(queue, 1, &submit, view_port.m_fence));
+			//reset just before the submit, so a frame without windows keeps its fence signaled
+			VK_CHECK(vkResetFences(device, 1, &frame_fence));
+
+			VK_CHECK(vkQueueSubmit(queue, 1, &submit, frame_fence));
+
+			m_frame_input_times[frame_index] = m_frame_start_time;
+			m_frame_latency_pending[frame_index] = true;
+
+			//offscreen view ports have nothing to present
+			if(!present_swap_chains.empty())
+			{
+				//every swap chain gets its own result, the return value only reports the first failure
+				std::vector<VkResult> present_results(present_swap_chains.size(), VK_SUCCESS);
 
 				VkPresentInfoKHR presentInfo = {};
 				presentInfo.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
 				presentInfo.pNext = nullptr;
 
-				presentInfo.pSwapchains = &swap_chain;
-				presentInfo.swapchainCount = 1;
+				presentInfo.pSwapchains = present_swap_chains.data();
+				presentInfo.swapchainCount = (uint32_t)present_swap_chains.size();
 
-				presentInfo.pWaitSemaphores = &view_port.m_render_semaphore;
-				presentInfo.waitSemaphoreCount = 1;
+				presentInfo.pWaitSemaphores = submit_signal_semaphores.data();
+				presentInfo.waitSemaphoreCount = (uint32_t)submit_signal_semaphores.size();
 
-				presentInfo.pImageIndices = &swap_chain_image_index;
+				presentInfo.pImageIndices = present_image_indices.data();
 
-				VK_CHECK(vkQueuePresentKHR(queue, &presentInfo));
+				presentInfo.pResults = present_results.data();
 
-				//last_windows_fences.push_back(view_port.m_fence);
+				vkQueuePresentKHR(queue, &presentInfo);
 
-				//all elements have been drawn, reset all cached data
-				//m_element_batcher->reset
+				for(size_t present_index = 0; present_index < present_view_ports.size(); ++present_index)
+				{
+					const VkResult present_result = present_results[present_index];
+
+					present_view_ports[present_index]->m_present_result = present_result;
+
+					//out of date and suboptimal swap chains only affect their window
+					if(present_result != VK_SUBOPTIMAL_KHR && present_result != VK_ERROR_OUT_OF_DATE_KHR)
+					{
+						VK_CHECK(present_result);
+					}
+				}
 			}
 		}
 
 		++m_frame_number;
 
-		m_rendering_policy->reset_offset();
-
 		//flush the cache if needed
 	}
 
+	void FSlateVulkanRenderer::wait_for_next_frame()
+	{
+		if(!m_frame_fences.empty())
+		{
+			VkDevice device = *(VkDevice*)m_logic_device->get_native_handle();
+
+			//frames the gpu finished since the last check
+			for(uint32_t frame_index = 0; frame_index < m_num_frames_in_flight; ++frame_index)
+			{
+				if(m_frame_latency_pending[frame_index] && vkGetFenceStatus(device, m_frame_fences[frame_index]) == VK_SUCCESS)
+				{
+					record_frame_latency(frame_index);
+				}
+			}
+
+#if SLATE_FRAME_PACING
+			//wait for the frame's resources here instead of in draw_windows, the input isn't read while the gpu is still behind
+			const uint32_t frame_index = (uint32_t)(m_frame_number % m_num_frames_in_flight);
+
+			VK_CHECK(vkWaitForFences(device, 1, &m_frame_fences[frame_index], true, UINT64_MAX));
+
+			record_frame_latency(frame_index);
+
+			sleep_until_frame_deadline();
+#endif
+		}
+
+		m_frame_start_time = std::chrono::high_resolution_clock::now();
+		m_b_frame_started = true;
+	}
+
+	void FSlateVulkanRenderer::record_frame_latency(uint32_t frame_index)
+	{
+		if(!m_frame_latency_pending[frame_index])
+		{
+			return;
+		}
+
+		m_frame_latencies[m_num_frame_latencies % frame_latency_sample_count] = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - m_frame_input_times[frame_index]).count();
+		++m_num_frame_latencies;
+
+		m_frame_latency_pending[frame_index] = false;
+	}
+
+	void FSlateVulkanRenderer::sleep_until_frame_deadline()
+	{
+		const VulkanSwapChain* swap_chain = get_first_swap_chain();
+
+		if(swap_chain == nullptr || m_num_pacing_samples < frame_pacing_sample_count)
+		{
+			return;
+		}
+
+		//the other present modes don't block the acquire, there is no vblank to aim for
+		const VkPresentModeKHR present_mode = swap_chain->get_present_mode();
+		if(present_mode != VK_PRESENT_MODE_FIFO_KHR && present_mode != VK_PRESENT_MODE_FIFO_RELAXED_KHR)
+		{
+			return;
+		}
+
+		//frames that missed a vblank take two intervals, the shortest is the refresh interval
+		const double refresh_interval = *std::min_element(m_acquire_intervals.begin(), m_acquire_intervals.end());
+
+		//the slowest recent frame, so a spike doesn't miss the vblank
+		const double work_time = *std::max_element(m_frame_work_times.begin(), m_frame_work_times.end()) + frame_pacing_margin;
+
+		if(work_time >= refresh_interval)
+		{
+			return;
+		}
+
+		//the next image is released one refresh interval after the last one, a missed deadline starts the frame at once
+		const std::chrono::high_resolution_clock::time_point wake_time = m_last_acquire_time + std::chrono::duration_cast<std::chrono::high_resolution_clock::duration>(std::chrono::duration<double, std::milli>(refresh_interval - work_time));
+
+		if(wake_time > std::chrono::high_resolution_clock::now())
+		{
+			std::this_thread::sleep_until(wake_time);
+		}
+	}
+
+	FSlateFrameLatencyStats FSlateVulkanRenderer::get_frame_latency_stats() const
+	{
+		FSlateFrameLatencyStats stats;
+
+		if(const VulkanSwapChain* swap_chain = get_first_swap_chain())
+		{
+			stats.m_present_mode = swap_chain->get_present_mode();
+		}
+
+		stats.m_num_samples = std::min(m_num_frame_latencies, frame_latency_sample_count);
+
+		if(stats.m_num_samples == 0)
+		{
+			return stats;
+		}
+
+		std::vector<double> latencies(m_frame_latencies.begin(), m_frame_latencies.begin() + stats.m_num_samples);
+
+		std::sort(latencies.begin(), latencies.end());
+
+		auto percentile = [&](double fraction)
+		{
+			return latencies[(size_t)(fraction * (latencies.size() - 1))];
+		};
+
+		stats.m_p50 = percentile(0.5);
+		stats.m_p90 = percentile(0.9);
+		stats.m_p99 = percentile(0.99);
+		stats.m_max = latencies.back();
+
+		return stats;
+	}
+
+	const VulkanSwapChain* FSlateVulkanRenderer::get_first_swap_chain() const
+	{
+		for(const std::pair<const SWindow* const, FSlateVulkanViewport>& window_and_view_port : m_window_to_viewport_map)
+		{
+			if(!window_and_view_port.second.m_b_offscreen)
+			{
+				return window_and_view_port.second.m_vulkan_swap_chain.get();
+			}
+		}
+
+		return nullptr;
+	}
+
+	void FSlateVulkanRenderer::batch_window_element_lists(const std::vector<std::shared_ptr<FSlateWindowElementList>>& window_element_lists)
+	{
+		const int32_t num_lists = (int32_t)window_element_lists.size();
+
+		while((int32_t)m_element_batchers.size() < num_lists)
+		{
+			m_element_batchers.push_back(std::make_unique<FSlateElementBatcher>());
+			m_element_batchers.back()->set_use_instanced_quads(m_b_use_instanced_quads);
+		}
+
+		m_window_batching_times.assign(num_lists, 0.0);
+
+		m_batching_thread_pool->parallel_for(num_lists, [&](int32_t list_index)
+		{
+			FSlateWindowElementList& element_list = *window_element_lists[list_index];
+
+			if(element_list.get_render_window())
+			{
+				const std::chrono::high_resolution_clock::time_point start_time = std::chrono::high_resolution_clock::now();
+
+				//add_elements will add render batch to the element list's batch data array
+				m_element_batchers[list_index]->add_elements(element_list);
+
+#if SLATE_USE_DAMAGE_REDRAW
+				//compared before build_rendering_buffers merges the batches, every window has its own view port
+				FSlateVulkanViewport& view_port = m_window_to_viewport_map.find(element_list.get_render_window())->second;
+				view_port.m_damage_tracker.gather_damage(element_list.get_batch_data(), glm::vec2(view_port.m_view_port_info.width, view_port.m_view_port_info.height));
+#endif
+
+				const std::chrono::high_resolution_clock::time_point end_time = std::chrono::high_resolution_clock::now();
+
+				m_window_batching_times[list_index] = std::chrono::duration<double, std::milli>(end_time - start_time).count();
+			}
+		});
+	}
+
 	FSlateResourceHandle FSlateVulkanRenderer::get_resource_handle(const FSlateBrush& brush, glm::vec2 local_size, float draw_scale)
 	{
 		return m_texture_manager->get_resource_handle(brush, local_size, draw_scale);
@@ -398,46 +847,92 @@ namespace DoDo {
 				//todo:implement create texture manager
 				create_sync_objects_for_immediate_upload(device);
 
+				create_frame_fences(device);
+
+				init_timestamp_queries();
+
+				//destroyed by the deletion queue before the allocator
+				const uint32_t queue_family_index = VulkanUtils::find_queue_families(m_physical_device).value();
+				m_upload_queue = std::make_unique<FSlateVulkanUploadQueue>(device, m_allocator, *(VkQueue*)m_logic_device->get_graphics_queue(), queue_family_index, 16 * 1024 * 1024);
+
+				m_deletion_queue.push_function([=]()
+				{
+					m_upload_queue->destroy();
+				});
+
+				//batchers are created per window element list in draw_windows, the pool is used by the texture loading first
+				m_batching_thread_pool = std::make_unique<FQueuedThreadPool>(FQueuedThreadPool::get_default_num_threads());
+
 				m_texture_manager = std::make_shared<FSlateVulkanTextureManager>();
 
-				m_texture_manager->load_used_textures();//load the texture centrally again
+				//runs before the upload queue and the allocator are destroyed
+				m_deletion_queue.push_function([=]()
+				{
+					m_texture_manager->destroy();
+				});
+
+				m_texture_manager->set_memory_budget((uint64_t)SLATE_TEXTURE_MEMORY_BUDGET_MB * 1024 * 1024);
+
+#if SLATE_USE_TEXTURE_CACHE
+				//decoded pixels of the style images from an earlier run
+				m_texture_manager->open_texture_cache(get_texture_cache_path());
+#endif
+
+				//textures are created when a brush is drawn the first time, see FSlateVulkanTextureManager::update_residency
 
 				//todo:implement rendering policy
-				m_rendering_policy = std::make_shared<FSlateVulkanRenderingPolicy>(m_allocator, m_texture_manager);//note:vma need first initialize
-				m_rendering_policy->reset_offset();
+				m_rendering_policy = std::make_shared<FSlateVulkanRenderingPolicy>(m_allocator, m_texture_manager, m_num_frames_in_flight);//note:vma need first initialize
 
-				//todo:implement element batcher
-				m_element_batcher = std::make_unique<FSlateElementBatcher>();
+				//compiled pipelines of earlier launches
+				m_pipeline_cache = std::make_unique<FVulkanPipelineCache>(device, m_physical_device, FPaths::engine_dir() / "Saved//SlatePipelineCache.bin");
 
-#ifdef Android
-				m_vertex_shader_module = Shader::Create("SlateDefaultVertexShader.spv", &device);
-				m_fragment_shader_module = Shader::Create("SlateElementPixelShader.spv", &device);
-#else
-				DoDoUtf8String vertex_shader_path = FPaths::engine_dir() / "Shader//SlateDefaultVertexShader.spv";
-				DoDoUtf8String fragment_shader_path = FPaths::engine_dir() / "Shader//SlateElementPixelShader.spv";
-				m_vertex_shader_module = Shader::Create(vertex_shader_path.c_str(), &device);
-				m_fragment_shader_module = Shader::Create(fragment_shader_path.c_str(), &device);
-#endif
-				m_pipeline_state_object = PipelineStateObject::Create(&device);
+				m_deletion_queue.push_function([=]()
+				{
+					m_pipeline_cache->destroy();
+				});
 
-				std::string target_point = "main";//todo:modify this to other string type
+				precompile_pipelines();
 
-				m_pipeline_state_object->set_vertex_shader(*m_vertex_shader_module, target_point);
-				m_pipeline_state_object->set_pixel_shader(*m_fragment_shader_module, target_point);
-				m_pipeline_state_object->set_render_pass(&m_render_pass);
-				VertexInputDescription input_description = get_vertex_description();
-				m_pipeline_state_object->set_input_vertex_layout(&input_description);//todo:get address
-				m_pipeline_state_object->set_descriptor_set(1, &m_shader_set_layout);//set descriptor set layout
-				m_pipeline_state_object->finalize(&device);//todo:fix me
+				m_b_initialized = true;
 			}
 		}
 
 		m_b_has_attempted_initialization = true;
-		return m_b_has_attempted_initialization;
+		return m_b_initialized;
 	}
 
 	void FSlateVulkanRenderer::destroy()
 	{
+		//no instance or no device, there is nothing to destroy
+		if(!m_b_initialized)
+		{
+			return;
+		}
+
+#if SLATE_USE_TEXTURE_CACHE
+		//images were added or changed, the next run reads them from the cache again
+		if (m_texture_manager->has_textures_to_cook() && !m_texture_manager->cook_texture_cache(get_texture_cache_path()))
+		{
+			std::cout << "failed to write texture cache " << get_texture_cache_path().c_str() << std::endl;
+		}
+#endif
+
+		const FSlateFrameLatencyStats latency_stats = get_frame_latency_stats();
+		if(latency_stats.m_num_samples > 0)
+		{
+			LOGI("slate frame latency (present mode %d): p50 %.2f ms, p90 %.2f ms, p99 %.2f ms, max %.2f ms over %u frames\n",
+				(int32_t)latency_stats.m_present_mode, latency_stats.m_p50, latency_stats.m_p90, latency_stats.m_p99, latency_stats.m_max, latency_stats.m_num_samples);
+		}
+
+		for(const std::pair<const SWindow* const, FSlateVulkanViewport>& view_port : m_window_to_viewport_map)
+		{
+			const FSlateWindowGpuTimeStats& gpu_time_stats = view_port.second.m_gpu_time_stats;
+			if(gpu_time_stats.m_num_samples > 0)
+			{
+				LOGI("slate window gpu time: average %.3f ms, max %.3f ms over %u frames\n", gpu_time_stats.m_average, gpu_time_stats.m_max, gpu_time_stats.m_num_samples);
+			}
+		}
+
 		Renderer::destroy();
 
 		VkDevice device = *(VkDevice*)m_logic_device->get_native_handle();
@@ -446,6 +941,13 @@ namespace DoDo {
 
 		m_pipeline_state_object->Destroy(&device);
 
+		if(m_b_use_instanced_quads)
+		{
+			m_instanced_quad_pipeline_state_object->Destroy(&device);
+
+			m_instanced_quad_vertex_shader_module->Destroy(&device);
+		}
+
 		m_rendering_policy->clear_vulkan_buffer(m_allocator);
 
 		m_vertex_shader_module->Destroy(&device);
@@ -524,6 +1026,12 @@ namespace DoDo {
 
 		VkResult result = vkCreateInstance(&create_info, nullptr, &m_vulkan_instance);
 
+		if (result != VK_SUCCESS)
+		{
+			LOGE("failed to create vulkan instance, error %d\n", (int32_t)result);
+			return false;
+		}
+
 		//------after create instance to create debug messenger------
 		setup_debug_message();
 		//------after create instance to create debug messenger------
@@ -531,6 +1039,17 @@ namespace DoDo {
 		//------pick a adapter------
 		m_physical_device = VK_NULL_HANDLE;
 		pick_physical_device();
+
+		if (m_physical_device == VK_NULL_HANDLE)
+		{
+			if (enable_validation_layers)
+			{
+				destroy_debug_utils_messenger_ext(m_vulkan_instance, m_debug_messenger, nullptr);
+			}
+
+			vkDestroyInstance(m_vulkan_instance, nullptr);
+			return false;
+		}
 		//------pick a adapter------
 
 		//------create logic device------
@@ -552,13 +1071,12 @@ namespace DoDo {
 
 		init_descriptors();
 
-		return result == VK_SUCCESS ? true : false;
+		return true;
 	}
 
 	void FSlateVulkanRenderer::load_style_resources(const ISlateStyle& style)
 	{
-		//todo:call texture manager
-		m_texture_manager->load_style_resources(style);//create real video memory texture
+		//the textures of the style are created when one of its brushes is drawn the first time, call FSlateVulkanTextureManager::load_style_resources to preload them
 	}
 
 	void FSlateVulkanRenderer::private_create_view_port(std::shared_ptr<SWindow> in_window, glm::vec2& window_size)
@@ -582,8 +1100,12 @@ namespace DoDo {
 		//create framebuffer, frame buffer connect the render pass and image
 		viewport.m_vulkan_framebuffer = viewport.m_vulkan_swap_chain->create_frame_buffer(*device, m_render_pass, m_deletion_queue);
 
+		viewport.m_image_damage_frames.assign(viewport.m_vulkan_framebuffer.size(), UINT64_MAX);
+
 		create_sync_objects(viewport);
 
+		create_timestamp_query_pools(viewport);
+
 		create_command_buffer(viewport);
 
 		viewport.m_view_port_info.maxDepth = 1.0f;
@@ -599,6 +1121,148 @@ namespace DoDo {
 		m_window_to_viewport_map.insert({in_window.get(), viewport});
 	}
 
+	void FSlateVulkanRenderer::create_offscreen_view_port(const std::shared_ptr<SWindow> in_window, uint32_t width, uint32_t height)
+	{
+		FSlateVulkanViewport viewport;
+		viewport.m_b_offscreen = true;
+		viewport.m_vulkan_surface = VK_NULL_HANDLE;
+		viewport.m_width = width;
+		viewport.m_height = height;
+
+		VkDevice device = *(VkDevice*)m_logic_device->get_native_handle();
+
+		//the format of m_render_pass, so the pipelines draw into it
+		const VkFormat image_format = VK_FORMAT_B8G8R8A8_UNORM;
+
+		VkImageCreateInfo image_info = image_create_info(image_format, VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT, { width, height, 1 });
+
+		VmaAllocationCreateInfo image_alloc_info = {};
+		image_alloc_info.usage = VMA_MEMORY_USAGE_GPU_ONLY;
+
+		VK_CHECK(vmaCreateImage(m_allocator, &image_info, &image_alloc_info, &viewport.m_offscreen_image._image, &viewport.m_offscreen_image._allocation, nullptr));
+
+		VkImageViewCreateInfo image_view_info = imageview_create_info(image_format, viewport.m_offscreen_image._image, VK_IMAGE_ASPECT_COLOR_BIT);
+
+		VK_CHECK(vkCreateImageView(device, &image_view_info, nullptr, &viewport.m_offscreen_image_view));
+
+		VkFramebufferCreateInfo framebuffer_info = {};
+		framebuffer_info.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
+		framebuffer_info.renderPass = m_offscreen_render_pass;
+		framebuffer_info.attachmentCount = 1;
+		framebuffer_info.pAttachments = &viewport.m_offscreen_image_view;
+		framebuffer_info.width = width;
+		framebuffer_info.height = height;
+		framebuffer_info.layers = 1;
+
+		VkFramebuffer framebuffer;
+		VK_CHECK(vkCreateFramebuffer(device, &framebuffer_info, nullptr, &framebuffer));
+		viewport.m_vulkan_framebuffer.push_back(framebuffer);
+
+		//the one image keeps its pixels between frames like a swap chain image
+		viewport.m_image_damage_frames.assign(1, UINT64_MAX);
+
+		for(uint32_t frame_index = 0; frame_index < m_num_frames_in_flight; ++frame_index)
+		{
+			viewport.m_readback_buffers.push_back(create_buffer((size_t)width * height * 4, VK_BUFFER_USAGE_TRANSFER_DST_BIT, VMA_MEMORY_USAGE_GPU_TO_CPU));
+		}
+
+		//capture the handles, the view port is copied into the map after this
+		const AllocatedImage offscreen_image = viewport.m_offscreen_image;
+		const VkImageView offscreen_image_view = viewport.m_offscreen_image_view;
+		const std::vector<AllocatedBuffer> readback_buffers = viewport.m_readback_buffers;
+		m_deletion_queue.push_function([=]()
+		{
+			for(const AllocatedBuffer& readback_buffer : readback_buffers)
+			{
+				vmaDestroyBuffer(m_allocator, readback_buffer.m_buffer, readback_buffer.m_allocation);
+			}
+			vkDestroyFramebuffer(device, framebuffer, nullptr);
+			vkDestroyImageView(device, offscreen_image_view, nullptr);
+			vmaDestroyImage(m_allocator, offscreen_image._image, offscreen_image._allocation);
+		});
+
+		//the semaphores are created too but never waited on, draw_windows doesn't acquire or present for offscreen view ports
+		create_sync_objects(viewport);
+
+		create_timestamp_query_pools(viewport);
+
+		create_command_buffer(viewport);
+
+		viewport.m_view_port_info.maxDepth = 1.0f;
+		viewport.m_view_port_info.minDepth = 0.0f;
+		viewport.m_view_port_info.width = (float)width;
+		viewport.m_view_port_info.height = (float)height;
+		viewport.m_view_port_info.x = 0.0f;
+		viewport.m_view_port_info.y = 0.0f;
+
+		viewport.m_projection_matrix = create_projection_matrix_vulkan(width, height);
+
+		m_window_to_viewport_map.insert({in_window.get(), viewport});
+	}
+
+	bool FSlateVulkanRenderer::read_back_view_port(const SWindow* window, std::vector<uint8_t>& out_pixels, uint32_t& out_width, uint32_t& out_height)
+	{
+		auto it = m_window_to_viewport_map.find(window);
+
+		if(it == m_window_to_viewport_map.end() || !it->second.m_b_offscreen || it->second.m_last_drawn_frame == UINT64_MAX)
+		{
+			return false;
+		}
+
+		const FSlateVulkanViewport& view_port = it->second;
+
+		VkDevice device = *(VkDevice*)m_logic_device->get_native_handle();
+
+		//a later frame may use the fence already, then this waits for that frame, which finished the copy too
+		const uint32_t frame_index = (uint32_t)(view_port.m_last_drawn_frame % m_num_frames_in_flight);
+
+		VK_CHECK(vkWaitForFences(device, 1, &m_frame_fences[frame_index], true, UINT64_MAX));
+
+		const AllocatedBuffer& readback_buffer = view_port.m_readback_buffers[frame_index];
+
+		const size_t num_pixels = (size_t)view_port.m_width * view_port.m_height;
+
+		//gpu to cpu memory may not be host coherent
+		vmaInvalidateAllocation(m_allocator, readback_buffer.m_allocation, 0, VK_WHOLE_SIZE);
+
+		void* mapped_data;
+		VK_CHECK(vmaMapMemory(m_allocator, readback_buffer.m_allocation, &mapped_data));
+
+		//the image is b8g8r8a8 like the swap chains, swap to r8g8b8a8
+		const uint8_t* source = (const uint8_t*)mapped_data;
+		out_pixels.resize(num_pixels * 4);
+		for(size_t pixel_index = 0; pixel_index < num_pixels; ++pixel_index)
+		{
+			out_pixels[pixel_index * 4 + 0] = source[pixel_index * 4 + 2];
+			out_pixels[pixel_index * 4 + 1] = source[pixel_index * 4 + 1];
+			out_pixels[pixel_index * 4 + 2] = source[pixel_index * 4 + 0];
+			out_pixels[pixel_index * 4 + 3] = source[pixel_index * 4 + 3];
+		}
+
+		vmaUnmapMemory(m_allocator, readback_buffer.m_allocation);
+
+		out_width = view_port.m_width;
+		out_height = view_port.m_height;
+
+		record_frame_latency(frame_index);
+
+		return true;
+	}
+
+	bool FSlateVulkanRenderer::save_view_port_png(const SWindow* window, const char* file_path)
+	{
+		std::vector<uint8_t> pixels;
+		uint32_t width;
+		uint32_t height;
+
+		if(!read_back_view_port(window, pixels, width, height))
+		{
+			return false;
+		}
+
+		return FPngWriter::write_rgba(file_path, width, height, pixels.data());
+	}
+
 	void FSlateVulkanRenderer::pick_physical_device()
 	{
 		//enumerate physical device
@@ -609,6 +1273,7 @@ namespace DoDo {
 		{
 			LOGE("failed to find gpus with vulkan support!");
 			//std::cout << "failed to find gpus with vulkan support!" << std::endl;
+			return;
 		}
 
 		std::vector<VkPhysicalDevice> devices(device_count);
@@ -693,10 +1358,6 @@ namespace DoDo {
 
 	void FSlateVulkanRenderer::create_sync_objects(FSlateVulkanViewport& view_port)
 	{
-		VkFenceCreateInfo fence_create_info{};
-		fence_create_info.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
-		fence_create_info.flags = VK_FENCE_CREATE_SIGNALED_BIT;
-
 		VkDevice device = *(VkDevice*)m_logic_device->get_native_handle();
 
 		VkSemaphoreCreateInfo semaphoreCreateInfo = {};
@@ -704,19 +1365,172 @@ namespace DoDo {
 		semaphoreCreateInfo.pNext = nullptr;
 		semaphoreCreateInfo.flags = 0;
 
-		if(vkCreateFence(device, &fence_create_info, nullptr, &view_port.m_fence) != VK_SUCCESS
-		|| vkCreateSemaphore(device, &semaphoreCreateInfo, nullptr, &view_port.m_present_semaphore) != VK_SUCCESS
-		|| vkCreateSemaphore(device, &semaphoreCreateInfo, nullptr, &view_port.m_render_semaphore) != VK_SUCCESS)
+		view_port.m_frames.resize(m_num_frames_in_flight);
+
+		for(FSlateVulkanViewportFrame& frame : view_port.m_frames)
 		{
-			std::cout << "failed to create sync objects" << std::endl;
+			if(vkCreateSemaphore(device, &semaphoreCreateInfo, nullptr, &frame.m_present_semaphore) != VK_SUCCESS
+			|| vkCreateSemaphore(device, &semaphoreCreateInfo, nullptr, &frame.m_render_semaphore) != VK_SUCCESS)
+			{
+				std::cout << "failed to create sync objects" << std::endl;
+			}
+
+			//capture the handles, the view port is copied into the map after this
+			VkSemaphore present_semaphore = frame.m_present_semaphore;
+			VkSemaphore render_semaphore = frame.m_render_semaphore;
+			m_deletion_queue.push_function([=]()
+			{
+				vkDestroySemaphore(device, present_semaphore, nullptr);
+				vkDestroySemaphore(device, render_semaphore, nullptr);
+			});
 		}
+	}
 
-		m_deletion_queue.push_function([=]()
+	void FSlateVulkanRenderer::create_frame_fences(VkDevice device)
+	{
+		VkFenceCreateInfo fence_create_info{};
+		fence_create_info.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+		fence_create_info.flags = VK_FENCE_CREATE_SIGNALED_BIT;
+
+		m_frame_fences.resize(m_num_frames_in_flight);
+
+		for(VkFence& fence : m_frame_fences)
 		{
-			vkDestroyFence(device, view_port.m_fence, nullptr);
-			vkDestroySemaphore(device, view_port.m_present_semaphore, nullptr);
-			vkDestroySemaphore(device, view_port.m_render_semaphore, nullptr);
-		});
+			//fences start signaled, the first wait of every frame returns at once
+			if(vkCreateFence(device, &fence_create_info, nullptr, &fence) != VK_SUCCESS)
+			{
+				std::cout << "failed to create frame fence" << std::endl;
+			}
+
+			VkFence frame_fence = fence;
+			m_deletion_queue.push_function([=]()
+			{
+				vkDestroyFence(device, frame_fence, nullptr);
+			});
+		}
+	}
+
+	FSlateWindowGpuTimeStats FSlateVulkanRenderer::get_window_gpu_time_stats(const SWindow* window) const
+	{
+		auto it = m_window_to_viewport_map.find(window);
+
+		return it != m_window_to_viewport_map.end() ? it->second.m_gpu_time_stats : FSlateWindowGpuTimeStats();
+	}
+
+	float FSlateVulkanRenderer::get_window_redraw_fraction(const SWindow* window) const
+	{
+		auto it = m_window_to_viewport_map.find(window);
+
+		return it != m_window_to_viewport_map.end() ? it->second.m_redraw_fraction : 1.0f;
+	}
+
+	void FSlateVulkanRenderer::init_timestamp_queries()
+	{
+		VkPhysicalDeviceProperties gpu_properties;
+		vkGetPhysicalDeviceProperties(m_physical_device, &gpu_properties);
+
+		uint32_t queue_family_count = 0;
+		vkGetPhysicalDeviceQueueFamilyProperties(m_physical_device, &queue_family_count, nullptr);
+
+		std::vector<VkQueueFamilyProperties> queue_families(queue_family_count);
+		vkGetPhysicalDeviceQueueFamilyProperties(m_physical_device, &queue_family_count, queue_families.data());
+
+		const uint32_t queue_family_index = VulkanUtils::find_queue_families(m_physical_device).value();
+		const uint32_t timestamp_valid_bits = queue_families[queue_family_index].timestampValidBits;
+
+		if(timestamp_valid_bits == 0 || gpu_properties.limits.timestampPeriod <= 0.0f)
+		{
+			LOGI("the graphics queue has no timestamps, slate gpu times are off\n");
+			return;
+		}
+
+		m_timestamp_period = gpu_properties.limits.timestampPeriod;
+		m_timestamp_mask = timestamp_valid_bits >= 64 ? UINT64_MAX : (((uint64_t)1 << timestamp_valid_bits) - 1);
+	}
+
+	void FSlateVulkanRenderer::create_timestamp_query_pools(FSlateVulkanViewport& view_port)
+	{
+		if(!is_gpu_timing_supported())
+		{
+			return;
+		}
+
+		VkDevice device = *(VkDevice*)m_logic_device->get_native_handle();
+
+		VkQueryPoolCreateInfo query_pool_info = {};
+		query_pool_info.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+		query_pool_info.queryType = VK_QUERY_TYPE_TIMESTAMP;
+		query_pool_info.queryCount = 2;
+
+		for(FSlateVulkanViewportFrame& frame : view_port.m_frames)
+		{
+			if(vkCreateQueryPool(device, &query_pool_info, nullptr, &frame.m_timestamp_query_pool) != VK_SUCCESS)
+			{
+				//the window just has no gpu time
+				frame.m_timestamp_query_pool = VK_NULL_HANDLE;
+				continue;
+			}
+
+			VkQueryPool query_pool = frame.m_timestamp_query_pool;
+			m_deletion_queue.push_function([=]()
+			{
+				vkDestroyQueryPool(device, query_pool, nullptr);
+			});
+		}
+	}
+
+	void FSlateVulkanRenderer::read_back_gpu_times(VkDevice device, uint32_t frame_index)
+	{
+		//running average weight of the newest frame
+		const double running_average_scale = 0.1;
+
+		for(std::pair<const SWindow* const, FSlateVulkanViewport>& it : m_window_to_viewport_map)
+		{
+			FSlateVulkanViewport& view_port = it.second;
+			FSlateVulkanViewportFrame& frame = view_port.m_frames[frame_index];
+
+			if(!frame.m_b_timestamps_pending)
+			{
+				continue;
+			}
+
+			//no wait bit, the fence of the frame signaled, so the results are available
+			uint64_t timestamps[2] = { 0, 0 };
+			const VkResult query_result = vkGetQueryPoolResults(device, frame.m_timestamp_query_pool, 0, 2, sizeof(timestamps), timestamps, sizeof(uint64_t), VK_QUERY_RESULT_64_BIT);
+
+			frame.m_b_timestamps_pending = false;
+
+			if(query_result != VK_SUCCESS)
+			{
+				continue;
+			}
+
+			const uint64_t ticks = (timestamps[1] - timestamps[0]) & m_timestamp_mask;
+			const double gpu_time = (double)ticks * m_timestamp_period / 1000000.0;
+
+			FSlateWindowGpuTimeStats& stats = view_port.m_gpu_time_stats;
+			stats.m_last = gpu_time;
+			stats.m_average = stats.m_num_samples == 0 ? gpu_time : stats.m_average * (1.0 - running_average_scale) + gpu_time * running_average_scale;
+			stats.m_max = std::max(stats.m_max, gpu_time);
+			++stats.m_num_samples;
+		}
+	}
+
+	void FSlateVulkanRenderer::invalidate_view_port(const SWindow* window)
+	{
+		auto it = m_window_to_viewport_map.find(window);
+
+		if(it != m_window_to_viewport_map.end())
+		{
+			it->second.m_damage_tracker.invalidate_all();
+		}
+	}
+
+	VkResult FSlateVulkanRenderer::get_present_result(const SWindow* window) const
+	{
+		auto it = m_window_to_viewport_map.find(window);
+
+		return it != m_window_to_viewport_map.end() ? it->second.m_present_result : VK_ERROR_UNKNOWN;
 	}
 
 	void FSlateVulkanRenderer::create_sync_objects_for_immediate_upload(VkDevice device)
@@ -789,9 +1603,51 @@ namespace DoDo {
 
 		VK_CHECK(vkCreateRenderPass(device, &render_pass_info, nullptr, &m_render_pass));
 
+		//damage redraws keep the rest of the presented image, the image must have been drawn with m_render_pass before
+		color_attachment.loadOp = VK_ATTACHMENT_LOAD_OP_LOAD;
+		color_attachment.initialLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+
+		VkSubpassDependency load_dependency = dependency;
+		load_dependency.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+		render_pass_info.pDependencies = &load_dependency;
+
+		VK_CHECK(vkCreateRenderPass(device, &render_pass_info, nullptr, &m_load_render_pass));
+
+		color_attachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+		color_attachment.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+		//offscreen view ports copy the image to a buffer after the pass, and the next frame clears it while the copy may still run
+		color_attachment.finalLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+
+		VkSubpassDependency offscreen_dependencies[2] = { dependency, dependency };
+		offscreen_dependencies[0].srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT;
+
+		offscreen_dependencies[1].srcSubpass = 0;
+		offscreen_dependencies[1].dstSubpass = VK_SUBPASS_EXTERNAL;
+		offscreen_dependencies[1].srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+		offscreen_dependencies[1].srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+		offscreen_dependencies[1].dstStageMask = VK_PIPELINE_STAGE_TRANSFER_BIT;
+		offscreen_dependencies[1].dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+
+		render_pass_info.dependencyCount = 2;
+		render_pass_info.pDependencies = offscreen_dependencies;
+
+		VK_CHECK(vkCreateRenderPass(device, &render_pass_info, nullptr, &m_offscreen_render_pass));
+
+		//damage redraws of offscreen view ports load the image the copy of the frame before left in transfer source layout
+		color_attachment.loadOp = VK_ATTACHMENT_LOAD_OP_LOAD;
+		color_attachment.initialLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+
+		offscreen_dependencies[0].dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+
+		VK_CHECK(vkCreateRenderPass(device, &render_pass_info, nullptr, &m_offscreen_load_render_pass));
+
 		m_deletion_queue.push_function([=]()
 		{
 			vkDestroyRenderPass(device, m_render_pass, nullptr);
+			vkDestroyRenderPass(device, m_offscreen_render_pass, nullptr);
+			vkDestroyRenderPass(device, m_offscreen_load_render_pass, nullptr);
+			vkDestroyRenderPass(device, m_load_render_pass, nullptr);
 		});
 	}
 
@@ -800,9 +1656,11 @@ namespace DoDo {
 		//binding
 		VkDescriptorSetLayoutBinding shader_param = descriptorset_layout_binding(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, VK_SHADER_STAGE_FRAGMENT_BIT, 0);
 
+		//bindless, every texture owns one element of the array, slots past m_num_bindless_textures are never read
 		VkDescriptorSetLayoutBinding texture = descriptorset_layout_binding(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_SHADER_STAGE_FRAGMENT_BIT, 1);
+		texture.descriptorCount = SLATE_VULKAN_MAX_BINDLESS_TEXTURES;
 
-		VkDescriptorBindingFlags flags[2] = { VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT, VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT };
+		VkDescriptorBindingFlags flags[2] = { VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT, VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT | VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT };
 		VkDescriptorSetLayoutBindingFlagsCreateInfo bind_flags = {};
 		bind_flags.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO;
 		bind_flags.bindingCount = 2;
@@ -833,13 +1691,13 @@ namespace DoDo {
 			{ VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 10},
 			{ VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 10},
 			//add combined-image-sampler descriptor types to the pool
-			{ VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 20005 }
+			{ VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, SLATE_VULKAN_MAX_BINDLESS_TEXTURES }
 		};
 
 		VkDescriptorPoolCreateInfo pool_info = {};
 		pool_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
 		pool_info.flags = VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT;
-		pool_info.maxSets = 1000;
+		pool_info.maxSets = 1;//the bindless set
 		pool_info.poolSizeCount = (uint32_t)sizes.size();
 		pool_info.pPoolSizes = sizes.data();
 
@@ -865,6 +1723,15 @@ namespace DoDo {
 			vkDestroySampler(device, m_sampler, nullptr);
 		});
 
+		VkDescriptorSetAllocateInfo alloc_info = {};
+		alloc_info.pNext = nullptr;
+		alloc_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+		alloc_info.descriptorPool = m_descriptor_pool;
+		alloc_info.descriptorSetCount = 1;
+		alloc_info.pSetLayouts = &m_shader_set_layout;
+
+		vkAllocateDescriptorSets(device, &alloc_info, &m_bindless_descriptor_set);
+
 		//allocate the descriptor set for texture to use on the material
 		//VkDescriptorSetAllocateInfo alloc_info = {};
 		//alloc_info.pNext = nullptr;
@@ -886,6 +1753,46 @@ namespace DoDo {
 		//vkUpdateDescriptorSets(device, 1, &texture1, 0, nullptr);
 	}
 
+	uint32_t FSlateVulkanRenderer::register_bindless_texture(VkImageView image_view)
+	{
+		uint32_t bindless_index = 0;
+
+		if(!m_free_bindless_indices.empty())
+		{
+			bindless_index = m_free_bindless_indices.back();
+			m_free_bindless_indices.pop_back();
+		}
+		else if(m_num_bindless_textures == SLATE_VULKAN_MAX_BINDLESS_TEXTURES)
+		{
+			LOGE("bindless texture array is full, increase SLATE_VULKAN_MAX_BINDLESS_TEXTURES\n");
+			return FSlateVulkanTexture::invalid_bindless_index;
+		}
+		else
+		{
+			bindless_index = m_num_bindless_textures++;
+		}
+
+		VkDescriptorImageInfo image_info;
+		image_info.sampler = m_sampler;
+		image_info.imageView = image_view;
+		image_info.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+
+		VkWriteDescriptorSet texture_write = write_descriptor_image(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, m_bindless_descriptor_set, &image_info, 1);
+		texture_write.dstArrayElement = bindless_index;
+
+		//the slot is unused by recorded command buffers, update after bind allows the write while they are in flight
+		VkDevice device = *(VkDevice*)m_logic_device->get_native_handle();
+		vkUpdateDescriptorSets(device, 1, &texture_write, 0, nullptr);
+
+		return bindless_index;
+	}
+
+	void FSlateVulkanRenderer::unregister_bindless_texture(uint32_t bindless_index)
+	{
+		//the descriptor keeps pointing to the destroyed view until the slot is written again, partially bound allows that while no draw reads it
+		m_free_bindless_indices.push_back(bindless_index);
+	}
+
 	VertexInputDescription FSlateVulkanRenderer::get_vertex_description()
 	{
 		VertexInputDescription description = {};
@@ -909,16 +1816,23 @@ namespace DoDo {
 		positionAttribute.format = VK_FORMAT_R32G32_SFLOAT;
 		positionAttribute.offset = offsetof(FSlateVertex, m_position);
 
+		//packed colors are fetched as normalized floats, so the shader input is vec4 for both layouts
+#if SLATE_USE_PACKED_VERTEX_COLOR
+		const VkFormat color_format = VK_FORMAT_R8G8B8A8_UNORM;
+#else
+		const VkFormat color_format = VK_FORMAT_R32G32B32A32_SFLOAT;
+#endif
+
 		VkVertexInputAttributeDescription colorAttribute = {};
 		colorAttribute.binding = 0;
 		colorAttribute.location = 2;
-		colorAttribute.format = VK_FORMAT_R32G32B32A32_SFLOAT;
+		colorAttribute.format = color_format;
 		colorAttribute.offset = offsetof(FSlateVertex, m_color);
 
 		VkVertexInputAttributeDescription color2Attribute = {};
 		color2Attribute.binding = 0;
 		color2Attribute.location = 3;
-		color2Attribute.format = VK_FORMAT_R32G32B32A32_SFLOAT;
+		color2Attribute.format = color_format;
 		color2Attribute.offset = offsetof(FSlateVertex, m_secondary_color);
 
 		description.attributes.push_back(texcoordAttribute);
@@ -928,6 +1842,157 @@ namespace DoDo {
 		return description;
 	}
 
+	VertexInputDescription FSlateVulkanRenderer::get_instanced_quad_description()
+	{
+		VertexInputDescription description = {};
+
+		//binding 0 is the vertex buffer, it is bound but not read by this pipeline
+		VkVertexInputBindingDescription instanceBinding = {};
+		instanceBinding.binding = 1;
+		instanceBinding.stride = sizeof(FSlateQuadInstance);
+		instanceBinding.inputRate = VK_VERTEX_INPUT_RATE_INSTANCE;
+
+		description.bindings.push_back(instanceBinding);
+
+		VkVertexInputAttributeDescription originAttribute = {};
+		originAttribute.binding = 1;
+		originAttribute.location = 0;
+		originAttribute.format = VK_FORMAT_R32G32_SFLOAT;
+		originAttribute.offset = offsetof(FSlateQuadInstance, m_origin);
+
+		VkVertexInputAttributeDescription axisXAttribute = {};
+		axisXAttribute.binding = 1;
+		axisXAttribute.location = 1;
+		axisXAttribute.format = VK_FORMAT_R32G32_SFLOAT;
+		axisXAttribute.offset = offsetof(FSlateQuadInstance, m_axis_x);
+
+		VkVertexInputAttributeDescription axisYAttribute = {};
+		axisYAttribute.binding = 1;
+		axisYAttribute.location = 2;
+		axisYAttribute.format = VK_FORMAT_R32G32_SFLOAT;
+		axisYAttribute.offset = offsetof(FSlateQuadInstance, m_axis_y);
+
+		VkVertexInputAttributeDescription uvRectAttribute = {};
+		uvRectAttribute.binding = 1;
+		uvRectAttribute.location = 3;
+		uvRectAttribute.format = VK_FORMAT_R16G16B16A16_UNORM;
+		uvRectAttribute.offset = offsetof(FSlateQuadInstance, m_uv_rect);
+
+#if SLATE_USE_PACKED_VERTEX_COLOR
+		const VkFormat color_format = VK_FORMAT_R8G8B8A8_UNORM;
+#else
+		const VkFormat color_format = VK_FORMAT_R32G32B32A32_SFLOAT;
+#endif
+
+		VkVertexInputAttributeDescription colorAttribute = {};
+		colorAttribute.binding = 1;
+		colorAttribute.location = 4;
+		colorAttribute.format = color_format;
+		colorAttribute.offset = offsetof(FSlateQuadInstance, m_color);
+
+		description.attributes.push_back(originAttribute);
+		description.attributes.push_back(axisXAttribute);
+		description.attributes.push_back(axisYAttribute);
+		description.attributes.push_back(uvRectAttribute);
+		description.attributes.push_back(colorAttribute);
+		return description;
+	}
+
+	bool FSlateVulkanRenderer::precompile_pipelines()
+	{
+		if (m_pipeline_state_object != nullptr)
+		{
+			return true;
+		}
+
+		const std::chrono::high_resolution_clock::time_point start_time = std::chrono::high_resolution_clock::now();
+
+		VkDevice device = *(VkDevice*)m_logic_device->get_native_handle();
+
+		VkPipelineCache pipeline_cache = m_pipeline_cache->get_handle();
+
+#ifdef Android
+		m_vertex_shader_module = Shader::Create("SlateDefaultVertexShader.spv", &device);
+		m_fragment_shader_module = Shader::Create("SlateElementPixelShader.spv", &device);
+#else
+		DoDoUtf8String vertex_shader_path = get_shader_path("SlateDefaultVertexShader.spv");
+		DoDoUtf8String fragment_shader_path = get_shader_path("SlateElementPixelShader.spv");
+		m_vertex_shader_module = Shader::Create(vertex_shader_path.c_str(), &device);
+		m_fragment_shader_module = Shader::Create(fragment_shader_path.c_str(), &device);
+#endif
+		m_pipeline_state_object = PipelineStateObject::Create(&device);
+
+		std::string target_point = "main";//todo:modify this to other string type
+
+		m_pipeline_state_object->set_vertex_shader(*m_vertex_shader_module, target_point);
+		m_pipeline_state_object->set_pixel_shader(*m_fragment_shader_module, target_point);
+		m_pipeline_state_object->set_render_pass(&m_render_pass);
+		VertexInputDescription input_description = get_vertex_description();
+		m_pipeline_state_object->set_input_vertex_layout(&input_description);//todo:get address
+		m_pipeline_state_object->set_descriptor_set(1, &m_shader_set_layout);//set descriptor set layout
+		m_pipeline_state_object->set_pipeline_cache(&pipeline_cache);
+		m_pipeline_state_object->finalize(&device);//todo:fix me
+
+		m_b_use_instanced_quads = create_instanced_quad_pipeline(device);
+
+		m_pipeline_creation_time = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start_time).count();
+
+		LOGI("slate pipelines: %.2f ms, %s\n", m_pipeline_creation_time, m_pipeline_cache->was_loaded_from_file() ? "from pipeline cache" : "pipeline cache was empty");
+
+		//the next launch finds the pipelines of this one in the cache
+		if (!m_pipeline_cache->save())
+		{
+			std::cout << "failed to write the pipeline cache" << std::endl;
+		}
+
+		return *(VkPipeline*)m_pipeline_state_object->get_native_handle() != VK_NULL_HANDLE;
+	}
+
+	bool FSlateVulkanRenderer::create_instanced_quad_pipeline(VkDevice device)
+	{
+#ifdef Android
+		m_instanced_quad_vertex_shader_module = Shader::Create("SlateInstancedQuadVertexShader.spv", &device);
+#else
+		DoDoUtf8String vertex_shader_path = get_shader_path("SlateInstancedQuadVertexShader.spv");
+
+		//the build compiles or copies the shader, a missing binary means there was neither a compiler nor a committed binary
+		if(!std::filesystem::exists(vertex_shader_path.c_str()))
+		{
+			LOGE("missing %s, boxes are drawn as vertices\n", vertex_shader_path.c_str());
+			return false;
+		}
+
+		m_instanced_quad_vertex_shader_module = Shader::Create(vertex_shader_path.c_str(), &device);
+#endif
+
+		m_instanced_quad_pipeline_state_object = PipelineStateObject::Create(&device);
+
+		std::string target_point = "main";
+
+		//same pixel shader, descriptor set layout and push constants as the vertex pipeline, so the pipeline layouts are compatible
+		m_instanced_quad_pipeline_state_object->set_vertex_shader(*m_instanced_quad_vertex_shader_module, target_point);
+		m_instanced_quad_pipeline_state_object->set_pixel_shader(*m_fragment_shader_module, target_point);
+		m_instanced_quad_pipeline_state_object->set_render_pass(&m_render_pass);
+		VertexInputDescription input_description = get_instanced_quad_description();
+		m_instanced_quad_pipeline_state_object->set_input_vertex_layout(&input_description);
+		m_instanced_quad_pipeline_state_object->set_descriptor_set(1, &m_shader_set_layout);
+		VkPipelineCache pipeline_cache = m_pipeline_cache->get_handle();
+		m_instanced_quad_pipeline_state_object->set_pipeline_cache(&pipeline_cache);
+		m_instanced_quad_pipeline_state_object->finalize(&device);
+
+		if(*static_cast<VkPipeline*>(m_instanced_quad_pipeline_state_object->get_native_handle()) == VK_NULL_HANDLE)
+		{
+			LOGE("failed to create the instanced quad pipeline, boxes are drawn as vertices\n");
+
+			m_instanced_quad_pipeline_state_object->Destroy(&device);
+			m_instanced_quad_pipeline_state_object.reset();
+			m_instanced_quad_vertex_shader_module->Destroy(&device);
+			return false;
+		}
+
+		return true;
+	}
+
 	void FSlateVulkanRenderer::immediate_submit(std::function<void(VkCommandBuffer cmd)>&& function)
 	{		
 		VkCommandBuffer cmd = m_upload_context.m_command_buffer;
@@ -1029,9 +2094,12 @@ namespace DoDo {
 		alloc_info.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
 		alloc_info.commandBufferCount = 1;
 
-		if (vkAllocateCommandBuffers(device, &alloc_info, &view_port.m_command_buffer) != VK_SUCCESS)
+		for(FSlateVulkanViewportFrame& frame : view_port.m_frames)
 		{
-			std::cout << "failed to allocate command buffers" << std::endl;
+			if (vkAllocateCommandBuffers(device, &alloc_info, &frame.m_command_buffer) != VK_SUCCESS)
+			{
+				std::cout << "failed to allocate command buffers" << std::endl;
+			}
 		}
 	}
 }
@@ -18,11 +18,52 @@
 
 #include <queue>
 #include <functional>
+#include <chrono>
+
+#include "Core/Misc/QueuedThreadPool.h"//FQueuedThreadPool depends on it
 
 #include <include/vk_mem_alloc.h>
 
 #include "Utils.h"//AllocatedBuffer depends on it
 
+#include "VulkanInitializers.h"//AllocatedImage depends on it
+
+#include "SlateVulkanUploadQueue.h"//unique_ptr needs it
+
+#include "VulkanPipelineCache.h"//unique_ptr needs it
+
+#include "SlateCore/Rendering/SlateDamageTracker.h"//FSlateDamageTracker depends on it
+
+/*
+ * number of frames the cpu may record ahead of the gpu, every frame owns its command buffers, sync objects and vertex buffers
+ * set from the build, see SLATE_VULKAN_FRAMES_IN_FLIGHT in the cmake lists
+ */
+#ifndef SLATE_VULKAN_FRAMES_IN_FLIGHT
+#define SLATE_VULKAN_FRAMES_IN_FLIGHT 2
+#endif
+
+static_assert(SLATE_VULKAN_FRAMES_IN_FLIGHT >= 1 && SLATE_VULKAN_FRAMES_IN_FLIGHT <= 3, "slate supports one to three frames in flight");
+
+/*
+ * wait for the gpu and sleep until just before the predicted vblank before the input of a frame is read
+ * only takes effect with fifo present modes, the swap chains then use their minimum image count
+ * set from the build, see SLATE_FRAME_PACING option in the cmake lists
+ */
+#ifndef SLATE_FRAME_PACING
+#define SLATE_FRAME_PACING 0
+#endif
+
+/*
+ * windows only redraw the parts that changed since their swap chain image was drawn, the rest of the image is kept
+ * set from the build, see SLATE_USE_DAMAGE_REDRAW option in the cmake lists
+ */
+#ifndef SLATE_USE_DAMAGE_REDRAW
+#define SLATE_USE_DAMAGE_REDRAW 1
+#endif
+
+/*size of the bindless texture array, must match element_textures in SlateElementPixelShader*/
+#define SLATE_VULKAN_MAX_BINDLESS_TEXTURES 4096
+
 namespace DoDo {
 
 	struct DeletionQueue
@@ -59,6 +100,80 @@ namespace DoDo {
 
 	class VulkanSwapChain;
 
+	/*
+	 * time from reading the input of a frame to the gpu finishing it, in milliseconds
+	 * the finish is seen when the renderer next checks the frame's fence, so the times are upper bounds
+	 * the image reaches the screen at the following vblank at the earliest
+	 */
+	struct FSlateFrameLatencyStats
+	{
+		double m_p50;
+
+		double m_p90;
+
+		double m_p99;
+
+		double m_max;
+
+		uint32_t m_num_samples;
+
+		/*present mode of the first window's swap chain*/
+		VkPresentModeKHR m_present_mode;
+
+		FSlateFrameLatencyStats()
+			: m_p50(0.0)
+			, m_p90(0.0)
+			, m_p99(0.0)
+			, m_max(0.0)
+			, m_num_samples(0)
+			, m_present_mode(VK_PRESENT_MODE_FIFO_KHR)
+		{}
+	};
+
+	/*gpu time of a window's render pass, in milliseconds*/
+	struct FSlateWindowGpuTimeStats
+	{
+		double m_last;
+
+		/*running average, recent frames weigh more*/
+		double m_average;
+
+		double m_max;
+
+		uint32_t m_num_samples;
+
+		FSlateWindowGpuTimeStats()
+			: m_last(0.0)
+			, m_average(0.0)
+			, m_max(0.0)
+			, m_num_samples(0)
+		{}
+	};
+
+	/*the resources of a window that belong to one frame in flight*/
+	struct FSlateVulkanViewportFrame
+	{
+		VkSemaphore m_present_semaphore;
+
+		VkSemaphore m_render_semaphore;
+
+		VkCommandBuffer m_command_buffer;
+
+		/*two timestamps around the window's render pass, VK_NULL_HANDLE if the queue can't write timestamps*/
+		VkQueryPool m_timestamp_query_pool;
+
+		/*the last submit of the frame wrote the timestamps and they weren't read yet*/
+		bool m_b_timestamps_pending;
+
+		FSlateVulkanViewportFrame()
+			: m_present_semaphore(VK_NULL_HANDLE)
+			, m_render_semaphore(VK_NULL_HANDLE)
+			, m_command_buffer(VK_NULL_HANDLE)
+			, m_timestamp_query_pool(VK_NULL_HANDLE)
+			, m_b_timestamps_pending(false)
+		{}
+	};
+
 	struct FSlateVulkanViewport
 	{
 		glm::mat4 m_projection_matrix;
@@ -71,20 +186,61 @@ namespace DoDo {
 
 		std::vector<VkFramebuffer> m_vulkan_framebuffer;//framebuffer connect the render pass and vk image(will be render to)
 
-		VkSemaphore m_present_semaphore;
+		/*one per frame in flight*/
+		std::vector<FSlateVulkanViewportFrame> m_frames;
 
-		VkSemaphore m_render_semaphore;
+		//todo:implement render target and render target view
 
-		VkFence m_fence;
+		bool m_b_full_screen;
 
-		VkCommandBuffer m_command_buffer;
+		/*
+		 * result of the last acquire or present of the window's swap chain
+		 * a window whose swap chain is out of date is skipped, the other windows keep drawing
+		 */
+		VkResult m_present_result;
 
-		//todo:implement render target and render target view
+		/*
+		 * offscreen view ports have no surface and swap chain, they render into m_offscreen_image
+		 * every draw copies the image to the readback buffer of the frame, see FSlateVulkanRenderer::read_back_view_port
+		 */
+		bool m_b_offscreen;
 
-		bool m_b_full_screen;
+		AllocatedImage m_offscreen_image;
+
+		VkImageView m_offscreen_image_view;
+
+		/*one per frame in flight, host visible*/
+		std::vector<AllocatedBuffer> m_readback_buffers;
+
+		uint32_t m_width;
+
+		uint32_t m_height;
+
+		/*frame number of the last draw, UINT64_MAX before the first*/
+		uint64_t m_last_drawn_frame;
+
+		/*read from the timestamps when the frame in flight comes around again*/
+		FSlateWindowGpuTimeStats m_gpu_time_stats;
+
+		/*compares the batches of every frame with the frame before*/
+		FSlateDamageTracker m_damage_tracker;
+
+		/*per swap chain image or the one offscreen image, the damage tracker's frame the image holds, UINT64_MAX before it was drawn*/
+		std::vector<uint64_t> m_image_damage_frames;
+
+		/*part of the window's pixels the last draw redrew, 1 for a full redraw*/
+		float m_redraw_fraction;
 
 		FSlateVulkanViewport()
 			: m_b_full_screen(false)
+			, m_present_result(VK_SUCCESS)
+			, m_b_offscreen(false)
+			, m_offscreen_image()
+			, m_offscreen_image_view(VK_NULL_HANDLE)
+			, m_width(0)
+			, m_height(0)
+			, m_last_drawn_frame(UINT64_MAX)
+			, m_redraw_fraction(1.0f)
 		{
 
 		}
@@ -119,8 +275,19 @@ namespace DoDo {
 
 		void create_view_port(const std::shared_ptr<SWindow> in_window) override;
 
+		/*the window needs no native window, so this works without a display, e.g. on a software vulkan driver*/
+		void create_offscreen_view_port(const std::shared_ptr<SWindow> in_window, uint32_t width, uint32_t height) override;
+
+		bool read_back_view_port(const SWindow* window, std::vector<uint8_t>& out_pixels, uint32_t& out_width, uint32_t& out_height) override;
+
+		bool save_view_port_png(const SWindow* window, const char* file_path) override;
+
 		void draw_windows(FSlateDrawBuffer& in_window_draw_buffer) override;
 
+		void wait_for_next_frame() override;
+
+		void invalidate_view_port(const SWindow* window) override;
+
 		virtual FSlateResourceHandle get_resource_handle(const FSlateBrush& brush, glm::vec2 local_size, float draw_scale) override;
 
 		bool initialize() override;
@@ -135,7 +302,67 @@ namespace DoDo {
 		void immediate_submit(std::function<void(VkCommandBuffer cmd)>&& function);
 
 		AllocatedBuffer create_buffer(size_t allocated_size, VkBufferUsageFlags usage, VmaMemoryUsage memoryUsage);
+
+		/*
+		 * writes the image view to the next free slot of the bindless texture array
+		 * @return the slot, the pixel shader reads it from the push constants, FSlateVulkanTexture::invalid_bindless_index if the array is full
+		 */
+		uint32_t register_bindless_texture(VkImageView image_view);
+
+		/*
+		 * frees the slot for the next registered texture
+		 * no command buffer in flight may read the slot anymore
+		 */
+		void unregister_bindless_texture(uint32_t bindless_index);
+
+		/*cpu time of FSlateElementBatcher::add_elements for each window element list of the last draw_windows, in milliseconds*/
+		const std::vector<double>& get_window_batching_times() const { return m_window_batching_times; }
+
+		uint32_t get_num_frames_in_flight() const { return m_num_frames_in_flight; }
+
+		/*
+		 * @return VK_SUCCESS, VK_SUBOPTIMAL_KHR or the error of the last acquire or present of the window, VK_ERROR_UNKNOWN if it has no view port
+		 */
+		VkResult get_present_result(const SWindow* window) const;
+
+		/*cpu time the last draw_windows waited for the gpu to release the frame's resources, in milliseconds*/
+		double get_fence_wait_time() const { return m_fence_wait_time; }
+
+		/*
+		 * creates every pipeline variant the renderer draws with, called by initialize
+		 * the pipelines are compiled through the pipeline cache, the cache file is written when the driver compiled new ones
+		 *
+		 * @return false if the default pipeline couldn't be created
+		 */
+		bool precompile_pipelines();
+
+		/*cpu time of precompile_pipelines, in milliseconds*/
+		double get_pipeline_creation_time() const { return m_pipeline_creation_time; }
+
+		/*percentiles over the last frames*/
+		FSlateFrameLatencyStats get_frame_latency_stats() const;
+
+		/*false if the graphics queue has no valid timestamp bits, e.g. on some software drivers, the gpu times stay 0 then*/
+		bool is_gpu_timing_supported() const { return m_timestamp_period > 0.0; }
+
+		/*gpu time of the window's render pass, the frame in flight before the last draw_windows is the newest sample*/
+		FSlateWindowGpuTimeStats get_window_gpu_time_stats(const SWindow* window) const;
+
+		/*part of the window the last draw_windows redrew, below 1 when only the damage was drawn, 0 if nothing changed*/
+		float get_window_redraw_fraction(const SWindow* window) const;
 	private:
+		/*stores the latency of the frame in flight if it has one pending, its fence must be signaled*/
+		void record_frame_latency(uint32_t frame_index);
+
+		/*sleeps until the input must be read to have the frame ready for the predicted vblank*/
+		void sleep_until_frame_deadline();
+
+		/*@return the swap chain of the first window with one, nullptr if all view ports are offscreen*/
+		const VulkanSwapChain* get_first_swap_chain() const;
+
+		/*batches all window element lists in parallel, one batcher per list*/
+		void batch_window_element_lists(const std::vector<std::shared_ptr<FSlateWindowElementList>>& window_element_lists);
+
 		void private_create_view_port(std::shared_ptr<SWindow> in_window, glm::vec2& window_size);
 
 		void pick_physical_device();
@@ -148,6 +375,18 @@ namespace DoDo {
 
 		void create_sync_objects_for_immediate_upload(VkDevice device);
 
+		/*one fence per frame in flight, signaled by the submit of all windows of the frame*/
+		void create_frame_fences(VkDevice device);
+
+		/*reads the timestamp period and the valid bits of the graphics queue, gpu timing stays off without them*/
+		void init_timestamp_queries();
+
+		/*a query pool of two timestamps per frame in flight*/
+		void create_timestamp_query_pools(FSlateVulkanViewport& view_port);
+
+		/*reads the timestamps the frame's last submit wrote, its fence must be signaled, so this doesn't wait*/
+		void read_back_gpu_times(VkDevice device, uint32_t frame_index);
+
 		void create_command_pool();
 
 		void create_command_buffer(FSlateVulkanViewport& view_port);
@@ -159,16 +398,31 @@ namespace DoDo {
 		void init_descriptors();
 
 		VertexInputDescription get_vertex_description(); //todo:move this function to other place
+
+		/*per instance FSlateQuadInstance at binding 1, see SlateInstancedQuadVertexShader*/
+		VertexInputDescription get_instanced_quad_description();
+
+		/*creates the pipeline for FSlateQuadInstance, @return false if the shader is missing or the pipeline failed, the error is logged*/
+		bool create_instanced_quad_pipeline(VkDevice device);
 	private:
 		bool m_b_has_attempted_initialization;
 
+		/*the instance and the device were created, false without a vulkan driver or gpu*/
+		bool m_b_initialized;
+
 		glm::mat4 m_view_matrix;
 
 		std::map<const SWindow*, FSlateVulkanViewport> m_window_to_viewport_map;
 
 		FSlateDrawBuffer m_draw_buffer;
 
-		std::unique_ptr<FSlateElementBatcher> m_element_batcher;
+		/*one batcher per window element list, so the lists can be batched in parallel*/
+		std::vector<std::unique_ptr<FSlateElementBatcher>> m_element_batchers;
+
+		/*workers for batching the window element lists, the texture manager decodes images on them too*/
+		std::unique_ptr<FQueuedThreadPool> m_batching_thread_pool;
+
+		std::vector<double> m_window_batching_times;
 		std::shared_ptr<FSlateVulkanRenderingPolicy> m_rendering_policy;
 		std::shared_ptr<FSlateVulkanTextureManager> m_texture_manager;
 
@@ -188,17 +442,67 @@ namespace DoDo {
 
 		std::shared_ptr<Device> m_logic_device;//logic device
 
-		VkFence m_render_fence;//renderer fence
+		/*one per frame in flight, the command buffers of all windows are submitted together with it*/
+		std::vector<VkFence> m_frame_fences;
 
 		VkSemaphore m_present_semaphore;
 		VkSemaphore m_render_semaphore;
 
 		VkRenderPass m_render_pass;
 
+		/*same attachment as m_render_pass, so the pipelines are compatible, but ends in transfer source layout for the readback*/
+		VkRenderPass m_offscreen_render_pass;
+
+		/*same attachment as m_render_pass but loads the image, for redrawing the damage of a presented swap chain image*/
+		VkRenderPass m_load_render_pass;
+
+		/*m_offscreen_render_pass loading the image, for redrawing the damage of an offscreen view port*/
+		VkRenderPass m_offscreen_load_render_pass;
+
+		/*damage rects of the window being drawn, kept between windows to keep their memory*/
+		std::vector<FSlateRect> m_damage_rects;
+
 		VkCommandPool m_command_pool;
 
 		uint64_t m_frame_number;
 
+		uint32_t m_num_frames_in_flight;
+
+		double m_fence_wait_time;
+
+		/*nanoseconds per timestamp tick, 0 if the graphics queue has no timestamps*/
+		double m_timestamp_period;
+
+		/*the valid bits of a timestamp, the counter wraps around above them*/
+		uint64_t m_timestamp_mask;
+
+		/*when the input of the frame being built was read, set by wait_for_next_frame*/
+		std::chrono::high_resolution_clock::time_point m_frame_start_time;
+
+		bool m_b_frame_started;
+
+		/*input time of the frame each frame in flight was last submitted with*/
+		std::vector<std::chrono::high_resolution_clock::time_point> m_frame_input_times;
+
+		/*true while the frame in flight's latency isn't recorded yet*/
+		std::vector<bool> m_frame_latency_pending;
+
+		/*ring of the last frame latencies, in milliseconds*/
+		std::vector<double> m_frame_latencies;
+
+		uint32_t m_num_frame_latencies;
+
+		/*when the first acquire of the last frame returned, fifo releases images at vblank*/
+		std::chrono::high_resolution_clock::time_point m_last_acquire_time;
+
+		/*rings of the last frames for predicting the vblank, in milliseconds*/
+		std::vector<double> m_acquire_intervals;
+
+		/*from reading the input to the first acquire*/
+		std::vector<double> m_frame_work_times;
+
+		uint32_t m_num_pacing_samples;
+
 		VmaAllocator m_allocator;
 
 		std::unique_ptr<PipelineStateObject> m_pipeline_state_object;
@@ -208,12 +512,35 @@ namespace DoDo {
 
 		Scope<Shader> m_fragment_shader_module;
 
+		/*instanced quads, only created when the compiled shader is shipped*/
+		std::unique_ptr<PipelineStateObject> m_instanced_quad_pipeline_state_object;
+
+		Scope<Shader> m_instanced_quad_vertex_shader_module;
+
+		bool m_b_use_instanced_quads;
+
 		VkDescriptorSetLayout m_shader_set_layout;
 		VkDescriptorPool m_descriptor_pool;
 		//VkDescriptorSet m_descriptor_set;
 		VkSampler m_sampler;
 
+		/*all textures in one update after bind array, bound once per window*/
+		VkDescriptorSet m_bindless_descriptor_set;
+
+		uint32_t m_num_bindless_textures;
+
+		/*slots of released textures, reused before the array grows*/
+		std::vector<uint32_t> m_free_bindless_indices;
+
 		UploadContext m_upload_context;
+
+		/*texture uploads, batched and finished asynchronously*/
+		std::unique_ptr<FSlateVulkanUploadQueue> m_upload_queue;
+
+		/*pipeline cache of the engine directory, survives launches*/
+		std::unique_ptr<FVulkanPipelineCache> m_pipeline_cache;
+
+		double m_pipeline_creation_time;
 	};
 
 }
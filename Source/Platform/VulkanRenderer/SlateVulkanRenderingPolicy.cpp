@@ -16,38 +16,26 @@
 
 namespace DoDo
 {
-	FSlateVulkanRenderingPolicy::FSlateVulkanRenderingPolicy(VmaAllocator& allocator, std::shared_ptr<FSlateVulkanTextureManager> in_texture_manager)
+	FSlateVulkanRenderingPolicy::FSlateVulkanRenderingPolicy(VmaAllocator& allocator, std::shared_ptr<FSlateVulkanTextureManager> in_texture_manager, uint32_t in_num_frames_in_flight)
 	{
 		m_deletion_queue = std::make_shared<DeletionQueue>();
 
-		m_vertex_buffer.create_buffer(allocator, sizeof(FSlateVertex));
-		m_index_buffer.create_buffer(allocator);
+		for(uint32_t frame_index = 0; frame_index < in_num_frames_in_flight; ++frame_index)
+		{
+			std::unique_ptr<FSlateVulkanFrameBuffers> frame_buffers = std::make_unique<FSlateVulkanFrameBuffers>();
+			frame_buffers->m_vertex_buffer.create_buffer(allocator, sizeof(FSlateVertex));
+			frame_buffers->m_index_buffer.create_buffer(allocator);
+			frame_buffers->m_instance_buffer.create_buffer(allocator, sizeof(FSlateQuadInstance));
+			m_frame_buffers.push_back(std::move(frame_buffers));
+		}
+		m_current_frame_index = 0;
+		m_current_frame_number = 0;
 		m_last_vertex_buffer_offset = 0;
 		m_last_index_buffer_offset = 0;
+		m_last_instance_buffer_offset = 0;
 
 		//m_shader_resource = nullptr;
 
-		//------create descriptor set------
-		//------descriptor set------
-		m_descriptor_sets.resize(1000);
-		Renderer* renderer = Application::get().get_renderer();
-		FSlateVulkanRenderer* vulkan_renderer = (FSlateVulkanRenderer*)(renderer);
-		std::vector<VkDescriptorSetLayout> layouts(1000, vulkan_renderer->m_shader_set_layout);
-		//VkDescriptorSet image_descriptor_set;
-		//allocate the descriptor set for texture to use on the material
-		VkDescriptorSetAllocateInfo alloc_info = {};
-		alloc_info.pNext = nullptr;
-		alloc_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-		alloc_info.descriptorPool = vulkan_renderer->m_descriptor_pool;
-		alloc_info.descriptorSetCount = 1000;//1000(todo:fix me)
-		alloc_info.pSetLayouts = layouts.data();//todo:fix me, not to access private member
-		VkDevice device = *(VkDevice*)(vulkan_renderer->m_logic_device->get_native_handle());
-		vkAllocateDescriptorSets(device, &alloc_info, m_descriptor_sets.data());
-		
-		//texture->set_descriptor_set(image_descriptor_set);
-		//------descriptor set------
-		//------create descriptor set------
-
 		//todo:create white texture
 		m_white_texture = in_texture_manager->create_color_texture("DefaultWhite", glm::vec4(1.0f, 1.0f, 1.0f, 1.0f))->m_resource;
 	}
@@ -65,152 +53,193 @@ namespace DoDo
 	{
 		m_deletion_queue->flush();//flush
 
-		m_vertex_buffer.destroy_buffer(allocator);
-		m_index_buffer.destroy_buffer(allocator);
+		for(std::unique_ptr<FSlateVulkanFrameBuffers>& frame_buffers : m_frame_buffers)
+		{
+			frame_buffers->m_vertex_buffer.destroy_buffer(allocator);
+			frame_buffers->m_index_buffer.destroy_buffer(allocator);
+			frame_buffers->m_instance_buffer.destroy_buffer(allocator);
+
+			for(const AllocatedBuffer& retired_buffer : frame_buffers->m_retired_buffers)
+			{
+				vmaDestroyBuffer(allocator, retired_buffer.m_buffer, retired_buffer.m_allocation);
+			}
+			frame_buffers->m_retired_buffers.clear();
+		}
 	}
 
-	void FSlateVulkanRenderingPolicy::reset_offset()
+	void FSlateVulkanRenderingPolicy::begin_frame(VmaAllocator& allocator, uint32_t frame_index, uint64_t frame_number)
 	{
-		m_last_index_buffer_offset = m_last_vertex_buffer_offset = 0;
+		m_current_frame_index = frame_index;
+		m_current_frame_number = frame_number;
+
+		//the fence of the frame was waited for, nothing reads the buffers it replaced anymore
+		FSlateVulkanFrameBuffers& frame_buffers = *m_frame_buffers[m_current_frame_index];
+		for(const AllocatedBuffer& retired_buffer : frame_buffers.m_retired_buffers)
+		{
+			vmaDestroyBuffer(allocator, retired_buffer.m_buffer, retired_buffer.m_allocation);
+		}
+		frame_buffers.m_retired_buffers.clear();
+
+		m_last_index_buffer_offset = m_last_vertex_buffer_offset = m_last_instance_buffer_offset = 0;
 	}
 
-	void FSlateVulkanRenderingPolicy::draw_elements(VkDevice device, VkCommandBuffer cmd_buffer, VkPipelineLayout pipeline_layout, VkSampler sampler, const glm::mat4x4& view_projection_matrix, int32_t first_batch_index,
-	                                                const std::vector<FSlateRenderBatch>& render_batches, uint32_t total_vertex_offset, uint32_t total_index_offset)
+	bool FSlateVulkanRenderingPolicy::draw_elements(VkCommandBuffer cmd_buffer, VkPipeline pipeline, VkPipeline instanced_quad_pipeline, VkPipelineLayout pipeline_layout, VkDescriptorSet bindless_descriptor_set, const glm::mat4x4& view_projection_matrix,
+	                                                const FSlateBatchData& batch_data)
 	{
+		const std::vector<FSlateRenderBatch>& render_batches = batch_data.get_render_batches();
+
+		FSlateVulkanFrameBuffers& frame_buffers = *m_frame_buffers[m_current_frame_index];
+
 		//todo:check vertex buffer and index buffer valid
-		if(m_vertex_buffer.m_buffer.m_buffer == VK_NULL_HANDLE ||
-			m_index_buffer.m_buffer.m_buffer == VK_NULL_HANDLE)
+		if(frame_buffers.m_vertex_buffer.m_buffer.m_buffer == VK_NULL_HANDLE ||
+			frame_buffers.m_index_buffer.m_buffer.m_buffer == VK_NULL_HANDLE)
 		{
-			return;
+			return true;
 		}
 
 		//bind index buffer
 		//get index offset and draw
-		vkCmdBindIndexBuffer(cmd_buffer, m_index_buffer.m_buffer.m_buffer, 0, VkIndexType::VK_INDEX_TYPE_UINT16);
+		constexpr VkIndexType index_type = sizeof(SlateIndex) == sizeof(uint32_t) ? VkIndexType::VK_INDEX_TYPE_UINT32 : VkIndexType::VK_INDEX_TYPE_UINT16;
+		vkCmdBindIndexBuffer(cmd_buffer, frame_buffers.m_index_buffer.m_buffer.m_buffer, 0, index_type);
+
+		//bind vertex buffer once for the whole window, every batch selects its vertices with the vertex offset of the draw
+		//instances use binding 1, so switching between the pipelines doesn't rebind buffers
+		const VkBuffer vertex_buffers[2] = { frame_buffers.m_vertex_buffer.m_buffer.m_buffer, frame_buffers.m_instance_buffer.m_buffer.m_buffer };
+		const VkDeviceSize vertex_buffer_offsets[2] = { 0, 0 };
+		vkCmdBindVertexBuffers(cmd_buffer, 0, 2, vertex_buffers, vertex_buffer_offsets);
 
-		//set view projection
+		//note:total offsets are bytes from the window element lists drawn before this one
+		const int32_t base_vertex_offset = batch_data.get_total_vertex_offset() / sizeof(FSlateVertex);
+		const uint32_t base_index_offset = batch_data.get_total_index_offset() / sizeof(SlateIndex);
+		const uint32_t base_instance_offset = batch_data.get_total_instance_offset() / sizeof(FSlateQuadInstance);
 
-		uint32_t descriptor_set_offset = 0;
-		int32_t next_render_batch_index = first_batch_index;
+		//set view projection, both pipelines share the layout, so push constants and the descriptor set survive pipeline switches
+		vkCmdPushConstants(cmd_buffer, pipeline_layout, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(glm::mat4), &view_projection_matrix);
+
+		//every texture lives in the bindless array
+		vkCmdBindDescriptorSets(cmd_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline_layout, 0, 1, &bindless_descriptor_set, 0, nullptr);
+
+		VkPipeline bound_pipeline = VK_NULL_HANDLE;
+
+		const uint32_t white_texture_index = ((FSlateVulkanTexture*)m_white_texture)->get_bindless_index();
+
+		uint32_t pushed_texture_index = UINT32_MAX;
+
+		bool b_drew_all_batches = true;
+
+		int32_t next_render_batch_index = batch_data.get_first_render_batch_index();
 		while (next_render_batch_index != -1)//magic number
 		{
 			const FSlateRenderBatch& render_batch = render_batches[next_render_batch_index];
 
 			next_render_batch_index = render_batch.m_next_batch_index;
 
-			const FSlateShaderResource* shader_resource = render_batch.get_shader_resource();//todo:shader resource is image view
+			FSlateVulkanTexture* batch_texture = (FSlateVulkanTexture*)render_batch.get_shader_resource();//todo:shader resource is image view
 
-			//todo:get render batch information to bind
-			if (shader_resource != nullptr)
-			{			
-				//m_shader_resource = const_cast<FSlateShaderResource*>(shader_resource);
-				//------update descriptor set------
-				VkDescriptorImageInfo imageBufferInfo;
-				imageBufferInfo.sampler = sampler;
-				imageBufferInfo.imageView = ((FSlateVulkanTexture*)shader_resource)->get_typed_resource();//get the image view
-				imageBufferInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+			if(batch_texture != nullptr)
+			{
+				//the image was released or is uploaded again, the batch is drawn once it is back
+				if(!batch_texture->is_resident())
+				{
+					b_drew_all_batches = false;
+					continue;
+				}
+			}
 
-				VkWriteDescriptorSet texture1 = write_descriptor_image(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, m_descriptor_sets[descriptor_set_offset], &imageBufferInfo, 1);
+			const VkPipeline batch_pipeline = render_batch.is_instanced() ? instanced_quad_pipeline : pipeline;
+			if(batch_pipeline != bound_pipeline)
+			{
+				vkCmdBindPipeline(cmd_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, batch_pipeline);
+				bound_pipeline = batch_pipeline;
+			}
 
-				vkUpdateDescriptorSets(device, 1, &texture1, 0, nullptr);
-				//------update descriptor set------
+			const uint32_t texture_index = batch_texture != nullptr ? batch_texture->get_bindless_index() : white_texture_index;
 
-				//texture descriptor
-				vkCmdBindDescriptorSets(cmd_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline_layout, 0, 1, &m_descriptor_sets[descriptor_set_offset], 0, nullptr);
+			//the texture index follows the view projection matrix in the push constants
+			if(texture_index != pushed_texture_index)
+			{
+				vkCmdPushConstants(cmd_buffer, pipeline_layout, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, sizeof(glm::mat4), sizeof(uint32_t), &texture_index);
+				pushed_texture_index = texture_index;
+			}
+
+			if(render_batch.is_instanced())
+			{
+				//six vertices of two triangles per quad, the vertex shader picks the corner from the vertex index
+				vkCmdDraw(cmd_buffer, 6, render_batch.m_num_instances, 0, render_batch.m_instance_offset + base_instance_offset);
 			}
 			else
 			{
-				VkDescriptorImageInfo imageBufferInfo;
-				imageBufferInfo.sampler = sampler;
-				imageBufferInfo.imageView = ((FSlateVulkanTexture*)m_white_texture)->get_typed_resource();//get the image view
-				imageBufferInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-
-				VkWriteDescriptorSet texture1 = write_descriptor_image(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, m_descriptor_sets[999], &imageBufferInfo, 1);
-
-				vkUpdateDescriptorSets(device, 1, &texture1, 0, nullptr);
-				//todo:add default texture
-				vkCmdBindDescriptorSets(cmd_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline_layout, 0, 1, &m_descriptor_sets[999], 0, nullptr);
+				//note:index offset and vertex offset are number, indices of a batch are local to its first vertex
+				vkCmdDrawIndexed(cmd_buffer, render_batch.m_num_indices, 1, render_batch.m_index_offset + base_index_offset, render_batch.m_vertex_offset + base_vertex_offset, 0);
 			}
+		}
 
-			const uint32_t offset = render_batch.m_vertex_offset * sizeof(FSlateVertex) + total_vertex_offset;
-
-			VkDeviceSize vertex_buffer_offset = offset;
+		return b_drew_all_batches;
+	}
 
-			//push constants
-			vkCmdPushConstants(cmd_buffer, pipeline_layout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(glm::mat4), &view_projection_matrix);
+	void FSlateVulkanRenderingPolicy::build_rendering_buffers(VmaAllocator& allocator, FSlateBatchData& in_batch_data)
+	{
+		//sort and merge the render batches, this only computes the final counts and offsets
+		in_batch_data.merge_render_batches();
 
-			//note:this vertex offset is bytes
-			//bind vertex buffer from offset
-			vkCmdBindVertexBuffers(cmd_buffer, 0, 1, &m_vertex_buffer.m_buffer.m_buffer, &vertex_buffer_offset);
+		//textures of a window that has no damage are still on screen, mark them before the draw may be skipped
+		const std::vector<FSlateRenderBatch>& render_batches = in_batch_data.get_render_batches();
+		int32_t next_render_batch_index = in_batch_data.get_first_render_batch_index();
+		while (next_render_batch_index != -1)//magic number
+		{
+			const FSlateRenderBatch& render_batch = render_batches[next_render_batch_index];
 
-			//note:this index buffer offset is number
-			vkCmdDrawIndexed(cmd_buffer, render_batch.m_num_indices, 1, render_batch.m_index_offset + total_index_offset / sizeof(uint16_t), 0, 0);
+			next_render_batch_index = render_batch.m_next_batch_index;
 
-			++descriptor_set_offset;
+			if (FSlateVulkanTexture* batch_texture = (FSlateVulkanTexture*)render_batch.get_shader_resource())
+			{
+				batch_texture->mark_used(m_current_frame_number);
+			}
 		}
-	}
 
-	void FSlateVulkanRenderingPolicy::build_rendering_buffers(VmaAllocator& allocator, FSlateBatchData& in_batch_data)
-	{
-		//todo:implement merge rendering batches for FSlateBatchData, this function will sort render batch and get the next batch index
-		in_batch_data.merge_render_batches();
-		//todo:implement interms of current size to resize
-		//m_deletion_queue->flush();//todo:remove this
+		FSlateVulkanFrameBuffers& frame_buffers = *m_frame_buffers[m_current_frame_index];
 
 		in_batch_data.set_total_vertex_offset(m_last_vertex_buffer_offset);
 		in_batch_data.set_total_index_offset(m_last_index_buffer_offset);
+		in_batch_data.set_total_instance_offset(m_last_instance_buffer_offset);
 
 		if(!in_batch_data.get_render_batches().empty())
 		{
-			//todo:get the batch data bached data to generate buffer
+			const uint32_t num_vertex_bytes = in_batch_data.get_num_final_vertices() * sizeof(FSlateVertex);
+			const uint32_t num_index_bytes = in_batch_data.get_num_final_indices() * sizeof(SlateIndex);
+			const uint32_t num_instance_bytes = in_batch_data.get_num_final_instances() * sizeof(FSlateQuadInstance);
 
-			const FSlateVertexArray& final_vertex_data = in_batch_data.get_final_vertex_data();
-			const FSlateIndexArray& final_index_data = in_batch_data.get_final_index_data();
-
-			if (!final_vertex_data.empty())
+			//resize if needed, with extra 1/4 space, offsets and sizes are bytes
+			if (num_vertex_bytes + m_last_vertex_buffer_offset > frame_buffers.m_vertex_buffer.get_buffer_size())
 			{
-				const uint32_t num_vertices = final_vertex_data.size();
-
-				//resize if needed
-				if (num_vertices * sizeof(FSlateVertex) + m_last_vertex_buffer_offset > m_vertex_buffer.get_buffer_size())
-				{
-					uint32_t num_bytes_needed = (num_vertices + m_last_vertex_buffer_offset) * sizeof(FSlateVertex);
-					m_vertex_buffer.resize_buffer(allocator, num_bytes_needed + (num_vertices / 4) * sizeof(FSlateVertex));// extra 1/4 space
-				}
+				frame_buffers.m_vertex_buffer.resize_buffer(allocator, m_last_vertex_buffer_offset + num_vertex_bytes + num_vertex_bytes / 4, frame_buffers.m_retired_buffers);
 			}
 
-			if (!final_index_data.empty())
+			const uint32_t num_indices = in_batch_data.get_num_final_indices();
+			const uint32_t last_index = m_last_index_buffer_offset / sizeof(SlateIndex);
+			if (num_indices + last_index > frame_buffers.m_index_buffer.get_max_num_indices())
 			{
-				const uint32_t num_indices = final_index_data.size();
-
-				const uint32_t last_offset = m_last_index_buffer_offset / sizeof(uint16_t);
-
-				if (num_indices + last_offset > m_index_buffer.get_max_num_indices())
-				{
-					m_index_buffer.resize_buffer(allocator, num_indices + last_offset + (num_indices / 4));
-				}
+				frame_buffers.m_index_buffer.resize_buffer(allocator, num_indices + last_index + (num_indices / 4), frame_buffers.m_retired_buffers);
 			}
 
-			//map and copy
-			uint8_t* vertices_ptr = nullptr;
-			uint8_t* indices_ptr = nullptr;
+			if (num_instance_bytes + m_last_instance_buffer_offset > frame_buffers.m_instance_buffer.get_buffer_size())
 			{
-				vertices_ptr = (uint8_t*)m_vertex_buffer.lock(allocator, m_last_vertex_buffer_offset);
-				indices_ptr = (uint8_t*)m_index_buffer.lock(allocator, m_last_index_buffer_offset);
+				frame_buffers.m_instance_buffer.resize_buffer(allocator, m_last_instance_buffer_offset + num_instance_bytes + num_instance_bytes / 4, frame_buffers.m_retired_buffers);
 			}
 
-			std::memcpy(vertices_ptr, final_vertex_data.data(), final_vertex_data.size() * sizeof(FSlateVertex));
-			std::memcpy(indices_ptr, final_index_data.data(), final_index_data.size() * sizeof(uint16_t));
-
-			m_vertex_buffer.unlock(allocator);
-			m_index_buffer.unlock(allocator);
-
-			m_last_vertex_buffer_offset += final_vertex_data.size() * sizeof(FSlateVertex);
-			m_last_index_buffer_offset += final_index_data.size() * sizeof(uint16_t);
+			//the buffers stay mapped, the merged batches are written straight into them
+			in_batch_data.copy_final_data(
+				(FSlateVertex*)frame_buffers.m_vertex_buffer.get_mapped_data(m_last_vertex_buffer_offset),
+				(SlateIndex*)frame_buffers.m_index_buffer.get_mapped_data(m_last_index_buffer_offset),
+				(FSlateQuadInstance*)frame_buffers.m_instance_buffer.get_mapped_data(m_last_instance_buffer_offset));
 
+			frame_buffers.m_vertex_buffer.flush(allocator, m_last_vertex_buffer_offset, num_vertex_bytes);
+			frame_buffers.m_index_buffer.flush(allocator, m_last_index_buffer_offset, num_index_bytes);
+			frame_buffers.m_instance_buffer.flush(allocator, m_last_instance_buffer_offset, num_instance_bytes);
 
-			//upload buffer to vulkan memory
-			//upload_mesh(allocator, vertex_array, index_array);
+			m_last_vertex_buffer_offset += num_vertex_bytes;
+			m_last_index_buffer_offset += num_index_bytes;
+			m_last_instance_buffer_offset += num_instance_bytes;
 		}
 	}
 
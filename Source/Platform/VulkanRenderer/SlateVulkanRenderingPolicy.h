@@ -18,22 +18,55 @@ namespace DoDo
 	//class FSlateIndexArray;
 	class FSlateBatchData;
 	class FSlateShaderResource;
+
+	/*buffers written by one frame in flight, they are only reused after the gpu finished that frame*/
+	struct FSlateVulkanFrameBuffers
+	{
+		FSlateVulkanVertexBuffer m_vertex_buffer;
+
+		FSlateVulkanIndexBuffer m_index_buffer;
+
+		/*FSlateQuadInstance of all windows, bound at binding 1*/
+		FSlateVulkanVertexBuffer m_instance_buffer;
+
+		/*buffers replaced by a resize while the frame was recorded, destroyed when the frame is begun again after its fence*/
+		std::vector<AllocatedBuffer> m_retired_buffers;
+	};
+
 	class FSlateVulkanRenderingPolicy : public FSlateRenderingPolicy
 	{
 	public:
-		FSlateVulkanRenderingPolicy(VmaAllocator& allocator, std::shared_ptr<FSlateVulkanTextureManager> in_texture_manager);
+		FSlateVulkanRenderingPolicy(VmaAllocator& allocator, std::shared_ptr<FSlateVulkanTextureManager> in_texture_manager, uint32_t in_num_frames_in_flight);
 
 		~FSlateVulkanRenderingPolicy();
 
 		void clear_vulkan_buffer(VmaAllocator& allocator);
 
-		void reset_offset();
-
+		/*
+		 * selects the buffers of the frame in flight, the gpu must be done with that frame
+		 * all window element lists of the frame are appended to these buffers, buffers the frame retired the last time are destroyed
+		 *
+		 * @param frame_number textures drawn in the frame are marked used with it
+		 */
+		void begin_frame(VmaAllocator& allocator, uint32_t frame_index, uint64_t frame_number);
+
+		/*
+		 * merges the batches of a window and appends them to the buffers of the frame
+		 * textures of the merged batches are marked used here, a window without damage is not drawn but still shows them
+		 */
 		void build_rendering_buffers(VmaAllocator& allocator, FSlateBatchData& in_batch_data);
 
 		//void upload_mesh(VmaAllocator& allocator, const FSlateVertexArray& vertex_array, const FSlateIndexArray& index_array);
 
-		void draw_elements(VkDevice device, VkCommandBuffer cmd_buffer, VkPipelineLayout pipeline_layout, VkSampler sampler,const glm::mat4x4& view_projection_matrix, int32_t first_batch_index, const std::vector<FSlateRenderBatch>& render_batches, uint32_t total_vertex_offset, uint32_t total_index_offset);
+		/*
+		 * draws the merged batches of a window, instanced batches switch to the instanced quad pipeline
+		 * both pipelines must be created with the same pipeline layout
+		 * textures are selected with their bindless index, the descriptor set is bound once
+		 * batches of textures that aren't resident are skipped, build_rendering_buffers marked them used, so the texture manager loads them again
+		 *
+		 * @return false if a batch was skipped
+		 */
+		bool draw_elements(VkCommandBuffer cmd_buffer, VkPipeline pipeline, VkPipeline instanced_quad_pipeline, VkPipelineLayout pipeline_layout, VkDescriptorSet bindless_descriptor_set, const glm::mat4x4& view_projection_matrix, const FSlateBatchData& batch_data);
 	private:
 		//template<typename T>
 		//void upload_mesh_internal(VmaAllocator& allocator, const T& array);
@@ -42,9 +75,14 @@ namespace DoDo
 
 		uint32_t m_last_index_buffer_offset;
 
-		FSlateVulkanVertexBuffer m_vertex_buffer;
+		uint32_t m_last_instance_buffer_offset;
 
-		FSlateVulkanIndexBuffer m_index_buffer;
+		/*one per frame in flight*/
+		std::vector<std::unique_ptr<FSlateVulkanFrameBuffers>> m_frame_buffers;
+
+		uint32_t m_current_frame_index;
+
+		uint64_t m_current_frame_number;
 
 		std::shared_ptr<DeletionQueue> m_deletion_queue;
 
@@ -52,8 +90,6 @@ namespace DoDo
 
 		FSlateShaderResource* m_white_texture;//don't have life time
 
-		std::vector<VkDescriptorSet> m_descriptor_sets;
-
 		std::shared_ptr<FSlateVulkanTextureManager> m_texture_manager;
 	};
 }
@@ -22,9 +22,14 @@
 
 #include "SlateCore/Styling/SlateStyleRegistry.h"
 
+#include <chrono>//loading stats depend on it
+
 namespace DoDo {
 
 	FSlateVulkanTextureManager::FSlateVulkanTextureManager()
+		: m_atlas_page_size(1024)
+		, m_max_atlased_texture_size(256)
+		, m_current_frame_number(0)
 	{
 		//std::vector<const FSlateBrush*> resources;
 
@@ -41,6 +46,8 @@ namespace DoDo {
 		FSlateStyleRegistry::get_all_resources(resources);
 
 		create_textures(resources);
+
+		LOGI("slate textures: %u loaded, %u from cache, decode %.2f ms, upload %.2f ms\n", m_loading_stats.m_num_textures, m_loading_stats.m_num_cache_hits, m_loading_stats.m_decode_time, m_loading_stats.m_upload_time);
 	}
 	void FSlateVulkanTextureManager::load_style_resources(const ISlateStyle& style)
 	{
@@ -55,13 +62,17 @@ namespace DoDo {
 	{
 		std::map<DoDoUtf8String, FNewTextureInfo> texture_info_map;
 
+		//the first brush of every texture, it decides where the image is loaded from
+		std::vector<std::pair<DoDoUtf8String, const FSlateBrush*>> textures_to_decode;
+
 		for (int32_t resource_index = 0; resource_index < resources.size(); ++resource_index)//create real gpu buffer
 		{
 			const FSlateBrush& brush = *resources[resource_index];//todo:get the brush
 
 			const DoDoUtf8String texture_name = brush.get_resource_name();
 
-			if (brush.get_image_type() != ESlateBrushImageType::Vector && texture_name != "")//todo:implement resource map
+			//textures of an earlier call are already loaded
+			if (brush.get_image_type() != ESlateBrushImageType::Vector && texture_name != "" && m_resource_map.find(texture_name) == m_resource_map.end())//todo:implement resource map
 			{
 				//find the texture or add it if it doesn't exist(only load the texture once)
 				auto it = texture_info_map.find(texture_name);
@@ -79,31 +90,93 @@ namespace DoDo {
 					//only atlas the texture if none of the brushes that use it tile it
 					info.m_b_should_atlas &= (brush.m_tiling == ESlateBrushTileType::NoTile && info.m_b_srgb);//todo:how to understand it?
 
-					if (info.m_texture_data == nullptr)
-					{
-						//create memory
-						uint32_t width = 0;
-						uint32_t height = 0;
-						std::vector<uint8_t> raw_data;
-						bool b_succeeded = load_texture(brush, width, height, raw_data);//main memory
+					textures_to_decode.push_back({ texture_name, &brush });
+				}
+			}
+		}
+
+		load_textures(texture_info_map, textures_to_decode);
+	}
 
-						const uint32_t stride = 4;//rgba
+	void FSlateVulkanTextureManager::load_textures(std::map<DoDoUtf8String, FNewTextureInfo>& texture_info_map, const std::vector<std::pair<DoDoUtf8String, const FSlateBrush*>>& textures_to_decode)
+	{
+		std::chrono::high_resolution_clock::time_point start_time = std::chrono::high_resolution_clock::now();
 
-						info.m_texture_data = std::make_shared<FSlateTextureData>(width, height, stride, raw_data);
+		//decode on the workers, every texture only writes its own slot, so the result doesn't depend on the threads
+		std::vector<FSlateTextureDataPtr> decoded_textures(textures_to_decode.size());
+		std::vector<uint8_t> b_from_cache(textures_to_decode.size(), false);
 
-						const bool b_too_large_for_atlas = (width >= 256 || height >= 256);
+		Renderer* renderer = Application::get().get_renderer();
+		FSlateVulkanRenderer* vulkan_renderer = (FSlateVulkanRenderer*)(renderer);
 
-						info.m_b_should_atlas &= !b_too_large_for_atlas;
+		vulkan_renderer->m_batching_thread_pool->parallel_for((int32_t)textures_to_decode.size(), [&](int32_t texture_index)
+		{
+			bool b_texture_from_cache = false;
 
-						//success check
-					}
+			decoded_textures[texture_index] = load_texture_data(get_resource_path(*textures_to_decode[texture_index].second), b_texture_from_cache);
+
+			b_from_cache[texture_index] = b_texture_from_cache;
+		});
+
+		std::chrono::high_resolution_clock::time_point end_time = std::chrono::high_resolution_clock::now();
+
+		m_loading_stats.m_decode_time += std::chrono::duration<double, std::milli>(end_time - start_time).count();
+
+		start_time = end_time;
+
+		for (size_t texture_index = 0; texture_index < textures_to_decode.size(); ++texture_index)
+		{
+			if (decoded_textures[texture_index] == nullptr)
+			{
+				std::cout << "failed to load texture " << textures_to_decode[texture_index].first.c_str() << std::endl;
+
+				//a proxy handed out on first use draws white, like brushes without a texture
+				auto requested_proxy = m_resource_map.find(textures_to_decode[texture_index].first);
+				auto white_proxy = m_resource_map.find("DefaultWhite");
+				if (requested_proxy != m_resource_map.end() && white_proxy != m_resource_map.end())
+				{
+					requested_proxy->second->m_resource = white_proxy->second->m_resource;
 				}
+
+				texture_info_map.erase(textures_to_decode[texture_index].first);
+
+				continue;
 			}
-		}
 
-		//value sort?
+			FNewTextureInfo& info = texture_info_map[textures_to_decode[texture_index].first];
+
+			info.m_texture_data = decoded_textures[texture_index];
+
+			const bool b_too_large_for_atlas = (info.m_texture_data->get_width() >= m_max_atlased_texture_size || info.m_texture_data->get_height() >= m_max_atlased_texture_size);
+
+			info.m_b_should_atlas &= !b_too_large_for_atlas;
 
+			++m_loading_stats.m_num_textures;
+
+			m_loading_stats.m_num_cache_hits += b_from_cache[texture_index];
+
+#if SLATE_USE_TEXTURE_CACHE
+			//the next run reads it from the cache, only the path is kept, the pixels are freed once they are uploaded
+			if (!b_from_cache[texture_index])
+			{
+				m_textures_to_cook.insert(get_resource_path(*textures_to_decode[texture_index].second));
+			}
+#endif
+		}
+
+		//the shelves of an atlas page waste the least space when the tallest textures are packed first
+		std::vector<std::map<DoDoUtf8String, FNewTextureInfo>::const_iterator> sorted_texture_infos;
 		for(std::map<DoDoUtf8String, FNewTextureInfo>::const_iterator it = texture_info_map.begin(); it != texture_info_map.end(); ++it)
+		{
+			sorted_texture_infos.push_back(it);
+		}
+
+		std::stable_sort(sorted_texture_infos.begin(), sorted_texture_infos.end(), [](const std::map<DoDoUtf8String, FNewTextureInfo>::const_iterator& lhs, const std::map<DoDoUtf8String, FNewTextureInfo>::const_iterator& rhs)
+		{
+			return lhs->second.m_texture_data->get_height() > rhs->second.m_texture_data->get_height();
+		});
+
+		for(const std::map<DoDoUtf8String, FNewTextureInfo>::const_iterator& it : sorted_texture_infos)
 		{
 			const FNewTextureInfo& info = it->second;
 			
@@ -111,9 +184,399 @@ namespace DoDo {
 
 			//todo:implement generate texture resource(this is real place to generate gpu buffer)
 
-			FSlateShaderResourceProxy* new_texture = generate_texture_resource(info, texture_name);
+			//textures requested by get_shader_resource have their proxy already
+			auto existing_proxy = m_resource_map.find(texture_name);
+
+			//brush textures are named by their image file, see get_resource_path
+			FSlateShaderResourceProxy* new_texture = generate_texture_resource(info, texture_name, texture_name, existing_proxy != m_resource_map.end() ? existing_proxy->second : nullptr);
+
+			if (existing_proxy == m_resource_map.end())
+			{
+				m_resource_map.insert({ texture_name, new_texture });
+			}
+		}
+
+		//one upload per page instead of one per atlased texture
+		update_atlas_pages();
+
+		//all copies of the call go to the gpu in one command buffer, draw_windows picks up the finished ones
+		vulkan_renderer->m_upload_queue->submit();
+
+		m_loading_stats.m_upload_time += std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start_time).count();
+	}
+
+	FSlateTextureDataPtr FSlateVulkanTextureManager::load_texture_data(const DoDoUtf8String& resource_path, bool& out_b_from_cache)
+	{
+		const uint32_t stride = 4;//rgba
+
+		uint32_t width = 0;
+		uint32_t height = 0;
+
+		out_b_from_cache = false;
+
+		if (m_texture_cache.is_open())
+		{
+			//the pixels are read from the mapping when they are copied to the staging memory
+			const uint8_t* cached_pixels = m_texture_cache.find(resource_path, width, height);
+
+			if (cached_pixels != nullptr)
+			{
+				out_b_from_cache = true;
+
+				return std::make_shared<FSlateTextureData>(width, height, stride, cached_pixels);
+			}
+		}
+
+		int32_t x = 0, y = 0, n = 0;
+		unsigned char* data = stbi_load(resource_path.c_str(), &x, &y, &n, stride);
+
+		if (data == nullptr)
+		{
+			return nullptr;
+		}
+
+		std::vector<uint8_t> raw_data(data, data + (size_t)x * y * stride);//main memory
+
+		stbi_image_free(data);
+
+		return std::make_shared<FSlateTextureData>((uint32_t)x, (uint32_t)y, stride, std::move(raw_data));
+	}
+
+	bool FSlateVulkanTextureManager::open_texture_cache(const DoDoUtf8String& cache_path)
+	{
+		return m_texture_cache.open(cache_path);
+	}
+
+	bool FSlateVulkanTextureManager::cook_texture_cache(const DoDoUtf8String& cache_path)
+	{
+		//the open cache has no valid entry for these, so load_texture_data decodes the image files
+		const std::vector<DoDoUtf8String> paths_to_decode(m_textures_to_cook.begin(), m_textures_to_cook.end());
+		std::vector<FSlateTextureDataPtr> decoded_textures(paths_to_decode.size());
+
+		Renderer* renderer = Application::get().get_renderer();
+		FSlateVulkanRenderer* vulkan_renderer = (FSlateVulkanRenderer*)(renderer);
+
+		vulkan_renderer->m_batching_thread_pool->parallel_for((int32_t)paths_to_decode.size(), [&](int32_t texture_index)
+		{
+			bool b_from_cache = false;
+
+			decoded_textures[texture_index] = load_texture_data(paths_to_decode[texture_index], b_from_cache);
+		});
+
+		//ordered by path so the same images give the same file
+		std::map<DoDoUtf8String, FSlateTextureDataPtr> textures;
+
+		for (size_t texture_index = 0; texture_index < paths_to_decode.size(); ++texture_index)
+		{
+			//the image was removed after it was loaded, it is left out like images that were never loaded
+			if (decoded_textures[texture_index] != nullptr)
+			{
+				textures[paths_to_decode[texture_index]] = decoded_textures[texture_index];
+			}
+		}
+
+		std::vector<const FSlateBrush*> resources;
+
+		FSlateStyleRegistry::get_all_resources(resources);
+
+		for (const FSlateBrush* brush : resources)
+		{
+			if (brush->get_image_type() == ESlateBrushImageType::Vector || brush->get_resource_name() == "")
+			{
+				continue;
+			}
+
+			const DoDoUtf8String source_path = get_resource_path(*brush);
+
+			uint32_t width = 0;
+			uint32_t height = 0;
+			const uint8_t* cached_pixels = m_texture_cache.is_open() && textures.find(source_path) == textures.end() ? m_texture_cache.find(source_path, width, height) : nullptr;
+
+			//the old cache is unmapped before the new one replaces it, so its valid entries are copied
+			if (cached_pixels != nullptr)
+			{
+				textures[source_path] = std::make_shared<FSlateTextureData>(width, height, 4, std::vector<uint8_t>(cached_pixels, cached_pixels + (size_t)width * height * 4));
+			}
+		}
+
+		std::vector<FSlateCookedTexture> cooked_textures;
+
+		for (const std::pair<const DoDoUtf8String, FSlateTextureDataPtr>& texture : textures)
+		{
+			cooked_textures.emplace_back(texture.first, texture.second->get_width(), texture.second->get_height(), texture.second->get_data());
+		}
+
+		m_texture_cache.close();
+
+		const bool b_written = FSlateTextureCache::write(cache_path, cooked_textures);
+
+		m_texture_cache.open(cache_path);
+
+		if (b_written)
+		{
+			m_textures_to_cook.clear();
+		}
+
+		return b_written;
+	}
+
+	void FSlateVulkanTextureManager::update_residency(uint64_t frame_number)
+	{
+		m_current_frame_number = frame_number;
+
+		if (!m_requested_textures.empty())
+		{
+			//brushes drawn the first time since the last frame, their proxies wait for the upload
+			std::vector<std::pair<DoDoUtf8String, FSlateBrush>> requested_textures = std::move(m_requested_textures);
+			m_requested_textures.clear();
+
+			std::map<DoDoUtf8String, FNewTextureInfo> texture_info_map;
+			std::vector<std::pair<DoDoUtf8String, const FSlateBrush*>> textures_to_decode;
+
+			for (const std::pair<DoDoUtf8String, FSlateBrush>& requested_texture : requested_textures)
+			{
+				const FSlateBrush& brush = requested_texture.second;
+
+				FNewTextureInfo& info = texture_info_map[requested_texture.first];
+
+				info.m_b_srgb = (brush.m_image_type != ESlateBrushImageType::Linear);
 
-			m_resource_map.insert({ texture_name, new_texture });
+				//only atlas the texture if none of the brushes that use it tile it
+				info.m_b_should_atlas &= (brush.m_tiling == ESlateBrushTileType::NoTile && info.m_b_srgb);
+
+				textures_to_decode.push_back({ requested_texture.first, &brush });
+			}
+
+			load_textures(texture_info_map, textures_to_decode);
+		}
+
+		reload_released_textures();
+
+		evict_textures();
+	}
+
+	void FSlateVulkanTextureManager::set_memory_budget(uint64_t in_memory_budget)
+	{
+		m_residency_stats.m_memory_budget = in_memory_budget;
+	}
+
+	void FSlateVulkanTextureManager::reload_released_textures()
+	{
+		std::vector<FSlateVulkanNonAtlasedTexture*> textures_to_reload;
+
+		for (const std::unique_ptr<FSlateVulkanNonAtlasedTexture>& non_atlased_texture : m_non_atlased_textures)
+		{
+			const FSlateVulkanTexture& texture = *non_atlased_texture->m_texture;
+
+			//drawn in or after the frame its image was released in
+			if (!non_atlased_texture->m_b_uploading && texture.get_image()._image == VK_NULL_HANDLE && non_atlased_texture->m_source_path != ""
+				&& texture.get_last_used_frame() >= non_atlased_texture->m_release_frame)
+			{
+				textures_to_reload.push_back(non_atlased_texture.get());
+			}
+		}
+
+		if (textures_to_reload.empty())
+		{
+			return;
+		}
+
+		std::vector<FSlateTextureDataPtr> decoded_textures(textures_to_reload.size());
+
+		Renderer* renderer = Application::get().get_renderer();
+		FSlateVulkanRenderer* vulkan_renderer = (FSlateVulkanRenderer*)(renderer);
+
+		vulkan_renderer->m_batching_thread_pool->parallel_for((int32_t)textures_to_reload.size(), [&](int32_t texture_index)
+		{
+			bool b_from_cache = false;
+
+			decoded_textures[texture_index] = load_texture_data(textures_to_reload[texture_index]->m_source_path, b_from_cache);
+		});
+
+		for (size_t texture_index = 0; texture_index < textures_to_reload.size(); ++texture_index)
+		{
+			FSlateVulkanNonAtlasedTexture* reloaded_texture = textures_to_reload[texture_index];
+
+			if (decoded_textures[texture_index] == nullptr)
+			{
+				std::cout << "failed to reload texture " << reloaded_texture->m_source_path.c_str() << std::endl;
+
+				//the file is gone, don't try every frame
+				reloaded_texture->m_source_path = "";
+
+				continue;
+			}
+
+			reloaded_texture->m_width = decoded_textures[texture_index]->get_width();
+			reloaded_texture->m_height = decoded_textures[texture_index]->get_height();
+			reloaded_texture->m_b_uploading = true;
+
+			//the proxy still points to the texture, its batches are drawn again once the upload finished
+			upload_texture_data(*reloaded_texture->m_texture, reloaded_texture->m_width, reloaded_texture->m_height, decoded_textures[texture_index]->get_data(), [reloaded_texture]()
+			{
+				reloaded_texture->m_b_uploading = false;
+			});
+
+			++m_residency_stats.m_num_reloads;
+		}
+
+		vulkan_renderer->m_upload_queue->submit();
+	}
+
+	void FSlateVulkanTextureManager::evict_textures()
+	{
+		uint64_t resident_bytes = 0;
+		uint32_t num_resident_textures = 0;
+
+		for (const FSlateVulkanAtlasPage& page : m_atlas_pages)
+		{
+			if (page.m_texture->get_image()._image != VK_NULL_HANDLE)
+			{
+				resident_bytes += (uint64_t)page.m_atlas->get_width() * page.m_atlas->get_height() * page.m_atlas->get_bytes_per_pixel();
+				++num_resident_textures;
+			}
+		}
+
+		for (const std::unique_ptr<FSlateVulkanNonAtlasedTexture>& non_atlased_texture : m_non_atlased_textures)
+		{
+			if (non_atlased_texture->m_texture->get_image()._image != VK_NULL_HANDLE)
+			{
+				resident_bytes += (uint64_t)non_atlased_texture->m_width * non_atlased_texture->m_height * 4;
+				++num_resident_textures;
+			}
+		}
+
+		const uint64_t memory_budget = m_residency_stats.m_memory_budget;
+
+		if (memory_budget != 0 && resident_bytes > memory_budget)
+		{
+			Renderer* renderer = Application::get().get_renderer();
+			FSlateVulkanRenderer* vulkan_renderer = (FSlateVulkanRenderer*)(renderer);
+
+			//frames after this one may still be read by the gpu
+			const uint64_t num_frames_in_flight = vulkan_renderer->get_num_frames_in_flight();
+
+			std::vector<FSlateVulkanNonAtlasedTexture*> eviction_candidates;
+
+			for (const std::unique_ptr<FSlateVulkanNonAtlasedTexture>& non_atlased_texture : m_non_atlased_textures)
+			{
+				const FSlateVulkanTexture& texture = *non_atlased_texture->m_texture;
+
+				if (texture.is_resident() && !non_atlased_texture->m_b_uploading && non_atlased_texture->m_source_path != ""
+					&& texture.get_last_used_frame() + num_frames_in_flight <= m_current_frame_number)
+				{
+					eviction_candidates.push_back(non_atlased_texture.get());
+				}
+			}
+
+			std::sort(eviction_candidates.begin(), eviction_candidates.end(), [](const FSlateVulkanNonAtlasedTexture* lhs, const FSlateVulkanNonAtlasedTexture* rhs)
+			{
+				return lhs->m_texture->get_last_used_frame() < rhs->m_texture->get_last_used_frame();
+			});
+
+			//textures drawn by the frames in flight stay, so the budget can be exceeded for a while
+			for (FSlateVulkanNonAtlasedTexture* evicted_texture : eviction_candidates)
+			{
+				if (resident_bytes <= memory_budget)
+				{
+					break;
+				}
+
+				release_texture_image(*evicted_texture->m_texture);
+
+				evicted_texture->m_release_frame = m_current_frame_number;
+
+				resident_bytes -= (uint64_t)evicted_texture->m_width * evicted_texture->m_height * 4;
+				--num_resident_textures;
+
+				++m_residency_stats.m_num_evictions;
+			}
+		}
+
+		m_residency_stats.m_resident_bytes = resident_bytes;
+		m_residency_stats.m_num_resident_textures = num_resident_textures;
+	}
+
+	void FSlateVulkanTextureManager::release_texture_image(FSlateVulkanTexture& texture)
+	{
+		Renderer* renderer = Application::get().get_renderer();
+		FSlateVulkanRenderer* vulkan_renderer = (FSlateVulkanRenderer*)(renderer);
+
+		VkDevice device = *(VkDevice*)(vulkan_renderer->m_logic_device->get_native_handle());
+
+		if (texture.owns_bindless_index())
+		{
+			vulkan_renderer->unregister_bindless_texture(texture.get_bindless_index());
+		}
+
+		vkDestroyImageView(device, texture.get_typed_resource(), nullptr);
+
+		vmaDestroyImage(vulkan_renderer->m_allocator, texture.get_image()._image, texture.get_image()._allocation);
+
+		AllocatedImage released_image;
+		released_image._image = VK_NULL_HANDLE;
+		released_image._allocation = nullptr;
+
+		texture.set_image(released_image);
+		texture.set_shader_resource(VK_NULL_HANDLE);
+		texture.set_bindless_index(FSlateVulkanTexture::invalid_bindless_index);
+	}
+
+	void FSlateVulkanTextureManager::destroy()
+	{
+		for (FSlateVulkanAtlasPage& page : m_atlas_pages)
+		{
+			if (page.m_texture->get_image()._image != VK_NULL_HANDLE)
+			{
+				release_texture_image(*page.m_texture);
+			}
+		}
+
+		for (std::unique_ptr<FSlateVulkanNonAtlasedTexture>& non_atlased_texture : m_non_atlased_textures)
+		{
+			if (non_atlased_texture->m_texture->get_image()._image != VK_NULL_HANDLE)
+			{
+				release_texture_image(*non_atlased_texture->m_texture);
+			}
+		}
+	}
+
+	void FSlateVulkanTextureManager::set_atlas_settings(uint32_t in_atlas_page_size, uint32_t in_max_atlased_texture_size)
+	{
+		m_atlas_page_size = in_atlas_page_size;
+		m_max_atlased_texture_size = in_max_atlased_texture_size;
+	}
+
+	std::vector<float> FSlateVulkanTextureManager::get_atlas_page_occupancy() const
+	{
+		std::vector<float> occupancy;
+
+		for(const FSlateVulkanAtlasPage& page : m_atlas_pages)
+		{
+			occupancy.push_back(page.m_atlas->get_occupancy());
+		}
+
+		return occupancy;
+	}
+
+	void FSlateVulkanTextureManager::update_atlas_pages()
+	{
+		for(FSlateVulkanAtlasPage& page : m_atlas_pages)
+		{
+			if(page.m_atlas->needs_update())
+			{
+				FSlateVulkanTexture* page_texture = page.m_texture.get();
+				upload_texture_data(*page.m_texture, page.m_atlas->get_width(), page.m_atlas->get_height(), page.m_atlas->get_atlas_data().data(), [page_texture, pending_proxies = std::move(page.m_pending_proxies)]()
+				{
+					for(FSlateShaderResourceProxy* proxy : pending_proxies)
+					{
+						proxy->m_resource = page_texture;
+					}
+				});
+				page.m_pending_proxies.clear();
+
+				page.m_atlas->mark_updated();
+			}
 		}
 	}
 
@@ -132,10 +595,16 @@ namespace DoDo {
 		uint32_t width = 1, height = 1, stride = 4;
 		info.m_texture_data = std::make_shared<FSlateTextureData>(width, height, stride, raw_data);
 
-		FSlateShaderResourceProxy* new_texture = generate_texture_resource(info, texture_name);
+		//there is no file to load a color texture from again, it is never released
+		FSlateShaderResourceProxy* new_texture = generate_texture_resource(info, texture_name, "", nullptr);
 
 		m_resource_map.insert({ texture_name, new_texture });
 
+		//color textures are used as fallbacks right away
+		Renderer* renderer = Application::get().get_renderer();
+		FSlateVulkanRenderer* vulkan_renderer = (FSlateVulkanRenderer*)(renderer);
+		vulkan_renderer->m_upload_queue->wait_for_uploads();
+
 		return new_texture;
 	}
 
@@ -183,166 +652,184 @@ namespace DoDo {
 			auto it = m_resource_map.find(in_brush.get_resource_name());
 			//texture = it->second;
 			if (it != m_resource_map.end())
+			{
 				texture = it->second;
+			}
+			else if (in_brush.get_resource_name() != "")
+			{
+				//first use, the next update_residency loads the texture, elements of the brush aren't drawn until its upload finished
+				texture = new FSlateShaderResourceProxy;
+
+				m_resource_map.insert({ in_brush.get_resource_name(), texture });
+
+				m_requested_textures.push_back({ in_brush.get_resource_name(), in_brush });
+			}
 		}
 
 		return texture;
 	}
-	FSlateShaderResourceProxy* FSlateVulkanTextureManager::generate_texture_resource(const FNewTextureInfo& info, DoDoUtf8String texture_name)
+	FSlateShaderResourceProxy* FSlateVulkanTextureManager::generate_texture_resource(const FNewTextureInfo& info, DoDoUtf8String texture_name, const DoDoUtf8String& source_path, FSlateShaderResourceProxy* in_proxy)
 	{
-		FSlateShaderResourceProxy* new_proxy = nullptr;
+		FSlateShaderResourceProxy* new_proxy = in_proxy;
 
 		const uint32_t width = info.m_texture_data->get_width();
 		const uint32_t height = info.m_texture_data->get_height();
 
 		if (info.m_b_should_atlas)
 		{
-			const uint32_t atlas_size = 1024;
+			const uint32_t atlas_size = m_atlas_page_size;
 
 			//4 bytes per pixel
 			const uint32_t atlas_stride = 4;
 
-			//
-		}
-		else
-		{
-			//the texture is not atlased create a new texture proxy and just point it to the actual texture
-			new_proxy = new FSlateShaderResourceProxy;
-
-			//keep track of non-atlased textures so we can free their resource later
-			//todo:implement vulkan texture
-			std::unique_ptr<FSlateVulkanTexture> texture = std::make_unique<FSlateVulkanTexture>();
-
-			new_proxy->m_resource = texture.get();
-			new_proxy->m_start_uv = glm::vec2(0.0f, 0.0f);
-			new_proxy->m_size_uv = glm::vec2(1.0f, 1.0f);
-			new_proxy->m_actual_size = FIntPoint(width, height);
+			//the sampler doesn't clamp to the slot, one repeated border pixel keeps the neighbours out
+			const uint32_t atlas_padding = 1;
 
-			//------------------init texture------------------
+			const FAtlasedTextureSlot* new_slot = nullptr;
+			FSlateVulkanAtlasPage* atlas_page = nullptr;
 
-			//get renderer
-			Renderer* renderer = Application::get().get_renderer();
-			FSlateVulkanRenderer* vulkan_renderer = (FSlateVulkanRenderer*)(renderer);
+			for(FSlateVulkanAtlasPage& page : m_atlas_pages)
+			{
+				new_slot = page.m_atlas->add_texture(width, height, info.m_texture_data->get_data());
+				if(new_slot != nullptr)
+				{
+					atlas_page = &page;
+					break;
+				}
+			}
 
-			//the format R8G8B8A8 matches exactly with the pixels loaded from stb_image lib
-			VkFormat image_format = VK_FORMAT_R8G8B8A8_SRGB;
+			if(new_slot == nullptr)
+			{
+				//the image of the page is created when it is uploaded
+				FSlateVulkanAtlasPage new_page;
+				new_page.m_atlas = std::make_unique<FSlateTextureAtlas>(atlas_size, atlas_size, atlas_stride, atlas_padding);
+				new_page.m_texture = std::make_unique<FSlateVulkanTexture>();
+				m_atlas_pages.push_back(std::move(new_page));
+
+				atlas_page = &m_atlas_pages.back();
+				new_slot = atlas_page->m_atlas->add_texture(width, height, info.m_texture_data->get_data());
+			}
 
-			//allocate temporary buffer for holding texture data to upload
-			AllocatedBuffer staging_buffer = vulkan_renderer->create_buffer(width * height * 4, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VMA_MEMORY_USAGE_CPU_ONLY);
+			if(new_slot != nullptr)
+			{
+				if(new_proxy == nullptr)
+				{
+					new_proxy = new FSlateShaderResourceProxy;
+				}
 
-			//copy data to buffer
-			void* data;
-			vmaMapMemory(vulkan_renderer->m_allocator, staging_buffer.m_allocation, &data);
+				//m_resource is set when the page upload with this slot finished
+				atlas_page->m_pending_proxies.push_back(new_proxy);
 
-			memcpy(data, info.m_texture_data->get_raw_bytes().data(), static_cast<size_t>(width * height * 4));
+				new_proxy->m_start_uv = glm::vec2((float)(new_slot->m_x + new_slot->m_padding) / atlas_size, (float)(new_slot->m_y + new_slot->m_padding) / atlas_size);
+				new_proxy->m_size_uv = glm::vec2((float)width / atlas_size, (float)height / atlas_size);
+				new_proxy->m_actual_size = FIntPoint(width, height);
 
-			vmaUnmapMemory(vulkan_renderer->m_allocator, staging_buffer.m_allocation);
+				return new_proxy;
+			}
 
-			VkExtent3D imageExtent;
-			imageExtent.width = static_cast<uint32_t>(width);
-			imageExtent.height = static_cast<uint32_t>(height);
-			imageExtent.depth = 1;
+			//doesn't fit an empty page either, the texture gets its own image
+		}
 
-			VkImageCreateInfo dimg_info = image_create_info(image_format, VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT, imageExtent);
+		//the texture is not atlased create a new texture proxy and just point it to the actual texture
+		if(new_proxy == nullptr)
+		{
+			new_proxy = new FSlateShaderResourceProxy;
+		}
 
-			AllocatedImage newImage;//create new image
+		//keep track of non-atlased textures so we can free their resource later
+		std::unique_ptr<FSlateVulkanNonAtlasedTexture> non_atlased_texture = std::make_unique<FSlateVulkanNonAtlasedTexture>();
+		non_atlased_texture->m_texture = std::make_unique<FSlateVulkanTexture>();
+		non_atlased_texture->m_source_path = source_path;
+		non_atlased_texture->m_width = width;
+		non_atlased_texture->m_height = height;
+		non_atlased_texture->m_b_uploading = true;
 
-			VmaAllocationCreateInfo dimg_allocinfo = {};
-			dimg_allocinfo.usage = VMA_MEMORY_USAGE_GPU_ONLY;
+		//a texture that wasn't drawn yet isn't released before the ones drawn before it was loaded
+		non_atlased_texture->m_texture->mark_used(m_current_frame_number);
 
-			//allocate and create the image
-			vmaCreateImage(vulkan_renderer->m_allocator, &dimg_info, &dimg_allocinfo, &newImage._image, &newImage._allocation, nullptr);
+		new_proxy->m_start_uv = glm::vec2(0.0f, 0.0f);
+		new_proxy->m_size_uv = glm::vec2(1.0f, 1.0f);
+		new_proxy->m_actual_size = FIntPoint(width, height);
 
-			vulkan_renderer->immediate_submit([&](VkCommandBuffer cmd) {
-				VkImageSubresourceRange range;//tell what part of the image we will transform
-				range.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-				range.baseMipLevel = 0;
-				range.levelCount = 1;
-				range.baseArrayLayer = 0;
-				range.layerCount = 1;
+		//the proxy points to the texture once the upload finished, elements of the brush aren't drawn until then
+		FSlateVulkanNonAtlasedTexture* uploaded_texture = non_atlased_texture.get();
+		upload_texture_data(*non_atlased_texture->m_texture, width, height, info.m_texture_data->get_data(), [new_proxy, uploaded_texture]()
+		{
+			new_proxy->m_resource = uploaded_texture->m_texture.get();
 
-				VkImageMemoryBarrier imageBarrier_toTransfer = {};
-				imageBarrier_toTransfer.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+			uploaded_texture->m_b_uploading = false;
+		});
 
-				imageBarrier_toTransfer.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-				imageBarrier_toTransfer.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-				imageBarrier_toTransfer.image = newImage._image;
-				imageBarrier_toTransfer.subresourceRange = range;
+		m_non_atlased_textures.push_back(std::move(non_atlased_texture));
 
-				imageBarrier_toTransfer.srcAccessMask = 0;
-				imageBarrier_toTransfer.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+		return new_proxy;
+	}
 
-				//barrier the image into the transfer-receive layout
-				vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, &imageBarrier_toTransfer);
+	void FSlateVulkanTextureManager::upload_texture_data(FSlateVulkanTexture& texture, uint32_t width, uint32_t height, const uint8_t* data, std::function<void()>&& on_complete)
+	{
+		//get renderer
+		Renderer* renderer = Application::get().get_renderer();
+		FSlateVulkanRenderer* vulkan_renderer = (FSlateVulkanRenderer*)(renderer);
 
-				VkBufferImageCopy copyRegion = {};
-				copyRegion.bufferOffset = 0;
-				copyRegion.bufferRowLength = 0;
-				copyRegion.bufferImageHeight = 0;
+		//an atlas page is uploaded again after textures were added to it
+		const bool b_has_image = texture.get_typed_resource() != VK_NULL_HANDLE;
 
-				copyRegion.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-				copyRegion.imageSubresource.mipLevel = 0;
-				copyRegion.imageSubresource.baseArrayLayer = 0;
-				copyRegion.imageSubresource.layerCount = 1;
-				copyRegion.imageExtent = imageExtent;
+		if (b_has_image)
+		{
+			vulkan_renderer->m_upload_queue->upload_image(texture.get_image()._image, width, height, data, true, std::move(on_complete));
 
-				//copy the buffer into the image
-				vkCmdCopyBufferToImage(cmd, staging_buffer.m_buffer, newImage._image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &copyRegion);
+			return;
+		}
 
-				//to shader readable layout
-				VkImageMemoryBarrier imageBarrier_toReadable = imageBarrier_toTransfer;
+		//the format R8G8B8A8 matches exactly with the pixels loaded from stb_image lib
+		VkFormat image_format = VK_FORMAT_R8G8B8A8_SRGB;
 
-				imageBarrier_toReadable.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-				imageBarrier_toReadable.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+		VkExtent3D imageExtent;
+		imageExtent.width = static_cast<uint32_t>(width);
+		imageExtent.height = static_cast<uint32_t>(height);
+		imageExtent.depth = 1;
 
-				imageBarrier_toReadable.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-				imageBarrier_toReadable.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+		VkImageCreateInfo dimg_info = image_create_info(image_format, VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT, imageExtent);
 
-				//barrier the image into the shader readable layout
-				vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0, 0, nullptr, 0, nullptr, 1, &imageBarrier_toReadable);
-			});
+		AllocatedImage newImage;//create new image
 
-			vulkan_renderer->m_deletion_queue.push_function([=]() {
-				vmaDestroyImage(vulkan_renderer->m_allocator, newImage._image, newImage._allocation);
-			});
+		VmaAllocationCreateInfo dimg_allocinfo = {};
+		dimg_allocinfo.usage = VMA_MEMORY_USAGE_GPU_ONLY;
 
-			//destroy staging buffer
-			vmaDestroyBuffer(vulkan_renderer->m_allocator, staging_buffer.m_buffer, staging_buffer.m_allocation);
-			//------------------init texture------------------
+		//allocate and create the image, destroyed by release_texture_image or destroy
+		vmaCreateImage(vulkan_renderer->m_allocator, &dimg_info, &dimg_allocinfo, &newImage._image, &newImage._allocation, nullptr);
 
-			//todo:move the initialize texture to texture class
-			VkDevice device = *(VkDevice*)(vulkan_renderer->m_logic_device->get_native_handle());
-			VkImageView image_view;
-			VkImageViewCreateInfo imageinfo = imageview_create_info(VK_FORMAT_R8G8B8A8_SRGB, newImage._image, VK_IMAGE_ASPECT_COLOR_BIT);
-			vkCreateImageView(device, &imageinfo, nullptr, &image_view);
+		//todo:move the initialize texture to texture class
+		VkDevice device = *(VkDevice*)(vulkan_renderer->m_logic_device->get_native_handle());
+		VkImageView image_view;
+		VkImageViewCreateInfo imageinfo = imageview_create_info(VK_FORMAT_R8G8B8A8_SRGB, newImage._image, VK_IMAGE_ASPECT_COLOR_BIT);
+		vkCreateImageView(device, &imageinfo, nullptr, &image_view);
 
-			vulkan_renderer->m_deletion_queue.push_function([=]() {
-				vkDestroyImageView(device, image_view, nullptr);
-			});
+		texture.set_image(newImage);
+		texture.set_shader_resource(image_view);//todo:fix me
 
-			texture->set_image(newImage);
-			texture->set_shader_resource(image_view);//todo:fix me
-
-			//------descriptor set------
-			//VkDescriptorSet image_descriptor_set;
-			////allocate the descriptor set for texture to use on the material
-			//VkDescriptorSetAllocateInfo alloc_info = {};
-			//alloc_info.pNext = nullptr;
-			//alloc_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-			//alloc_info.descriptorPool = vulkan_renderer->m_descriptor_pool;
-			//alloc_info.descriptorSetCount = 1;
-			//alloc_info.pSetLayouts = &vulkan_renderer->m_shader_set_layout;
-			//
-			//vkAllocateDescriptorSets(device, &alloc_info, &image_descriptor_set);
-			//texture->set_descriptor_set(image_descriptor_set);
-			//------descriptor set------
-
-			//todo:fix me, move this to render batch, because descriptor set is 
-
-			m_non_atlased_textures.push_back(std::move(texture));
-		}
+		//the copy is recorded now and runs with the other uploads of the batch, the texture can only be drawn once it finished
+		FSlateVulkanTexture* uploaded_texture = &texture;
+		vulkan_renderer->m_upload_queue->upload_image(newImage._image, width, height, data, false, [this, vulkan_renderer, uploaded_texture, image_view, on_complete = std::move(on_complete)]()
+		{
+			//written once here, draws only push the index
+			const uint32_t bindless_index = vulkan_renderer->register_bindless_texture(image_view);
+			if (bindless_index != FSlateVulkanTexture::invalid_bindless_index)
+			{
+				uploaded_texture->set_bindless_index(bindless_index);
+			}
+			else
+			{
+				//the array is full, the texture is drawn with the white texture's slot like a texture that failed to load
+				auto white_proxy = m_resource_map.find("DefaultWhite");
+				const FSlateVulkanTexture* white_texture = white_proxy != m_resource_map.end() ? static_cast<const FSlateVulkanTexture*>(white_proxy->second->m_resource) : nullptr;
+				if (white_texture != nullptr && white_texture != uploaded_texture)
+				{
+					uploaded_texture->set_bindless_index(white_texture->get_bindless_index(), false);
+				}
+			}
 
-		return new_proxy;
+			on_complete();
+		});
 	}
-
-}
\ No newline at end of file
+}
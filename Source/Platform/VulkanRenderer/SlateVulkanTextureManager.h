@@ -8,14 +8,126 @@
 
 #include "SlateVulkanTextures.h"//m_non_atlased_textures depends on it
 
+#include "SlateCore/Textures/TextureAtlas.h"//FSlateVulkanAtlasPage depends on it
+
+#include "SlateCore/Textures/SlateTextureCache.h"//m_texture_cache depends on it
+
+#include "SlateCore/Styling/SlateBrush.h"//m_requested_textures depends on it
+
+/*
+ * set from the build, see SLATE_USE_TEXTURE_CACHE option in the cmake lists
+ * 1: the renderer loads the style images from the cooked texture cache and cooks it again when images changed
+ */
+#ifndef SLATE_USE_TEXTURE_CACHE
+#define SLATE_USE_TEXTURE_CACHE 1
+#endif
+
+/*
+ * set from the build, see SLATE_TEXTURE_MEMORY_BUDGET_MB in the cmake lists
+ * images of textures that weren't drawn recently are released while the resident textures exceed the budget, 0 never releases them
+ */
+#ifndef SLATE_TEXTURE_MEMORY_BUDGET_MB
+#define SLATE_TEXTURE_MEMORY_BUDGET_MB 256
+#endif
+
 namespace DoDo {
 
 	class ISlateStyle;
-	struct FSlateBrush;
 	class FSlateShaderResourceProxy;
+
+	/*an atlas page and the texture it is uploaded to*/
+	struct FSlateVulkanAtlasPage
+	{
+		std::unique_ptr<FSlateTextureAtlas> m_atlas;
+
+		std::unique_ptr<FSlateVulkanTexture> m_texture;
+
+		/*proxies of the textures added since the last upload, they become valid when it finished*/
+		std::vector<FSlateShaderResourceProxy*> m_pending_proxies;
+	};
+
+	/*
+	* a texture with its own image
+	* the image of a texture loaded from a file is released when the budget is exceeded and created again when the texture is drawn
+	*/
+	struct FSlateVulkanNonAtlasedTexture
+	{
+		/*stays alive while the image is released, proxies and cached render batches point to it*/
+		std::unique_ptr<FSlateVulkanTexture> m_texture;
+
+		/*image file to load the pixels from again, empty for textures that can't be released*/
+		DoDoUtf8String m_source_path;
+
+		uint32_t m_width;
+
+		uint32_t m_height;
+
+		/*frame the image was released in, a later draw loads it again*/
+		uint64_t m_release_frame;
+
+		/*an upload of the image is in flight*/
+		bool m_b_uploading;
+
+		FSlateVulkanNonAtlasedTexture()
+			: m_width(0)
+			, m_height(0)
+			, m_release_frame(0)
+			, m_b_uploading(false)
+		{}
+	};
+
+	/*memory of the textures and how often the budget released them*/
+	struct FSlateTextureResidencyStats
+	{
+		/*bytes of all images that exist, including atlas pages and uploads in flight*/
+		uint64_t m_resident_bytes;
+
+		/*0 if unlimited*/
+		uint64_t m_memory_budget;
+
+		uint32_t m_num_resident_textures;
+
+		/*images released to stay inside the budget*/
+		uint32_t m_num_evictions;
+
+		/*released images created again because they were drawn*/
+		uint32_t m_num_reloads;
+
+		FSlateTextureResidencyStats()
+			: m_resident_bytes(0)
+			, m_memory_budget(0)
+			, m_num_resident_textures(0)
+			, m_num_evictions(0)
+			, m_num_reloads(0)
+		{}
+	};
+
+	/*texture loading time of all create_textures calls, in milliseconds*/
+	struct FSlateTextureLoadingStats
+	{
+		uint32_t m_num_textures;
+
+		/*textures read from the cooked texture cache instead of being decoded*/
+		uint32_t m_num_cache_hits;
+
+		/*wall time of decoding the images or reading them from the cache on the thread pool*/
+		double m_decode_time;
+
+		/*creating the images and recording their uploads, the gpu copies finish asynchronously*/
+		double m_upload_time;
+
+		FSlateTextureLoadingStats()
+			: m_num_textures(0)
+			, m_num_cache_hits(0)
+			, m_decode_time(0.0)
+			, m_upload_time(0.0)
+		{}
+	};
+
 	/*
 	* stores a mapping of texture names to their loaded vulkan resource
 	* resources are loaded from disk and created on demand when needed
+	* get_shader_resource hands out a proxy for an unknown image right away, update_residency loads it and releases the images drawn least recently when over the budget
 	*/
 	class FSlateVulkanTextureManager : public FSlateShaderResourceManager
 	{
@@ -49,11 +161,121 @@ namespace DoDo {
 		* generates rendering resources for a texture
 		* 
 		* @param Info Information on how to generate the texture resource
+		* @param source_path image file the texture is loaded from again after its image was released, empty if it must stay resident
+		* @param in_proxy proxy handed out before the texture was loaded, a new one is created if nullptr
 		*/
-		FSlateShaderResourceProxy* generate_texture_resource(const FNewTextureInfo& info, DoDoUtf8String texture_name);
+		FSlateShaderResourceProxy* generate_texture_resource(const FNewTextureInfo& info, DoDoUtf8String texture_name, const DoDoUtf8String& source_path, FSlateShaderResourceProxy* in_proxy);
+
+		/*
+		* loads the textures requested since the last call, loads released images that were drawn again
+		* and releases the images drawn least recently while the resident textures exceed the memory budget
+		*
+		* @param frame_number the frame that is about to be recorded, frames older than the frames in flight must have finished on the gpu
+		*/
+		void update_residency(uint64_t frame_number);
+
+		/*
+		* @param in_memory_budget bytes the images may use before the least recently drawn are released, 0 for no limit
+		*/
+		void set_memory_budget(uint64_t in_memory_budget);
+
+		const FSlateTextureResidencyStats& get_residency_stats() const { return m_residency_stats; }
+
+		/*destroys all images, the device must be idle*/
+		void destroy();
+
+		/*
+		* sets how textures are atlased, only affects textures created afterwards
+		*
+		* @param in_atlas_page_size width and height of a new atlas page
+		* @param in_max_atlased_texture_size textures with a side of this size or larger get their own image
+		*/
+		void set_atlas_settings(uint32_t in_atlas_page_size, uint32_t in_max_atlased_texture_size);
+
+		/*
+		* @return the used fraction of each atlas page, 0 to 1
+		*/
+		std::vector<float> get_atlas_page_occupancy() const;
+
+		const FSlateTextureLoadingStats& get_loading_stats() const { return m_loading_stats; }
+
+		/*
+		* maps a cooked texture cache, create_textures takes the pixels of unchanged images from it instead of decoding them
+		*
+		* @return false if there is no valid cache at the path
+		*/
+		bool open_texture_cache(const DoDoUtf8String& cache_path);
+
+		/*
+		* writes a new texture cache with the images that were decoded since the cache was opened, then opens it
+		* only their paths were kept, so they are decoded again, valid entries of the open cache are copied and images that were never loaded are left out
+		*
+		* @return false if the cache couldn't be written
+		*/
+		bool cook_texture_cache(const DoDoUtf8String& cache_path);
+
+		/*true if images were decoded because the cache had no valid entry for them*/
+		bool has_textures_to_cook() const { return !m_textures_to_cook.empty(); }
 	private:
-		
-		/*static non atlased textures*/
-		std::vector<std::unique_ptr<FSlateVulkanTexture>> m_non_atlased_textures;
+		/*
+		* decodes the textures on the thread pool and creates their resources, proxies already in m_resource_map are filled in
+		*
+		* @param textures_to_decode name and first brush of every texture in texture_info_map
+		*/
+		void load_textures(std::map<DoDoUtf8String, FNewTextureInfo>& texture_info_map, const std::vector<std::pair<DoDoUtf8String, const FSlateBrush*>>& textures_to_decode);
+
+		/*
+		* decodes the image file, or references its pixels in the texture cache if it didn't change since it was cooked
+		*
+		* @param out_b_from_cache true if the pixels point into the texture cache
+		* @return nullptr if the image couldn't be loaded
+		*/
+		FSlateTextureDataPtr load_texture_data(const DoDoUtf8String& resource_path, bool& out_b_from_cache);
+
+		/*creates the images of the released textures that were drawn since*/
+		void reload_released_textures();
+
+		/*releases the images drawn least recently until the resident textures fit into the budget*/
+		void evict_textures();
+
+		/*destroys the image of the texture and frees its bindless slot*/
+		void release_texture_image(FSlateVulkanTexture& texture);
+
+		/*uploads the atlas pages that got new textures*/
+		void update_atlas_pages();
+
+		/*
+		* creates the image of the texture on first use, then queues the copy of the pixels on the renderer's upload queue
+		* an existing image keeps the pixels outside of the copy
+		*
+		* @param on_complete runs when the copy finished, the texture has its bindless index then
+		*/
+		void upload_texture_data(FSlateVulkanTexture& texture, uint32_t width, uint32_t height, const uint8_t* data, std::function<void()>&& on_complete);
+
+		/*non atlased textures, unique_ptr keeps them at the same address for the upload callbacks*/
+		std::vector<std::unique_ptr<FSlateVulkanNonAtlasedTexture>> m_non_atlased_textures;
+
+		/*first use brushes whose textures are loaded by the next update_residency, the proxies are in m_resource_map already*/
+		std::vector<std::pair<DoDoUtf8String, FSlateBrush>> m_requested_textures;
+
+		/*pages of the small textures*/
+		std::vector<FSlateVulkanAtlasPage> m_atlas_pages;
+
+		uint32_t m_atlas_page_size;
+
+		uint32_t m_max_atlased_texture_size;
+
+		FSlateTextureLoadingStats m_loading_stats;
+
+		/*cooked pixels of the style images, closed if there is no cache*/
+		FSlateTextureCache m_texture_cache;
+
+		/*source paths of the images decoded since the cache was opened, cook_texture_cache decodes them again*/
+		std::set<DoDoUtf8String> m_textures_to_cook;
+
+		FSlateTextureResidencyStats m_residency_stats;
+
+		/*frame passed to the last update_residency*/
+		uint64_t m_current_frame_number;
 	};
 }
\ No newline at end of file
@@ -4,7 +4,13 @@
 
 namespace DoDo {
 	FSlateVulkanTexture::FSlateVulkanTexture()
+		: m_bindless_index(invalid_bindless_index)
+		, m_b_owns_bindless_index(false)
+		, m_last_used_frame(0)
 	{
+		m_shader_resource = VK_NULL_HANDLE;
+		m_image._image = VK_NULL_HANDLE;
+		m_image._allocation = nullptr;
 	}
 	FSlateVulkanTexture::~FSlateVulkanTexture()
 	{
@@ -22,12 +22,43 @@ namespace DoDo {
 
 		void set_image(const AllocatedImage& allocated_image);
 
+		const AllocatedImage& get_image() const { return m_image; }
+
 		void set_shader_resource(VkImageView image_view);
 
+		/*
+		 * slot of the image view in the renderer's bindless texture array
+		 * @param b_owns_bindless_index false if the slot belongs to another texture, e.g. the white texture when the array was full
+		 */
+		void set_bindless_index(uint32_t bindless_index, bool b_owns_bindless_index = true) { m_bindless_index = bindless_index; m_b_owns_bindless_index = b_owns_bindless_index; }
+
+		uint32_t get_bindless_index() const { return m_bindless_index; }
+
+		/*releasing the image frees the slot only if the texture owns it*/
+		bool owns_bindless_index() const { return m_b_owns_bindless_index && m_bindless_index != invalid_bindless_index; }
+
+		/*true if the image is uploaded and can be sampled*/
+		bool is_resident() const { return m_shader_resource != VK_NULL_HANDLE && m_bindless_index != invalid_bindless_index; }
+
+		/*called by the rendering policy for every batch drawn with the texture*/
+		void mark_used(uint64_t frame_number) { m_last_used_frame = frame_number; }
+
+		uint64_t get_last_used_frame() const { return m_last_used_frame; }
+
+		/*the texture has no slot until its upload finished or after its image was released*/
+		static constexpr uint32_t invalid_bindless_index = UINT32_MAX;
+
 		//void set_descriptor_set(VkDescriptorSet descriptor_set);
 	private:
 		AllocatedImage m_image;	
 
+		uint32_t m_bindless_index;
+
+		bool m_b_owns_bindless_index;
+
+		/*frame number of the last draw, the texture manager releases the least recently drawn images first*/
+		uint64_t m_last_used_frame;
+
 		//VkDescriptorSet m_descriptor_set;//every texture have one descriptor
 	};
 }
\ No newline at end of file
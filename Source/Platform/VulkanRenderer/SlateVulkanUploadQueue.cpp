@@ -0,0 +1,339 @@
+#include <PreCompileHeader.h>
+
+#include "SlateVulkanUploadQueue.h"
+
+#include "VulkanInitializers.h"
+
+namespace DoDo
+{
+	//batches recording or in flight at the same time
+	static constexpr uint32_t num_upload_batches = 3;
+
+	//buffer image copies need the offset to be a multiple of the texel size
+	static constexpr uint64_t staging_alignment = 16;
+
+	FSlateVulkanUploadQueue::FSlateVulkanUploadQueue(VkDevice device, VmaAllocator allocator, VkQueue queue, uint32_t queue_family_index, uint32_t staging_ring_size)
+		: m_device(device)
+		, m_allocator(allocator)
+		, m_queue(queue)
+		, m_recording_batch_index(-1)
+		, m_staging_data(nullptr)
+		, m_staging_ring_size(staging_ring_size)
+		, m_staging_head(0)
+		, m_staging_tail(0)
+		, m_num_pending_uploads(0)
+	{
+		VkCommandPoolCreateInfo pool_info = command_pool_create_info(queue_family_index, VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT);
+		vkCreateCommandPool(m_device, &pool_info, nullptr, &m_command_pool);
+
+		m_batches.resize(num_upload_batches);
+		for(FUploadBatch& batch : m_batches)
+		{
+			VkCommandBufferAllocateInfo cmd_alloc_info = command_buffer_allocate_info(m_command_pool, 1);
+			vkAllocateCommandBuffers(m_device, &cmd_alloc_info, &batch.m_command_buffer);
+
+			VkFenceCreateInfo batch_fence_info = fence_create_info(0);
+			vkCreateFence(m_device, &batch_fence_info, nullptr, &batch.m_fence);
+
+			batch.m_staging_end = 0;
+		}
+
+		VkBufferCreateInfo buffer_info = {};
+		buffer_info.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+		buffer_info.size = m_staging_ring_size;
+		buffer_info.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+
+		//keep it mapped, the pixels are written straight into the ring
+		VmaAllocationCreateInfo vma_allocation_info = {};
+		vma_allocation_info.usage = VMA_MEMORY_USAGE_CPU_ONLY;
+		vma_allocation_info.flags = VMA_ALLOCATION_CREATE_MAPPED_BIT;
+
+		VmaAllocationInfo allocation_info = {};
+		vmaCreateBuffer(m_allocator, &buffer_info, &vma_allocation_info, &m_staging_buffer.m_buffer, &m_staging_buffer.m_allocation, &allocation_info);
+
+		m_staging_data = (uint8_t*)allocation_info.pMappedData;
+	}
+
+	FSlateVulkanUploadQueue::~FSlateVulkanUploadQueue()
+	{
+	}
+
+	void FSlateVulkanUploadQueue::upload_image(VkImage image, uint32_t width, uint32_t height, const uint8_t* data, bool b_keep_contents, std::function<void()>&& on_complete)
+	{
+		const uint64_t size = (uint64_t)width * height * 4;
+
+		VkBuffer staging_buffer = m_staging_buffer.m_buffer;
+		uint64_t staging_offset = 0;
+
+		AllocatedBuffer dedicated_staging_buffer;
+
+		if(size + staging_alignment > m_staging_ring_size)
+		{
+			VkBufferCreateInfo buffer_info = {};
+			buffer_info.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+			buffer_info.size = size;
+			buffer_info.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+
+			VmaAllocationCreateInfo vma_allocation_info = {};
+			vma_allocation_info.usage = VMA_MEMORY_USAGE_CPU_ONLY;
+			vma_allocation_info.flags = VMA_ALLOCATION_CREATE_MAPPED_BIT;
+
+			VmaAllocationInfo allocation_info = {};
+			vmaCreateBuffer(m_allocator, &buffer_info, &vma_allocation_info, &dedicated_staging_buffer.m_buffer, &dedicated_staging_buffer.m_allocation, &allocation_info);
+
+			std::memcpy(allocation_info.pMappedData, data, size);
+			vmaFlushAllocation(m_allocator, dedicated_staging_buffer.m_allocation, 0, size);
+
+			staging_buffer = dedicated_staging_buffer.m_buffer;
+		}
+		else
+		{
+			//allocate before the batch is picked, making room may submit the recording batch
+			staging_offset = allocate_staging(size);
+
+			std::memcpy(m_staging_data + staging_offset, data, size);
+			vmaFlushAllocation(m_allocator, m_staging_buffer.m_allocation, staging_offset, size);
+		}
+
+		FUploadBatch& batch = get_recording_batch();
+
+		if(dedicated_staging_buffer.m_buffer != VK_NULL_HANDLE)
+		{
+			batch.m_dedicated_staging_buffers.push_back(dedicated_staging_buffer);
+		}
+		else
+		{
+			batch.m_staging_end = m_staging_head;
+		}
+
+		VkCommandBuffer cmd = batch.m_command_buffer;
+
+		VkImageSubresourceRange range;//tell what part of the image we will transform
+		range.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+		range.baseMipLevel = 0;
+		range.levelCount = 1;
+		range.baseArrayLayer = 0;
+		range.layerCount = 1;
+
+		VkImageMemoryBarrier imageBarrier_toTransfer = {};
+		imageBarrier_toTransfer.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+
+		//an uploaded image keeps its pixels, the barrier also waits for the draws submitted before that still read it
+		imageBarrier_toTransfer.oldLayout = b_keep_contents ? VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL : VK_IMAGE_LAYOUT_UNDEFINED;
+		imageBarrier_toTransfer.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+		imageBarrier_toTransfer.image = image;
+		imageBarrier_toTransfer.subresourceRange = range;
+
+		imageBarrier_toTransfer.srcAccessMask = b_keep_contents ? VK_ACCESS_SHADER_READ_BIT : 0;
+		imageBarrier_toTransfer.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+
+		//barrier the image into the transfer-receive layout
+		vkCmdPipelineBarrier(cmd, b_keep_contents ? VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT : VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, &imageBarrier_toTransfer);
+
+		VkBufferImageCopy copyRegion = {};
+		copyRegion.bufferOffset = staging_offset;
+		copyRegion.bufferRowLength = 0;
+		copyRegion.bufferImageHeight = 0;
+
+		copyRegion.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+		copyRegion.imageSubresource.mipLevel = 0;
+		copyRegion.imageSubresource.baseArrayLayer = 0;
+		copyRegion.imageSubresource.layerCount = 1;
+		copyRegion.imageExtent = { width, height, 1 };
+
+		//copy the buffer into the image
+		vkCmdCopyBufferToImage(cmd, staging_buffer, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &copyRegion);
+
+		//to shader readable layout
+		VkImageMemoryBarrier imageBarrier_toReadable = imageBarrier_toTransfer;
+
+		imageBarrier_toReadable.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+		imageBarrier_toReadable.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+
+		imageBarrier_toReadable.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+		imageBarrier_toReadable.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+
+		//barrier the image into the shader readable layout
+		vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0, 0, nullptr, 0, nullptr, 1, &imageBarrier_toReadable);
+
+		batch.m_completions.push_back(std::move(on_complete));
+
+		++m_num_pending_uploads;
+	}
+
+	void FSlateVulkanUploadQueue::submit()
+	{
+		if(m_recording_batch_index == -1)
+		{
+			return;
+		}
+
+		FUploadBatch& batch = m_batches[m_recording_batch_index];
+
+		vkEndCommandBuffer(batch.m_command_buffer);
+
+		VkSubmitInfo submit = submit_info(&batch.m_command_buffer);
+
+		vkQueueSubmit(m_queue, 1, &submit, batch.m_fence);
+
+		m_in_flight_batches.push_back((uint32_t)m_recording_batch_index);
+
+		m_recording_batch_index = -1;
+	}
+
+	void FSlateVulkanUploadQueue::process_completed_uploads()
+	{
+		//the batches finish in submission order on the queue
+		while(!m_in_flight_batches.empty() && vkGetFenceStatus(m_device, m_batches[m_in_flight_batches.front()].m_fence) == VK_SUCCESS)
+		{
+			const uint32_t batch_index = m_in_flight_batches.front();
+			m_in_flight_batches.pop_front();
+
+			complete_batch(m_batches[batch_index]);
+		}
+	}
+
+	void FSlateVulkanUploadQueue::wait_for_uploads()
+	{
+		submit();
+
+		while(!m_in_flight_batches.empty())
+		{
+			wait_for_oldest_batch();
+		}
+	}
+
+	void FSlateVulkanUploadQueue::destroy()
+	{
+		for(FUploadBatch& batch : m_batches)
+		{
+			for(AllocatedBuffer& dedicated_staging_buffer : batch.m_dedicated_staging_buffers)
+			{
+				vmaDestroyBuffer(m_allocator, dedicated_staging_buffer.m_buffer, dedicated_staging_buffer.m_allocation);
+			}
+			batch.m_dedicated_staging_buffers.clear();
+
+			vkDestroyFence(m_device, batch.m_fence, nullptr);
+		}
+
+		vkDestroyCommandPool(m_device, m_command_pool, nullptr);
+
+		vmaDestroyBuffer(m_allocator, m_staging_buffer.m_buffer, m_staging_buffer.m_allocation);
+
+		m_staging_data = nullptr;
+	}
+
+	FSlateVulkanUploadQueue::FUploadBatch& FSlateVulkanUploadQueue::get_recording_batch()
+	{
+		if(m_recording_batch_index != -1)
+		{
+			return m_batches[m_recording_batch_index];
+		}
+
+		//every batch is in flight, the oldest one is reused
+		if(m_in_flight_batches.size() == m_batches.size())
+		{
+			wait_for_oldest_batch();
+		}
+
+		for(uint32_t batch_index = 0; batch_index < m_batches.size(); ++batch_index)
+		{
+			FUploadBatch& batch = m_batches[batch_index];
+
+			if(std::find(m_in_flight_batches.begin(), m_in_flight_batches.end(), batch_index) == m_in_flight_batches.end())
+			{
+				VkCommandBufferBeginInfo cmd_begin_info = command_buffer_begin_info(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);
+				vkBeginCommandBuffer(batch.m_command_buffer, &cmd_begin_info);
+
+				batch.m_staging_end = m_staging_head;
+
+				m_recording_batch_index = (int32_t)batch_index;
+
+				return batch;
+			}
+		}
+
+		//not reached, at most all but one batch are in flight here
+		return m_batches[0];
+	}
+
+	uint64_t FSlateVulkanUploadQueue::allocate_staging(uint64_t size)
+	{
+		const uint64_t aligned_size = (size + staging_alignment - 1) & ~(staging_alignment - 1);
+
+		while(true)
+		{
+			//an empty ring starts over at its beginning, so any size up to the ring size fits
+			if(m_staging_head == m_staging_tail)
+			{
+				m_staging_head = m_staging_tail = (m_staging_head + m_staging_ring_size - 1) / m_staging_ring_size * m_staging_ring_size;
+			}
+
+			uint64_t offset = m_staging_head % m_staging_ring_size;
+
+			//an allocation never wraps, the rest of the ring is skipped instead
+			const uint64_t skipped_size = offset + aligned_size > m_staging_ring_size ? m_staging_ring_size - offset : 0;
+
+			if(m_staging_head + skipped_size + aligned_size - m_staging_tail <= m_staging_ring_size)
+			{
+				m_staging_head += skipped_size;
+				offset = m_staging_head % m_staging_ring_size;
+
+				m_staging_head += aligned_size;
+
+				return offset;
+			}
+
+			//the ring is full, the recording batch has to go to the gpu before its part can be reused
+			if(m_in_flight_batches.empty())
+			{
+				submit();
+			}
+
+			wait_for_oldest_batch();
+		}
+	}
+
+	void FSlateVulkanUploadQueue::wait_for_oldest_batch()
+	{
+		if(m_in_flight_batches.empty())
+		{
+			return;
+		}
+
+		const uint32_t batch_index = m_in_flight_batches.front();
+		m_in_flight_batches.pop_front();
+
+		FUploadBatch& batch = m_batches[batch_index];
+
+		vkWaitForFences(m_device, 1, &batch.m_fence, true, UINT64_MAX);
+
+		complete_batch(batch);
+	}
+
+	void FSlateVulkanUploadQueue::complete_batch(FUploadBatch& batch)
+	{
+		vkResetFences(m_device, 1, &batch.m_fence);
+
+		vkResetCommandBuffer(batch.m_command_buffer, 0);
+
+		m_staging_tail = std::max(m_staging_tail, batch.m_staging_end);
+
+		for(AllocatedBuffer& dedicated_staging_buffer : batch.m_dedicated_staging_buffers)
+		{
+			vmaDestroyBuffer(m_allocator, dedicated_staging_buffer.m_buffer, dedicated_staging_buffer.m_allocation);
+		}
+		batch.m_dedicated_staging_buffers.clear();
+
+		//the callbacks may record new uploads, so they run on a moved out list
+		std::vector<std::function<void()>> completions = std::move(batch.m_completions);
+		batch.m_completions.clear();
+
+		m_num_pending_uploads -= (uint32_t)completions.size();
+
+		for(std::function<void()>& completion : completions)
+		{
+			completion();
+		}
+	}
+}
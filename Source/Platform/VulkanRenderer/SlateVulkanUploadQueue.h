@@ -0,0 +1,102 @@
+#pragma once
+
+#include <Vulkan/vulkan.h>
+
+#include <deque>
+#include <functional>
+
+#include "Utils.h"//AllocatedBuffer depends on it
+
+namespace DoDo
+{
+	/*
+	 * gathers texture uploads into one command buffer and one persistently mapped staging ring
+	 * submit() hands the recorded uploads to the gpu without waiting, the completion callbacks run from process_completed_uploads() once the fence of their batch signaled
+	 * uploads use the graphics queue, so draws submitted later see the finished images
+	 */
+	class FSlateVulkanUploadQueue
+	{
+	public:
+		FSlateVulkanUploadQueue(VkDevice device, VmaAllocator allocator, VkQueue queue, uint32_t queue_family_index, uint32_t staging_ring_size);
+
+		~FSlateVulkanUploadQueue();
+
+		/*
+		 * records the copy of the pixels into the image, the pixels are copied to the staging ring right away
+		 *
+		 * @param b_keep_contents true if the image was uploaded before, the copy then waits for the draws reading it
+		 * @param on_complete runs when the gpu finished the copy, the image is in shader read layout then
+		 */
+		void upload_image(VkImage image, uint32_t width, uint32_t height, const uint8_t* data, bool b_keep_contents, std::function<void()>&& on_complete);
+
+		/*submits the recorded uploads, doesn't wait*/
+		void submit();
+
+		/*runs the completion callbacks of the finished batches, doesn't wait*/
+		void process_completed_uploads();
+
+		/*submits the recorded uploads and blocks until all of them finished*/
+		void wait_for_uploads();
+
+		/*@return uploads recorded or in flight whose callbacks haven't run yet*/
+		uint32_t get_num_pending_uploads() const { return m_num_pending_uploads; }
+
+		/*the device must be idle*/
+		void destroy();
+	private:
+		struct FUploadBatch
+		{
+			VkCommandBuffer m_command_buffer;
+
+			VkFence m_fence;
+
+			/*the staging ring is free up to here once the batch finished*/
+			uint64_t m_staging_end;
+
+			/*textures larger than the ring get their own staging buffer*/
+			std::vector<AllocatedBuffer> m_dedicated_staging_buffers;
+
+			std::vector<std::function<void()>> m_completions;
+		};
+
+		/*@return the batch that records the next upload, begins its command buffer if needed*/
+		FUploadBatch& get_recording_batch();
+
+		/*@return byte offset of size bytes in the staging ring, waits for finished batches if the ring is full*/
+		uint64_t allocate_staging(uint64_t size);
+
+		/*waits for the oldest batch in flight and runs its callbacks*/
+		void wait_for_oldest_batch();
+
+		void complete_batch(FUploadBatch& batch);
+
+		VkDevice m_device;
+
+		VmaAllocator m_allocator;
+
+		VkQueue m_queue;
+
+		VkCommandPool m_command_pool;
+
+		std::vector<FUploadBatch> m_batches;
+
+		/*index of the batch that records, -1 if none*/
+		int32_t m_recording_batch_index;
+
+		/*submitted batches, oldest first*/
+		std::deque<uint32_t> m_in_flight_batches;
+
+		AllocatedBuffer m_staging_buffer;
+
+		uint8_t* m_staging_data;
+
+		uint64_t m_staging_ring_size;
+
+		/*free running byte counters, head - tail is the part of the ring in use*/
+		uint64_t m_staging_head;
+
+		uint64_t m_staging_tail;
+
+		uint32_t m_num_pending_uploads;
+	};
+}
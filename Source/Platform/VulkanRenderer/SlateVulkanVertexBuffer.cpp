@@ -7,6 +7,7 @@ namespace DoDo
 	FSlateVulkanVertexBuffer::FSlateVulkanVertexBuffer()
 		: m_buffer_size(0)
 		, m_stride(0)
+		, m_mapped_data(nullptr)
 	{
 	}
 
@@ -30,6 +31,8 @@ namespace DoDo
 	void FSlateVulkanVertexBuffer::destroy_buffer(VmaAllocator& allocator)
 	{
 		vmaDestroyBuffer(allocator, m_buffer.m_buffer, m_buffer.m_allocation);
+
+		m_mapped_data = nullptr;
 	}
 
 	void FSlateVulkanVertexBuffer::upload_mesh(VmaAllocator& allocator, uint32_t size)
@@ -47,9 +50,14 @@ namespace DoDo
 		//let the vma library know that this data should be writeable by cpu, but also readable by gpu
 		VmaAllocationCreateInfo vma_allocation_info = {};
 		vma_allocation_info.usage = VMA_MEMORY_USAGE_CPU_TO_GPU;
+		//keep it mapped, so there is no map and unmap every frame
+		vma_allocation_info.flags = VMA_ALLOCATION_CREATE_MAPPED_BIT;
 
 		//allocate the buffer
-		vmaCreateBuffer(allocator, &buffer_info, &vma_allocation_info, &m_buffer.m_buffer, &m_buffer.m_allocation, nullptr);
+		VmaAllocationInfo allocation_info = {};
+		vmaCreateBuffer(allocator, &buffer_info, &vma_allocation_info, &m_buffer.m_buffer, &m_buffer.m_allocation, &allocation_info);
+
+		m_mapped_data = (uint8_t*)allocation_info.pMappedData;
 
 		//copy cpu to gpu
 		//void* data;
@@ -60,57 +68,30 @@ namespace DoDo
 		//vmaUnmapMemory(allocator, m_vertex_buffer.m_buffer.m_allocation);
 		//---------------------------Vertex Buffer Create---------------------------
 	}
-	void* FSlateVulkanVertexBuffer::lock(VmaAllocator& allocator, uint32_t offset)
-	{
-		void* data;
-		vmaMapMemory(allocator, m_buffer.m_allocation, &data);
-
-		//memcpy(data, vertex_array.data(), vertex_array.size() * sizeof(FSlateVertex));
-
-		//vmaUnmapMemory(allocator, m_vertex_buffer.m_buffer.m_allocation);
-		return (void*)((uint8_t*)data + offset);//todo:one byte offset
-	}
-	void FSlateVulkanVertexBuffer::unlock(VmaAllocator& allocator)
+	void FSlateVulkanVertexBuffer::flush(VmaAllocator& allocator, uint32_t offset, uint32_t size)
 	{
-		vmaUnmapMemory(allocator, m_buffer.m_allocation);
+		vmaFlushAllocation(allocator, m_buffer.m_allocation, offset, size);
 	}
 
 	/*resize the buffer to the passed in size, preserves internal data*/
-	void FSlateVulkanVertexBuffer::resize_buffer(VmaAllocator& allocator, uint32_t new_size)
+	void FSlateVulkanVertexBuffer::resize_buffer(VmaAllocator& allocator, uint32_t new_size, std::vector<AllocatedBuffer>& retired_buffers)
 	{
 		//buffer should be created first
 
 		if (new_size > m_buffer_size)
 		{
-			//todo:first to copy the already have buffer's data, then copy to new buffer
-
-			uint8_t* saved_vertices = nullptr;
-
-			{
-				void* vertices = lock(allocator, 0);
-
-				saved_vertices = new uint8_t[m_buffer_size];
-				std::memcpy(saved_vertices, vertices, m_buffer_size);
-
-				unlock(allocator);
-			}
-
-			vmaDestroyBuffer(allocator, m_buffer.m_buffer, m_buffer.m_allocation);
-			if (saved_vertices)
-			{
-				//copy to new buffer
-				upload_mesh(allocator, new_size);//create new buffer
-
-				void* vertices = lock(allocator, 0);
+			//the old buffer is still mapped, copy straight from it into the new one
+			uint8_t* old_mapped_data = m_mapped_data;
+			AllocatedBuffer old_buffer = m_buffer;
 
-				std::memcpy(vertices, saved_vertices, m_buffer_size);
+			upload_mesh(allocator, new_size);//create new buffer
 
-				unlock(allocator);
+			std::memcpy(m_mapped_data, old_mapped_data, m_buffer_size);
 
-				m_buffer_size = new_size;
-			}
+			//windows drawn before the resize bound the old buffer
+			retired_buffers.push_back(old_buffer);
 
-			delete[] saved_vertices;
+			m_buffer_size = new_size;
 		}
 	}
 }
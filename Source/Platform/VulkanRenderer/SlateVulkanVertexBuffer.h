@@ -10,6 +10,7 @@ namespace DoDo
 	//class FSlateVertexArray;
 	/*
 	 * vertex buffer containing all slate vertices
+	 * the buffer stays mapped for it's whole life time, the batch data is written straight into it
 	 */
 	class FSlateVulkanVertexBuffer
 	{
@@ -26,11 +27,17 @@ namespace DoDo
 
 		void upload_mesh(VmaAllocator& allocator, uint32_t size);
 
-		void* lock(VmaAllocator& allocator, uint32_t offset);
-		
-		void unlock(VmaAllocator& allocator);
+		/*@return the persistently mapped memory at offset bytes*/
+		void* get_mapped_data(uint32_t offset) const { return m_mapped_data + offset; }
 
-		void resize_buffer(VmaAllocator& allocator, uint32_t new_size);
+		/*makes the written range visible to the gpu, does nothing for host coherent memory*/
+		void flush(VmaAllocator& allocator, uint32_t offset, uint32_t size);
+
+		/*
+		 * grows the buffer and keeps its contents
+		 * commands recorded earlier in the frame may still read the old buffer, so it is added to retired buffers instead of destroyed
+		 */
+		void resize_buffer(VmaAllocator& allocator, uint32_t new_size, std::vector<AllocatedBuffer>& retired_buffers);
 
 		uint32_t get_buffer_size() const { return m_buffer_size; }
 
@@ -42,6 +49,8 @@ namespace DoDo
 
 		AllocatedBuffer m_buffer;//vulkan buffer
 
+		uint8_t* m_mapped_data;
+
 		/*hidden copy methods*/
 		FSlateVulkanVertexBuffer(const FSlateVulkanVertexBuffer&);
 		void operator=(const FSlateVulkanVertexBuffer&);
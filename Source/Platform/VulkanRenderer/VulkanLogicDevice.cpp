@@ -62,9 +62,11 @@ namespace DoDo {
 		indexing_features.pNext = nullptr;
 		indexing_features.descriptorBindingSampledImageUpdateAfterBind = true;
 		indexing_features.descriptorBindingUniformBufferUpdateAfterBind = true;//todo:need to query
+		indexing_features.descriptorBindingPartiallyBound = true;//bindless texture array is filled as textures are created
 
 		VkPhysicalDeviceFeatures device_features{};
 		device_features.samplerAnisotropy = VK_TRUE;
+		device_features.shaderSampledImageArrayDynamicIndexing = VK_TRUE;//bindless texture index comes from a push constant
 
 		//------logic device create information------
 		VkDeviceCreateInfo create_info{};
@@ -125,12 +127,14 @@ namespace DoDo {
 
 		VkPhysicalDeviceFeatures device_features{};
 		device_features.samplerAnisotropy = VK_TRUE;
+		device_features.shaderSampledImageArrayDynamicIndexing = VK_TRUE;//bindless texture index comes from a push constant
 
 		VkPhysicalDeviceDescriptorIndexingFeaturesEXT indexing_features{};
 		indexing_features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES_EXT;
 		indexing_features.pNext = nullptr;
 		indexing_features.descriptorBindingSampledImageUpdateAfterBind = true;
 		indexing_features.descriptorBindingUniformBufferUpdateAfterBind = true;//todo:need to query
+		indexing_features.descriptorBindingPartiallyBound = true;//bindless texture array is filled as textures are created
 
 		//------logic device create information------
 		VkDeviceCreateInfo create_info{};
@@ -0,0 +1,159 @@
+#include <PreCompileHeader.h>
+
+#include "VulkanPipelineCache.h"
+
+namespace DoDo {
+	FVulkanPipelineCache::FVulkanPipelineCache(VkDevice device, VkPhysicalDevice physical_device, const DoDoUtf8String& file_path)
+		: m_device(device)
+		, m_pipeline_cache(VK_NULL_HANDLE)
+		, m_file_path(file_path)
+		, m_loaded_size(0)
+		, m_b_loaded_from_file(false)
+	{
+		std::vector<uint8_t> initial_data;
+
+		std::ifstream file(file_path.c_str(), std::ios::binary | std::ios::ate);
+
+		if (file.is_open())
+		{
+			initial_data.resize((size_t)file.tellg());
+			file.seekg(0);
+			file.read((char*)initial_data.data(), initial_data.size());
+
+			if (!file)
+			{
+				initial_data.clear();
+			}
+		}
+
+		VkPhysicalDeviceProperties properties;
+		vkGetPhysicalDeviceProperties(physical_device, &properties);
+
+		//a cache of another gpu or driver is ignored, the driver would reject it anyway
+		if (!initial_data.empty() && !is_compatible(initial_data, properties))
+		{
+			std::cout << "pipeline cache " << file_path.c_str() << " belongs to another device, starting an empty cache" << std::endl;
+
+			initial_data.clear();
+		}
+
+		VkPipelineCacheCreateInfo pipeline_cache_create_info = {};
+		pipeline_cache_create_info.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+		pipeline_cache_create_info.initialDataSize = initial_data.size();
+		pipeline_cache_create_info.pInitialData = initial_data.empty() ? nullptr : initial_data.data();
+
+		if (vkCreatePipelineCache(m_device, &pipeline_cache_create_info, nullptr, &m_pipeline_cache) != VK_SUCCESS && !initial_data.empty())
+		{
+			//corrupted data, try again without it
+			pipeline_cache_create_info.initialDataSize = 0;
+			pipeline_cache_create_info.pInitialData = nullptr;
+
+			initial_data.clear();
+
+			if (vkCreatePipelineCache(m_device, &pipeline_cache_create_info, nullptr, &m_pipeline_cache) != VK_SUCCESS)
+			{
+				std::cout << "failed to create pipeline cache!" << std::endl;
+
+				m_pipeline_cache = VK_NULL_HANDLE;
+			}
+		}
+
+		m_loaded_size = initial_data.size();
+		m_b_loaded_from_file = !initial_data.empty();
+	}
+
+	FVulkanPipelineCache::~FVulkanPipelineCache()
+	{
+	}
+
+	bool FVulkanPipelineCache::save()
+	{
+		if (m_pipeline_cache == VK_NULL_HANDLE)
+		{
+			return false;
+		}
+
+		size_t data_size = 0;
+		if (vkGetPipelineCacheData(m_device, m_pipeline_cache, &data_size, nullptr) != VK_SUCCESS || data_size == 0)
+		{
+			return false;
+		}
+
+		//the pipelines of this launch were all in the loaded data
+		if (m_b_loaded_from_file && data_size == m_loaded_size)
+		{
+			return true;
+		}
+
+		std::vector<uint8_t> data(data_size);
+		if (vkGetPipelineCacheData(m_device, m_pipeline_cache, &data_size, data.data()) != VK_SUCCESS)
+		{
+			return false;
+		}
+
+		const std::filesystem::path final_path(m_file_path.c_str());
+		const std::filesystem::path temporary_path(std::string(m_file_path.c_str()) + ".tmp");
+
+		std::error_code error;
+		std::filesystem::create_directories(final_path.parent_path(), error);
+
+		{
+			std::ofstream file(temporary_path, std::ios::binary | std::ios::trunc);
+
+			if (!file)
+			{
+				return false;
+			}
+
+			file.write((const char*)data.data(), data_size);
+
+			if (!file)
+			{
+				file.close();
+				std::filesystem::remove(temporary_path, error);
+				return false;
+			}
+		}
+
+		//a crash while writing leaves the old file
+		std::filesystem::rename(temporary_path, final_path, error);
+
+		if (error)
+		{
+			std::filesystem::remove(temporary_path, error);
+			return false;
+		}
+
+		m_loaded_size = data_size;
+		m_b_loaded_from_file = true;
+
+		return true;
+	}
+
+	void FVulkanPipelineCache::destroy()
+	{
+		if (m_pipeline_cache != VK_NULL_HANDLE)
+		{
+			vkDestroyPipelineCache(m_device, m_pipeline_cache, nullptr);
+
+			m_pipeline_cache = VK_NULL_HANDLE;
+		}
+	}
+
+	bool FVulkanPipelineCache::is_compatible(const std::vector<uint8_t>& data, const VkPhysicalDeviceProperties& properties)
+	{
+		if (data.size() < sizeof(VkPipelineCacheHeaderVersionOne))
+		{
+			return false;
+		}
+
+		VkPipelineCacheHeaderVersionOne header;
+		std::memcpy(&header, data.data(), sizeof(VkPipelineCacheHeaderVersionOne));
+
+		return header.headerSize >= sizeof(VkPipelineCacheHeaderVersionOne)
+			&& header.headerVersion == VK_PIPELINE_CACHE_HEADER_VERSION_ONE
+			&& header.vendorID == properties.vendorID
+			&& header.deviceID == properties.deviceID
+			&& std::memcmp(header.pipelineCacheUUID, properties.pipelineCacheUUID, VK_UUID_SIZE) == 0;
+	}
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include "Core/String/DoDoString.h"//m_file_path depends on it
+
+namespace DoDo {
+	/*
+	 * VkPipelineCache that is loaded from and saved to a file, so the driver doesn't compile the shaders of the pipelines again every launch
+	 * the data of the file is only used when its header matches the vendor, device and cache uuid of the gpu, other data starts an empty cache
+	 */
+	class FVulkanPipelineCache
+	{
+	public:
+		FVulkanPipelineCache(VkDevice device, VkPhysicalDevice physical_device, const DoDoUtf8String& file_path);
+
+		~FVulkanPipelineCache();
+
+		FVulkanPipelineCache(const FVulkanPipelineCache&) = delete;
+
+		FVulkanPipelineCache& operator=(const FVulkanPipelineCache&) = delete;
+
+		VkPipelineCache get_handle() const { return m_pipeline_cache; }
+
+		/*true if the cache was created from the data of the file*/
+		bool was_loaded_from_file() const { return m_b_loaded_from_file; }
+
+		/*
+		 * writes the cache data to the file, skipped if nothing was added since it was loaded
+		 *
+		 * @return false if the file couldn't be written
+		 */
+		bool save();
+
+		/*the pipelines created with the cache may still be alive*/
+		void destroy();
+	private:
+		/*
+		 * @return true if the data starts with a pipeline cache header of this gpu
+		 */
+		static bool is_compatible(const std::vector<uint8_t>& data, const VkPhysicalDeviceProperties& properties);
+
+		VkDevice m_device;
+
+		VkPipelineCache m_pipeline_cache;
+
+		DoDoUtf8String m_file_path;
+
+		/*size of the data the cache was created with*/
+		size_t m_loaded_size;
+
+		bool m_b_loaded_from_file;
+	};
+}
@@ -21,7 +21,7 @@ namespace DoDo {
 		m_pipeline_layout = VK_NULL_HANDLE;
 		m_pipeline = VK_NULL_HANDLE;
 		m_render_pass = VK_NULL_HANDLE;//todo:remove this
-		
+		m_pipeline_cache = VK_NULL_HANDLE;
 	}
 	GraphicsPipelineStateObject::~GraphicsPipelineStateObject()
 	{
@@ -200,8 +200,8 @@ namespace DoDo {
 		//------push constant------
 		VkPushConstantRange push_constant;
 		push_constant.offset = 0;
-		push_constant.size = sizeof(glm::mat4);
-		push_constant.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
+		push_constant.size = sizeof(glm::mat4) + sizeof(uint32_t);//view projection matrix, then the bindless texture index for the pixel shader
+		push_constant.stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
 
 		m_pipeline_layout_create_info.pPushConstantRanges = &push_constant;
 		m_pipeline_layout_create_info.pushConstantRangeCount = 1;
@@ -294,12 +294,17 @@ namespace DoDo {
 		m_pipeline_info.basePipelineIndex = -1;
 		//------pso------
 		
-		if (vkCreateGraphicsPipelines(device, VK_NULL_HANDLE, 1, &m_pipeline_info, nullptr, &m_pipeline) != VK_SUCCESS)
+		if (vkCreateGraphicsPipelines(device, m_pipeline_cache, 1, &m_pipeline_info, nullptr, &m_pipeline) != VK_SUCCESS)
 		{
 			std::cout << "failed to create graphics pipeline!" << std::endl;
 		}
 	}
 
+	void GraphicsPipelineStateObject::set_pipeline_cache(void* pipeline_cache)
+	{
+		m_pipeline_cache = *(VkPipelineCache*)pipeline_cache;
+	}
+
 	void GraphicsPipelineStateObject::set_descriptor_set(uint32_t set_counts, void* descriptor_set)
 	{
 		m_pipeline_layout_create_info.setLayoutCount = set_counts;
@@ -27,6 +27,8 @@ namespace DoDo {
 
 		virtual void set_render_pass(void* render_pass) override;
 
+		virtual void set_pipeline_cache(void* pipeline_cache) override;
+
 		virtual void finalize(void* logic_device) override;
 
 		virtual void set_descriptor_set(uint32_t set_counts, void* descriptor_set) override;
@@ -51,5 +53,7 @@ namespace DoDo {
 		VkPipelineVertexInputStateCreateInfo m_vertex_input_state_create_info;
 
 		VkRenderPass m_render_pass;//todo:remove this
+
+		VkPipelineCache m_pipeline_cache;
 	};
 }
@@ -67,11 +67,44 @@ namespace DoDo {
 		return available_formats[0];
 	}
 
-	static VkPresentModeKHR choose_swap_present_mode(std::vector<VkPresentModeKHR> present_modes)
+	static VkPresentModeKHR choose_swap_present_mode(const std::vector<VkPresentModeKHR>& present_modes, VkPresentModeKHR preferred_present_mode)
 	{
+		auto is_supported = [&](VkPresentModeKHR present_mode)
+		{
+			return std::find(present_modes.begin(), present_modes.end(), present_mode) != present_modes.end();
+		};
+
+		if (is_supported(preferred_present_mode))
+		{
+			return preferred_present_mode;
+		}
+
+		//mailbox is the next lowest latency mode and doesn't tear
+		if (preferred_present_mode == VK_PRESENT_MODE_IMMEDIATE_KHR && is_supported(VK_PRESENT_MODE_MAILBOX_KHR))
+		{
+			return VK_PRESENT_MODE_MAILBOX_KHR;
+		}
+
+		//every surface supports fifo
 		return VK_PRESENT_MODE_FIFO_KHR;
 	}
 
+	static uint32_t choose_swap_image_count(const VkSurfaceCapabilitiesKHR& capabilities_khr, VkPresentModeKHR present_mode)
+	{
+		//fifo queues every image, with frame pacing the cpu starts late enough that the extra image only adds a frame of lag
+		//mailbox needs the extra image to replace the queued one while another is on screen
+		const bool b_fifo = present_mode == VK_PRESENT_MODE_FIFO_KHR || present_mode == VK_PRESENT_MODE_FIFO_RELAXED_KHR;
+
+		uint32_t image_count = capabilities_khr.minImageCount + ((b_fifo && SLATE_FRAME_PACING) ? 0 : 1);
+
+		if (capabilities_khr.maxImageCount > 0 && image_count > capabilities_khr.maxImageCount)
+		{
+			image_count = capabilities_khr.maxImageCount;
+		}
+
+		return image_count;
+	}
+
 	static VkExtent2D choose_swap_extent(VkSurfaceCapabilitiesKHR capabilities_khr, Window& window)
 	{
 		if (capabilities_khr.currentExtent.width != (std::numeric_limits<uint32_t>::max)()) {
@@ -116,17 +149,12 @@ namespace DoDo {
 
 		m_surface_format = choose_swap_surface_format(swap_chain_support_details.formats);
 
-		VkPresentModeKHR present_mode = choose_swap_present_mode(swap_chain_support_details.present_modes);
+		m_present_mode = choose_swap_present_mode(swap_chain_support_details.present_modes, SLATE_PRESENT_MODE);
 
 		m_extent_2d = choose_swap_extent(swap_chain_support_details.capabilities, window);
 
 		//------get image count(image just buffer)------
-		uint32_t image_count = swap_chain_support_details.capabilities.minImageCount + 1;
-
-		if (swap_chain_support_details.capabilities.maxImageCount > 0 && image_count > swap_chain_support_details.capabilities.maxImageCount)
-		{
-			image_count = swap_chain_support_details.capabilities.maxImageCount;
-		}
+		uint32_t image_count = choose_swap_image_count(swap_chain_support_details.capabilities, m_present_mode);
 		//------get image count(image just buffer)------
 
 		VkSwapchainCreateInfoKHR create_info{};
@@ -161,7 +189,10 @@ namespace DoDo {
 		
 		create_info.compositeAlpha = VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR;
 
-		create_info.clipped = VK_TRUE;
+		create_info.presentMode = m_present_mode;
+
+		//damage redraw loads the image and only draws what changed, clipped images may have lost the pixels of covered parts
+		create_info.clipped = SLATE_USE_DAMAGE_REDRAW ? VK_FALSE : VK_TRUE;
 
 		create_info.oldSwapchain = VK_NULL_HANDLE;
 
@@ -197,17 +228,12 @@ namespace DoDo {
 
 		m_surface_format = choose_swap_surface_format(swap_chain_support_details.formats);
 
-		VkPresentModeKHR present_mode = choose_swap_present_mode(swap_chain_support_details.present_modes);
+		m_present_mode = choose_swap_present_mode(swap_chain_support_details.present_modes, SLATE_PRESENT_MODE);
 
 		m_extent_2d = choose_swap_extent(swap_chain_support_details.capabilities, window);
 
 		//------get image count(image just buffer)------
-		uint32_t image_count = swap_chain_support_details.capabilities.minImageCount + 1;
-
-		if (swap_chain_support_details.capabilities.maxImageCount > 0 && image_count > swap_chain_support_details.capabilities.maxImageCount)
-		{
-			image_count = swap_chain_support_details.capabilities.maxImageCount;
-		}
+		uint32_t image_count = choose_swap_image_count(swap_chain_support_details.capabilities, m_present_mode);
 		//------get image count(image just buffer)------
 
 		VkSwapchainCreateInfoKHR create_info{};
@@ -242,7 +268,10 @@ namespace DoDo {
 
 		create_info.compositeAlpha = VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR;
 
-		create_info.clipped = VK_TRUE;
+		create_info.presentMode = m_present_mode;
+
+		//damage redraw loads the image and only draws what changed, clipped images may have lost the pixels of covered parts
+		create_info.clipped = SLATE_USE_DAMAGE_REDRAW ? VK_FALSE : VK_TRUE;
 
 		create_info.oldSwapchain = VK_NULL_HANDLE;
 
@@ -4,6 +4,14 @@
 
 #include <vulkan/vulkan.h>
 
+/*
+ * present mode the swap chains ask for, falls back to fifo when the surface doesn't support it
+ * set from the build, see SLATE_PRESENT_MODE in the cmake lists
+ */
+#ifndef SLATE_PRESENT_MODE
+#define SLATE_PRESENT_MODE VK_PRESENT_MODE_FIFO_KHR
+#endif
+
 namespace DoDo {
 	class VulkanSwapChain : public SwapChain
 	{
@@ -22,6 +30,9 @@ namespace DoDo {
 
 		virtual std::pair<uint32_t, uint32_t> get_swap_chain_extent() override;
 
+		/*the present mode the surface supported, may differ from SLATE_PRESENT_MODE*/
+		VkPresentModeKHR get_present_mode() const { return m_present_mode; }
+
 		//framebuffer connect the render pass to the VkImage rendering to
 		std::vector<VkFramebuffer> create_frame_buffer(VkDevice logic_device, VkRenderPass render_pass, DeletionQueue& deletion_queue);
 
@@ -40,7 +51,7 @@ namespace DoDo {
 
 		VkSurfaceFormatKHR m_surface_format;
 
-		//VkPresentModeKHR m_present_mode;
+		VkPresentModeKHR m_present_mode;
 
 		//image is buffer
 		std::vector<VkImage> m_swap_chain_images;
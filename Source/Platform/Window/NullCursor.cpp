@@ -0,0 +1,31 @@
+#include <PreCompileHeader.h>
+
+#include "NullCursor.h"
+
+namespace DoDo
+{
+	FNullCursor::FNullCursor()
+		: m_position(0.0f, 0.0f)
+		, m_current_type(EMouseCursor::Default)
+	{
+	}
+
+	FNullCursor::~FNullCursor()
+	{
+	}
+
+	void FNullCursor::set_position(const int32_t x, const int32_t y)
+	{
+		m_position = glm::vec2((float)x, (float)y);
+	}
+
+	void FNullCursor::set_type(const EMouseCursor::Type in_new_cursor)
+	{
+		m_current_type = in_new_cursor;
+	}
+
+	glm::vec2 FNullCursor::get_position() const
+	{
+		return m_position;
+	}
+}
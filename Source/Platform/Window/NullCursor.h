@@ -0,0 +1,28 @@
+#pragma once
+
+#include "ApplicationCore/GenericPlatform/ICursor.h"
+
+namespace DoDo
+{
+	/*a cursor without a device, the position is whatever was set last*/
+	class FNullCursor : public ICursor
+	{
+	public:
+		FNullCursor();
+
+		virtual ~FNullCursor();
+
+		virtual void set_position(const int32_t x, const int32_t y) override;
+
+		virtual void set_type(const EMouseCursor::Type in_new_cursor) override;
+
+		glm::vec2 get_position() const override;
+
+		EMouseCursor::Type get_type() const { return m_current_type; }
+
+	private:
+		glm::vec2 m_position;
+
+		EMouseCursor::Type m_current_type;
+	};
+}
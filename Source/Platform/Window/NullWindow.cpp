@@ -0,0 +1,39 @@
+#include <PreCompileHeader.h>
+
+#include "NullWindow.h"
+
+#include "ApplicationCore/GenericPlatform/GenericWindowDefinition.h"
+
+namespace DoDo {
+	FNullWindow::FNullWindow()
+		: m_position(0.0f, 0.0f)
+		, m_region_width(0)
+		, m_region_height(0)
+	{
+	}
+
+	FNullWindow::~FNullWindow()
+	{
+	}
+
+	bool FNullWindow::is_point_in_window(int32_t x, int32_t y) const
+	{
+		return x >= 0 && y >= 0 && x < m_region_width && y < m_region_height;
+	}
+
+	void FNullWindow::initialize(const std::shared_ptr<FGenericWindowDefinition>& in_definition)
+	{
+		m_definition = in_definition;
+
+		m_position = glm::vec2(in_definition->x_desired_position_on_screen, in_definition->y_desired_position_on_screen);
+		m_region_width = (int32_t)in_definition->m_width_desired_on_screen;
+		m_region_height = (int32_t)in_definition->m_height_desired_on_screen;
+	}
+
+	bool FNullWindow::is_screen_point_in_window(const glm::vec2& screen_point) const
+	{
+		const glm::vec2 local_point = screen_point - m_position;
+
+		return local_point.x >= 0.0f && local_point.y >= 0.0f && local_point.x < (float)m_region_width && local_point.y < (float)m_region_height;
+	}
+}
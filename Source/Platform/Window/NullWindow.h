@@ -0,0 +1,33 @@
+#pragma once
+
+#include "Core/Window.h"
+
+#include "glm/glm.hpp"
+
+namespace DoDo {
+	/*
+	 * a native window that only exists in memory, used by FNullApplication
+	 * it keeps the size and the position it was created with
+	 */
+	class FNullWindow : public Window
+	{
+	public:
+		FNullWindow();
+
+		virtual ~FNullWindow();
+
+		virtual bool is_point_in_window(int32_t x, int32_t y) const override;
+
+		void initialize(const std::shared_ptr<FGenericWindowDefinition>& in_definition);
+
+		/*@return true if the screen space point lies within the window*/
+		bool is_screen_point_in_window(const glm::vec2& screen_point) const;
+
+	private:
+		/*screen space position of the top left corner*/
+		glm::vec2 m_position;
+
+		int32_t m_region_width;
+		int32_t m_region_height;
+	};
+}
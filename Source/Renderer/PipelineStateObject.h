@@ -29,6 +29,9 @@ namespace DoDo {
 
 		virtual void set_render_pass(void* render_pass) = 0;
 
+		/*driver cache the pipeline is compiled through, set before finalize*/
+		virtual void set_pipeline_cache(void* pipeline_cache) = 0;
+
 		virtual void finalize(void* logic_device) = 0;
 
 		static Scope<PipelineStateObject> Create(void* logic_device);
@@ -6,6 +6,19 @@
 
 #include "Platform/VulkanRenderer/SlateVulkanRenderer.h"
 
+#include "Platform/SoftwareRenderer/SlateSoftwareRenderer.h"
+
+#include "Platform/NullRenderer/SlateNullRenderer.h"
+
+/*
+ * set from the build, see SLATE_USE_SOFTWARE_RENDERER option in the cmake lists
+ * 1: Renderer::Create returns the cpu rasterizer unless a renderer type is passed
+ * resolved here and not in the header, the option is private to the library
+ */
+#ifndef SLATE_USE_SOFTWARE_RENDERER
+#define SLATE_USE_SOFTWARE_RENDERER 0
+#endif
+
 namespace DoDo {
 	Renderer::~Renderer()
 	{
@@ -15,8 +28,23 @@ namespace DoDo {
 	{
 	}
 
-	std::shared_ptr<Renderer> Renderer::Create()
+	std::shared_ptr<Renderer> Renderer::Create(ERendererType renderer_type)
 	{
+		if (renderer_type == ERendererType::Default)
+		{
+			renderer_type = SLATE_USE_SOFTWARE_RENDERER ? ERendererType::Software : ERendererType::Vulkan;
+		}
+
+		if (renderer_type == ERendererType::Software)
+		{
+			return std::make_shared<FSlateSoftwareRenderer>();
+		}
+
+		if (renderer_type == ERendererType::Null)
+		{
+			return std::make_shared<FSlateNullRenderer>();
+		}
+
 		return std::make_shared<FSlateVulkanRenderer>();
 	}
 }
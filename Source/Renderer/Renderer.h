@@ -10,6 +10,19 @@ namespace DoDo
 	class FSlateDrawBuffer;
 	class SWindow;
 	class ISlateStyle;
+
+	/*the implementations Renderer::Create can return*/
+	enum class ERendererType : uint8_t
+	{
+		/*resolved by Renderer::Create from the SLATE_USE_SOFTWARE_RENDERER option the library was built with*/
+		Default,
+		Vulkan,
+		/*cpu rasterizer drawing into framebuffers in memory, see FSlateSoftwareRenderer*/
+		Software,
+		/*batches the draw buffers and discards them, see FSlateNullRenderer*/
+		Null
+	};
+
 	//TODO:temporarily use this renderer
 	class Renderer
 	{
@@ -26,6 +39,25 @@ namespace DoDo
 		 */
 		virtual void create_view_port(const std::shared_ptr<SWindow> in_window) = 0;
 
+		/*
+		 * creates a view port that draws the window into an image instead of presenting it, read it with read_back_view_port
+		 * the window needs no native window, a renderer that never presents creates a normal view port
+		 *
+		 * @param width, height size of the image in pixels
+		 */
+		virtual void create_offscreen_view_port(const std::shared_ptr<SWindow> in_window, uint32_t width, uint32_t height) { create_view_port(in_window); }
+
+		/*
+		 * copies the pixels of the last draw of an offscreen view port, waits for the draw if it is still running
+		 *
+		 * @param out_pixels tightly packed r8g8b8a8 rows, top row first
+		 * @return false if the window has no offscreen view port, wasn't drawn yet or the renderer can't read back
+		 */
+		virtual bool read_back_view_port(const SWindow* window, std::vector<uint8_t>& out_pixels, uint32_t& out_width, uint32_t& out_height) { return false; }
+
+		/*read_back_view_port written to a png file*/
+		virtual bool save_view_port_png(const SWindow* window, const char* file_path) { return false; }
+
 		/*
 		* loads all the resources used by the specified slate style
 		*/
@@ -38,6 +70,18 @@ namespace DoDo
 		 */
 		virtual void draw_windows(FSlateDrawBuffer& in_window_draw_buffer) = 0;
 
+		/*
+		 * the pixels of the window on screen may be gone, e.g. it was exposed, restored or resized
+		 * a renderer that only redraws what changed draws all of the window next time
+		 */
+		virtual void invalidate_view_port(const SWindow* window) {}
+
+		/*
+		 * blocks until the next frame should start, called before the platform messages are pumped
+		 * a renderer with frame pacing waits here so the input is sampled as late as possible
+		 */
+		virtual void wait_for_next_frame() {}
+
 		virtual FSlateResourceHandle get_resource_handle(const FSlateBrush& brush, glm::vec2 local_size, float draw_scale) = 0;//todo:add comment
 
 		virtual bool initialize() = 0;
@@ -46,6 +90,6 @@ namespace DoDo
 
 		virtual void destroy();
 
-		static std::shared_ptr<Renderer> Create();//transfer owner ship
+		static std::shared_ptr<Renderer> Create(ERendererType renderer_type = ERendererType::Default);//transfer owner ship
 	};
 }
\ No newline at end of file
@@ -43,6 +43,9 @@ namespace DoDo
 	void SButton::set_content_padding(TAttribute<FMargin> in_content_padding)
 	{
 		m_content_padding_attribute.Assign(*this, std::move(in_content_padding));
+
+		//the border padding combines the content padding with the press padding of the style
+		update_padding();
 	}
 
 	void SButton::set_button_style(const FButtonStyle* button_style)
@@ -54,6 +54,8 @@ namespace DoDo
 	void SBorder::set_border_back_ground_color(TAttribute<glm::vec4> in_color_and_opacity)
 	{
 		m_border_back_ground_color_attribute.Assign(*this, std::move(in_color_and_opacity));
+
+		Invalidate(EInvalidateWidgetReason::Paint);
 	}
 
 	void SBorder::set_padding(TAttribute<FMargin> in_padding)
@@ -65,6 +67,9 @@ namespace DoDo
 	{
 		//todo:may be need fix
 		m_border_image_attribute.Assign(*this, in_border_image);
+
+		//the attribute has no invalidation reason, the cached elements still reference the old brush
+		Invalidate(EInvalidateWidgetReason::Paint);
 	}
 
 	int32_t SBorder::On_Paint(const FPaintArgs& args, const FGeometry& allotted_geometry,
@@ -4,6 +4,7 @@
 
 #include "SlateCore/Layout/ArrangedChildren.h"
 #include "SlateCore/Types/PaintArgs.h"
+#include "SlateCore/Rendering/DrawElements.h"//FSlateWindowElementList depends on it
 
 namespace DoDo
 {
@@ -93,6 +94,12 @@ namespace DoDo
 		{
 			FArrangedWidget& cur_widget = arranged_children[child_index];
 
+			if(is_child_widget_culled(my_culling_rect, cur_widget))
+			{
+				out_draw_elements.add_culled_widget();
+				continue;
+			}
+
 			if(child_layers[child_index])
 			{
 				child_layer_id = max_layer_id + 1;
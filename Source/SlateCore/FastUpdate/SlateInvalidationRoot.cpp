@@ -2,9 +2,17 @@
 
 #include "SlateInvalidationRoot.h"
 
+#include "SlateCore/Rendering/DrawElements.h"//FSlateCachedElementData
+
+#include "SlateCore/Widgets/SWidget.h"//paint_fast_path
+
 namespace DoDo
 {
 	FSlateInvalidationRoot::FSlateInvalidationRoot()
+		: m_cached_max_layer_id(0)
+		, m_cached_element_data(std::make_unique<FSlateCachedElementData>())
+		, m_b_needs_slow_path(true)
+		, m_b_allow_element_cache(false)
 	{
 	}
 
@@ -16,10 +24,71 @@ namespace DoDo
 	{
 		FSlateInvalidationResult result;
 
-		m_cached_max_layer_id = paint_slow_path(context);
+		if(!m_b_allow_element_cache)
+		{
+			m_cached_max_layer_id = paint_slow_path(context);
+
+			result.m_b_repainted_widgets = true;
+		}
+		else
+		{
+			//the elements of this root go to the cache, the element list doesn't own it
+			context.m_window_element_list->set_cached_element_data(m_cached_element_data.get());
+
+			if(m_b_needs_slow_path)
+			{
+				m_cached_element_data->reset_cache();
+
+				m_cached_max_layer_id = paint_slow_path(context);
+
+				m_b_needs_slow_path = false;
+
+				result.m_b_repainted_widgets = true;
+			}
+			else
+			{
+				m_cached_max_layer_id = std::max(m_cached_max_layer_id, paint_fast_path(context));
+			}
+		}
 
 		result.m_max_layer_id_painted = m_cached_max_layer_id;//fill in the result
 
 		return result;
 	}
+
+	void FSlateInvalidationRoot::invalidate_root()
+	{
+		m_b_needs_slow_path = true;
+	}
+
+	void FSlateInvalidationRoot::set_allow_element_cache(bool b_allow_element_cache)
+	{
+		if(m_b_allow_element_cache != b_allow_element_cache)
+		{
+			m_b_allow_element_cache = b_allow_element_cache;
+
+			//don't keep stale elements around, a enabled cache starts from the slow path
+			m_cached_element_data->reset_cache();
+
+			m_b_needs_slow_path = true;
+		}
+	}
+
+	int32_t FSlateInvalidationRoot::paint_fast_path(const FSlateInvalidationContext& context)
+	{
+		int32_t max_layer_id = 0;
+
+		//painting a volatile widget records it again
+		std::vector<std::weak_ptr<const SWidget>> volatile_widgets = m_cached_element_data->take_volatile_widgets();
+
+		for(const std::weak_ptr<const SWidget>& volatile_widget : volatile_widgets)
+		{
+			if(std::shared_ptr<const SWidget> widget = volatile_widget.lock())
+			{
+				max_layer_id = std::max(max_layer_id, widget->paint_fast_path(*context.m_paint_args, *context.m_window_element_list));
+			}
+		}
+
+		return max_layer_id;
+	}
 }
@@ -9,6 +9,7 @@ namespace DoDo
 	class FWidgetStyle;
 	class FPaintArgs;
 	class FSlateWindowElementList;
+	class FSlateCachedElementData;
 
 	//context class
 	struct FSlateInvalidationContext
@@ -61,7 +62,28 @@ namespace DoDo
 
 		virtual int32_t paint_slow_path(const FSlateInvalidationContext& context) = 0;
 
+		/*the cached elements are thrown away, the next paint goes through the slow path*/
+		void invalidate_root();
+
+		/*
+		 * when enabled, the elements of non volatile widgets are kept between frames and only volatile widgets are painted again
+		 * widgets must call Invalidate when their look changes, the cache is off by default
+		 */
+		void set_allow_element_cache(bool b_allow_element_cache);
+
+		bool is_element_cache_allowed() const { return m_b_allow_element_cache; }
+
+	private:
+		/*paints only the volatile widgets recorded by the last slow path, the other elements come from the cache*/
+		int32_t paint_fast_path(const FSlateInvalidationContext& context);
+
 	private:
 		int32_t m_cached_max_layer_id;
+
+		std::unique_ptr<FSlateCachedElementData> m_cached_element_data;
+
+		bool m_b_needs_slow_path;
+
+		bool m_b_allow_element_cache;
 	};
 }
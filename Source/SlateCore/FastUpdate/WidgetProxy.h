@@ -6,6 +6,8 @@
 
 #include "SlateCore/Layout/Geometry.h"
 
+#include "SlateCore/Layout/SlateRect.h"//FSlateRect depends on it
+
 #include "SlateCore/Styling/WidgetStyle.h"//FWidgetStyle depends on it
 //FWidgetStyle just three color
 
@@ -36,6 +38,9 @@ namespace DoDo
 
 		FWidgetStyle m_widget_style;//note:this is different from FSlateWidgetStyle, it just three color
 
+		/*culling rect passed to the last paint, used to paint the widget again on it's own*/
+		FSlateRect m_culling_bounds;
+
 		//------starting layer id for drawing children------
 		int32_t m_layer_id;
 
@@ -88,8 +88,8 @@ namespace DoDo
 			if(m_halignment != alignment)
 			{
 				m_halignment = alignment;
-				//call widget's Invalidate function
-				static_cast<MixedIntoType*>(this)->Invalidate(EInvalidateWidgetReason::Layout);
+				//FSlotBase's function invalidate, invalidates the owner widget
+				static_cast<MixedIntoType*>(this)->invalidate(EInvalidateWidgetReason::Layout);
 			}
 		}
 
@@ -103,7 +103,7 @@ namespace DoDo
 			if(m_valignment != alignment)
 			{
 				m_valignment = alignment;
-				static_cast<MixedIntoType*>(this)->Invalidate(EInvalidateWidgetReason::Layout);
+				static_cast<MixedIntoType*>(this)->invalidate(EInvalidateWidgetReason::Layout);
 			}
 		}
 
@@ -185,8 +185,8 @@ namespace DoDo
 			if (m_halignment != alignment)
 			{
 				m_halignment = alignment;
-				//call widget's Invalidate function
-				static_cast<MixedIntoType*>(this)->Invalidate(EInvalidateWidgetReason::Layout);
+				//FSlotBase's function invalidate, invalidates the owner widget
+				static_cast<MixedIntoType*>(this)->invalidate(EInvalidateWidgetReason::Layout);
 			}
 		}
 
@@ -200,7 +200,7 @@ namespace DoDo
 			if (m_valignment != alignment)
 			{
 				m_valignment = alignment;
-				static_cast<MixedIntoType*>(this)->Invalidate(EInvalidateWidgetReason::Layout);
+				static_cast<MixedIntoType*>(this)->invalidate(EInvalidateWidgetReason::Layout);
 			}
 		}
 
@@ -259,6 +259,14 @@ namespace DoDo
 			}
 		};
 
+		void set_padding(TAttribute<FMargin> in_padding)
+		{
+			m_slot_padding_attribute.Assign(*static_cast<MixedIntoType*>(this), std::move(in_padding));
+
+			//the contained attribute has no invalidation reason
+			static_cast<MixedIntoType*>(this)->invalidate(EInvalidateWidgetReason::Layout);
+		}
+
 		FMargin get_padding() const
 		{
 			return m_slot_padding_attribute.Get();
@@ -274,8 +282,6 @@ namespace DoDo
 		}
 
 		//todo:implement register attributes mixin
-
-		//todo:implement set padding function
 	private:
 		using SlotPaddingCompareType = TSlateAttributeComparePredicate<>;
 		//note:this is difference from TPaddingSingleWidgetSlotMixin, this is ContainedAttribute
@@ -347,6 +353,9 @@ namespace DoDo
 			
 			//todo:check owner_widget
 			m_slot_padding_attribute.Assign(*owner_widget, std::move(in_padding));
+
+			//assigning a binding doesn't invalidate, the cached elements of the owner still use the old padding
+			static_cast<MixedIntoType*>(this)->invalidate(InPaddingInvalidationReason);
 		}
 
 		FMargin get_padding() const
@@ -0,0 +1,18 @@
+#pragma once
+
+namespace DoDo
+{
+	/*
+	 * how a widget limits the culling rect it paints its children with
+	 * a widget that clips to its bounds culls every element and child that is entirely outside of its render bounds
+	 * note:elements that are partly outside are still drawn whole, there is no scissor per widget
+	 */
+	enum class EWidgetClipping : uint8_t
+	{
+		/*the widget and its children use the culling rect of the parent, the default*/
+		Inherit,
+
+		/*the culling rect of the parent is intersected with the render bounds of the widget*/
+		ClipToBounds
+	};
+}
@@ -262,9 +262,9 @@ namespace DoDo
 			return transform_rect(get_accumulated_layout_transform(), FSlateRotatedRect(local_space_rect)).to_bounding_rect();
 		}
 
-		FSlateRect get_render_bounding_rect()
+		FSlateRect get_render_bounding_rect() const
 		{
-			return get_layout_bounding_rect(FSlateRect(0.0f, 0.0f, m_size.x, m_size.y) );
+			return get_render_bounding_rect(FSlateRect(0.0f, 0.0f, m_size.x, m_size.y) );
 		}
 
 		FSlateRect get_render_bounding_rect(const FSlateRect& local_space_rect) const
@@ -3,6 +3,7 @@
 #include <glm/vec2.hpp>
 #include "SlateCore/Rendering/SlateRenderTransform.h"//accumulated render transform depends on it
 #include "SlateCore/Rendering/SlateLayoutTransform.h"
+#include "SlateRotatedRect.h"//get_render_bounding_rect depends on it
 
 /*
 * a paint geometry contains the window-space (draw-space) info to draw an element on the screen
@@ -66,6 +67,12 @@ namespace DoDo
 
 		bool has_render_transform() const { return m_b_has_render_transform; }
 
+		/*window space bounding rect of the geometry, must call commit transforms if using legacy constructor() first if legacy ctor is used*/
+		FSlateRect get_render_bounding_rect() const
+		{
+			return transform_rect(m_accumulated_render_transform, FSlateRotatedRect(FSlateRect(0.0f, 0.0f, m_local_size.x, m_local_size.y))).to_bounding_rect();
+		}
+
 	private:
 		/*mutable to support legacy constructors, doesn't account for render transforms*/
 		mutable glm::vec2 m_draw_size;
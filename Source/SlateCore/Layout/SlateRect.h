@@ -46,6 +46,41 @@ namespace DoDo
 			return glm::vec2(right, bottom);
 		}
 
+		/*
+		 * determines if the rectangle has positive dimensions, the default(-1) rect is not valid
+		 */
+		bool is_valid() const
+		{
+			return !(left == -1 && right == -1 && bottom == -1 && top == -1) && right >= left && bottom >= top;
+		}
+
+		/*
+		 * returns the rectangle that is the intersection of this rectangle and other
+		 *
+		 * @param b_out_overlapping set to false when the rectangles don't overlap
+		 * @return the intersection rectangle, empty when they don't overlap
+		 */
+		FSlateRect intersection_with(const FSlateRect& other, bool& b_out_overlapping) const
+		{
+			FSlateRect intersected(std::max(left, other.left), std::max(top, other.top), std::min(right, other.right), std::min(bottom, other.bottom));
+			if(intersected.right <= intersected.left || intersected.bottom <= intersected.top)
+			{
+				b_out_overlapping = false;
+				return FSlateRect(0.0f, 0.0f, 0.0f, 0.0f);
+			}
+
+			b_out_overlapping = true;
+			return intersected;
+		}
+
+		/*
+		 * returns true if the rectangles overlap, touching edges are not overlapping
+		 */
+		static bool do_rectangles_intersect(const FSlateRect& a, const FSlateRect& b)
+		{
+			return !(a.left >= b.right || a.right <= b.left || a.top >= b.bottom || a.bottom <= b.top);
+		}
+
 	private:
 
 	};
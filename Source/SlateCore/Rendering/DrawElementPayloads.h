@@ -12,9 +12,12 @@ namespace DoDo
 	class FSlateShaderResourceProxy;
 	//class FSlateBrush;
 
+	/*
+	 * payloads are constructed in the element list's mem stack by their concrete type
+	 * keep them trivially destructible when possible, so nothing is recorded to destroy them
+	 */
 	struct FSlateDataPayload
 	{
-		virtual ~FSlateDataPayload() {}
 
 		//todo:implement add referenced objects
 	};
@@ -8,6 +8,9 @@
 
 namespace DoDo
 {
+	//box payload is the most common payload, it shouldn't need a destructor record in the mem stack
+	static_assert(std::is_trivially_destructible_v<FSlateBoxPayload>, "FSlateBoxPayload should be trivially destructible");
+
 	FSlateDrawElement::FSlateDrawElement()
 		: m_data_payload(nullptr)
 	{
@@ -15,23 +18,14 @@ namespace DoDo
 
 	FSlateDrawElement::~FSlateDrawElement()
 	{
-		if(m_data_payload)
-		{
-			//m_data_payload->~FSlateDataPayload();
-
-			delete m_data_payload;
-
-			m_data_payload = nullptr;
-		}
+		//note:the payload memory and destructor are owned by the element list's mem stack, see FSlateWindowElementList::reset_element_list
+		m_data_payload = nullptr;
 	}
 
 	FSlateDrawElement::FSlateDrawElement(FSlateDrawElement&& rhs)
 	{
-		if(rhs.m_data_payload)//move life time
-		{
-			m_data_payload = rhs.m_data_payload;
-			rhs.m_data_payload = nullptr;
-		}
+		m_data_payload = rhs.m_data_payload;
+		rhs.m_data_payload = nullptr;
 
 		m_render_transform = rhs.m_render_transform;
 		m_position = rhs.m_position;
@@ -54,12 +48,33 @@ namespace DoDo
 
 		//call PaintGeometry's commit transforms if using legacy constructor
 		paint_geometry.commit_transforms_if_using_legacy_constructor();
-		//todo:implement should cull
 
-		//todo:implement make box internal
+		if(should_cull(element_list, paint_geometry, in_brush, in_tint))
+		{
+			element_list.add_culled_element();
+			return;
+		}
+
 		MakeBoxInternal(element_list, in_layer, paint_geometry, in_brush, in_draw_effects, in_tint);
 	}
 
+	bool FSlateDrawElement::should_cull(const FSlateWindowElementList& element_list, const FPaintGeometry& paint_geometry,
+		const FSlateBrush* in_brush, const glm::vec4& in_tint)
+	{
+		if(in_brush == nullptr || in_brush->get_draw_type() == ESlateBrushDrawType::NoDrawType || in_tint.a == 0.0f)
+		{
+			return true;
+		}
+
+		const glm::vec2& local_size = paint_geometry.get_local_Size();
+		if(local_size.x <= 0.0f || local_size.y <= 0.0f)
+		{
+			return true;
+		}
+
+		return element_list.is_culled(paint_geometry);
+	}
+
 	void FSlateDrawElement::init(FSlateWindowElementList& element_list, EElementType in_element_type, uint32_t in_layer,
 		const FPaintGeometry& paint_geometry, ESlateDrawEffect in_draw_effects)
 	{
@@ -114,11 +129,39 @@ namespace DoDo
 		return element;
 	}
 
+	FSlateCachedElementData::FSlateCachedElementData()
+		: m_b_needs_rebatch(true)
+	{
+	}
+
+	FSlateCachedElementData::~FSlateCachedElementData()
+	{
+		reset_cache();
+	}
+
+	void FSlateCachedElementData::reset_cache()
+	{
+		m_cached_draw_elements.clear();
+
+		//the elements referencing the payloads are gone
+		m_mem_manager.flush();
+
+		m_cached_batch_data.reset_data();
+
+		m_volatile_widgets.clear();
+
+		m_b_needs_rebatch = true;
+	}
+
 	FSlateWindowElementList::FSlateWindowElementList(const std::shared_ptr<SWindow>& in_paint_window)
 		: m_weak_paint_window(in_paint_window)
 		, m_raw_paint_window(in_paint_window.get())
 		, m_window_size(glm::vec2(0.0f, 0.0f))
 		, m_render_target_window(nullptr)
+		, m_cached_element_data(nullptr)
+		, m_volatile_paint_depth(0)
+		, m_num_culled_widgets(0)
+		, m_num_culled_elements(0)
 	{
 		//todo:check in_paint_window is valid
 	}
@@ -130,11 +173,9 @@ namespace DoDo
 
 	FSlateDrawElement& FSlateWindowElementList::add_uninitialized()
 	{
-		const bool b_allow_cache = false;//todo:fix this
-
-		//todo:implement if else branch
+		const bool b_allow_cache = should_cache_elements();
 
-		FSlateDrawElementArray& elements = m_uncached_draw_elements;
+		FSlateDrawElementArray& elements = b_allow_cache ? m_cached_element_data->m_cached_draw_elements : m_uncached_draw_elements;
 
 		//add default element
 		elements.emplace_back();
@@ -151,6 +192,28 @@ namespace DoDo
 		m_batch_data.reset_data();
 
 		m_uncached_draw_elements.clear();//todo:this is important, every frame need to clear
+
+		//release all payloads of last frame at once, the elements referencing them are gone
+		m_mem_manager.flush();
+
+		m_cached_element_data = nullptr;
+		m_volatile_paint_depth = 0;
+
+		m_culling_rect_stack.clear();
+		m_num_culled_widgets = 0;
+		m_num_culled_elements = 0;
+	}
+
+	bool FSlateWindowElementList::is_culled(const FPaintGeometry& paint_geometry) const
+	{
+		const FSlateRect culling_rect = get_culling_rect();
+
+		if(!culling_rect.is_valid())
+		{
+			return false;
+		}
+
+		return !FSlateRect::do_rectangles_intersect(culling_rect, paint_geometry.get_render_bounding_rect());
 	}
 
 	FSlateBatchData& FSlateWindowElementList::get_batch_data()
@@ -10,6 +10,10 @@
 
 #include "ElementBatcher.h"//FSlateWindowElementList depend on it
 
+#include "Core/Misc/MemStack.h"//FSlateWindowElementList depend on it
+
+#include "SlateCore/Layout/SlateRect.h"//FSlateWindowElementList depend on it
+
 namespace DoDo
 {
 	struct FPaintGeometry;
@@ -98,6 +102,11 @@ namespace DoDo
 			ESlateDrawEffect in_draw_effects,
 			const glm::vec4& in_tint);
 
+		/*
+		 * returns true if a box would produce nothing visible, it is fully transparent, has no draw type or is outside the current culling rect
+		 */
+		static bool should_cull(const FSlateWindowElementList& element_list, const FPaintGeometry& paint_geometry, const FSlateBrush* in_brush, const glm::vec4& in_tint);
+
 	private:
 		void init(FSlateWindowElementList& element_list, EElementType in_element_type, uint32_t in_layer, const FPaintGeometry& paint_geometry, ESlateDrawEffect in_draw_effects);
 
@@ -123,6 +132,57 @@ namespace DoDo
 	};
 
 	class SWindow;
+	class SWidget;
+
+	/*
+	 * draw elements and their batched vertices kept across frames by an invalidation root
+	 * they are only painted and batched again after the root is invalidated, volatile widgets are painted every frame into the uncached elements
+	 */
+	class FSlateCachedElementData
+	{
+	public:
+		friend class FSlateWindowElementList;
+
+		FSlateCachedElementData();
+
+		~FSlateCachedElementData();
+
+		/*throw away the cached elements and vertices, the next paint of the invalidation root fills them again*/
+		void reset_cache();
+
+		const FSlateDrawElementArray& get_cached_draw_elements() const { return m_cached_draw_elements; }
+
+		/*render batches and vertices of the cached elements, only valid when needs_rebatch is false*/
+		FSlateBatchData& get_cached_batch_data() { return m_cached_batch_data; }
+
+		bool needs_rebatch() const { return m_b_needs_rebatch; }
+
+		void mark_batched() { m_b_needs_rebatch = false; }
+
+		/*widgets that must be painted every frame, recorded while painting the invalidation root*/
+		void add_volatile_widget(const std::shared_ptr<const SWidget>& in_widget) { m_volatile_widgets.push_back(in_widget); }
+
+		/*moves the recorded volatile widgets out, painting them records them again*/
+		std::vector<std::weak_ptr<const SWidget>> take_volatile_widgets()
+		{
+			std::vector<std::weak_ptr<const SWidget>> volatile_widgets = std::move(m_volatile_widgets);
+			m_volatile_widgets.clear();
+			return volatile_widgets;
+		}
+
+	private:
+		FSlateDrawElementArray m_cached_draw_elements;
+
+		/*payloads of the cached elements, lives as long as the cache*/
+		FMemStackBase m_mem_manager;
+
+		FSlateBatchData m_cached_batch_data;
+
+		std::vector<std::weak_ptr<const SWidget>> m_volatile_widgets;
+
+		bool m_b_needs_rebatch;
+	};
+
 	//class FSlateBatchData;
 	/*
 	 * represents a top level window and it's draw elements
@@ -163,12 +223,12 @@ namespace DoDo
 		template<typename PayloadType>
 		PayloadType& create_pay_load(FSlateDrawElement& draw_element)
 		{
-			//elements are responsible for deleting their own payloads
-			PayloadType* pay_load;
-
-			pay_load = new PayloadType();
+			//payloads live in the per frame mem stack, they are released in bulk by reset_element_list
+			//cached elements keep their payloads in the cache until the cache is reset
+			FMemStackBase& mem_manager = should_cache_elements() ? m_cached_element_data->m_mem_manager : m_mem_manager;
+			PayloadType* pay_load = mem_manager.construct<PayloadType>();
 
-			draw_element.m_data_payload = pay_load;//owns the life time
+			draw_element.m_data_payload = pay_load;//don't owns the life time
 
 			return *pay_load;
 		}
@@ -185,6 +245,43 @@ namespace DoDo
 
 		FSlateBatchData& get_batch_data();
 
+		/*
+		 * the culling rect of the widget being painted, elements fully outside of it are not added
+		 * pushed and popped around every widget's On_Paint by SWidget::paint
+		 */
+		void push_culling_rect(const FSlateRect& in_culling_rect) { m_culling_rect_stack.push_back(in_culling_rect); }
+
+		void pop_culling_rect() { m_culling_rect_stack.pop_back(); }
+
+		/*@return the current culling rect, invalid(cull nothing) when no widget is being painted*/
+		FSlateRect get_culling_rect() const { return m_culling_rect_stack.empty() ? FSlateRect() : m_culling_rect_stack.back(); }
+
+		/*@return true if the paint geometry is entirely outside of the current culling rect*/
+		bool is_culled(const FPaintGeometry& paint_geometry) const;
+
+		/*
+		 * elements added while a cached element data is set go to the cache, unless a volatile widget is being painted
+		 * set by the invalidation root every frame, cleared by reset_element_list
+		 */
+		void set_cached_element_data(FSlateCachedElementData* in_cached_element_data) { m_cached_element_data = in_cached_element_data; }
+
+		FSlateCachedElementData* get_cached_element_data() const { return m_cached_element_data; }
+
+		void begin_volatile_paint() { ++m_volatile_paint_depth; }
+
+		void end_volatile_paint() { --m_volatile_paint_depth; }
+
+		bool is_painting_volatile() const { return m_volatile_paint_depth > 0; }
+
+		bool should_cache_elements() const { return m_cached_element_data != nullptr && m_volatile_paint_depth == 0; }
+
+		/*culling statistics of the current frame*/
+		void add_culled_widget() { ++m_num_culled_widgets; }
+		void add_culled_element() { ++m_num_culled_elements; }
+
+		int32_t get_num_culled_widgets() const { return m_num_culled_widgets; }
+		int32_t get_num_culled_elements() const { return m_num_culled_elements; }
+
 	private:
 		/*
 		* window which owns the widgets that are being painted but not necessarily rendered to
@@ -208,5 +305,23 @@ namespace DoDo
 
 		/*store the size of the window beging used to paint*/
 		glm::vec2 m_window_size;
+
+		/*per frame memory for the draw element payloads*/
+		FMemStackBase m_mem_manager;
+
+		/*cached elements of the invalidation root being painted, don't owns the life time*/
+		FSlateCachedElementData* m_cached_element_data;
+
+		/*greater than zero while painting a volatile widget and its children*/
+		int32_t m_volatile_paint_depth;
+
+		/*culling rects of the widgets currently being painted*/
+		std::vector<FSlateRect> m_culling_rect_stack;
+
+		/*number of widgets skipped by their parent's culling this frame*/
+		int32_t m_num_culled_widgets;
+
+		/*number of draw elements dropped before they reached the batcher this frame*/
+		int32_t m_num_culled_elements;
 	};
 }
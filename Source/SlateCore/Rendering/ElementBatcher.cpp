@@ -7,6 +7,8 @@
 #include "glm/vec2.hpp"
 #include "SlateCore/Widgets/SWindow.h"
 
+#include <limits>
+
 namespace DoDo
 {
 	FSlateRenderBatch& FSlateBatchData::add_render_batch(int32_t in_layer, FSlateShaderResource* shader_resource, ESlateDrawPrimitive in_primitive_type,
@@ -15,20 +17,35 @@ namespace DoDo
 		return m_render_batches.emplace_back(in_layer, shader_resource, in_primitive_type, in_draw_effects, &m_uncached_source_batch_vertices, &m_uncached_source_batch_indices, m_uncached_source_batch_vertices.size(), m_uncached_source_batch_indices.size());
 	}
 
+	FSlateRenderBatch& FSlateBatchData::add_instanced_render_batch(int32_t in_layer, FSlateShaderResource* shader_resource, ESlateDrawEffect in_draw_effects)
+	{
+		return m_render_batches.emplace_back(in_layer, shader_resource, ESlateDrawPrimitive::TriangleList, in_draw_effects, &m_uncached_source_batch_vertices, &m_uncached_source_batch_indices, m_uncached_source_batch_vertices.size(), m_uncached_source_batch_indices.size(),
+			&m_uncached_source_batch_instances, m_uncached_source_batch_instances.size());
+	}
+
+	void FSlateBatchData::add_cached_render_batches(const FSlateBatchData& cached_batch_data)
+	{
+		//copies of the batches point at the cached source arrays, merging doesn't modify the cached batches
+		m_render_batches.insert(m_render_batches.end(), cached_batch_data.m_render_batches.begin(), cached_batch_data.m_render_batches.end());
+	}
+
 	void FSlateBatchData::reset_data()
 	{
 		m_render_batches.clear();
 		m_uncached_source_batch_vertices.clear();
 		m_uncached_source_batch_indices.clear();
-		m_final_vertex_data.clear();
-		m_final_index_data.clear();
+		m_uncached_source_batch_instances.clear();
+		m_final_data_copies.clear();
 
-		m_total_vertex_offset = m_total_index_offset = 0;
+		m_num_final_vertices = m_num_final_indices = m_num_final_instances = 0;
+
+		m_total_vertex_offset = m_total_index_offset = m_total_instance_offset = 0;
 
 		m_first_render_batch_index = -1;
 
 		m_num_layers = 0;
 		m_num_batches = 0;
+		m_num_merged_batches = 0;
 	}
 
 	void FSlateBatchData::merge_render_batches()
@@ -57,6 +74,11 @@ namespace DoDo
 
 			m_num_batches = 0;
 			m_num_layers = 0;
+			m_num_merged_batches = 0;
+
+			//only the copies are recorded here, copy_final_data writes them to the final buffers
+			m_final_data_copies.clear();
+			m_num_final_vertices = m_num_final_indices = m_num_final_instances = 0;
 
 			m_first_render_batch_index = batch_indices[0].first;
 
@@ -67,47 +89,204 @@ namespace DoDo
 
 				FSlateRenderBatch& current_batch = m_render_batches[batch_index_pair.first];
 
+				//adjacent batches with the same state are folded into one draw call, the current batch is left out of the linked list
+				if(prev_batch != nullptr && is_batch_compatible(*prev_batch, current_batch))
+				{
+					combine_batches(*prev_batch, current_batch);
+
+					++m_num_merged_batches;
+
+					continue;
+				}
+
 				if(prev_batch != nullptr)
 				{
 					prev_batch->m_next_batch_index = batch_index_pair.first;
 				}
 
-				++m_num_batches;
+				if(prev_batch == nullptr || prev_batch->get_layer() != current_batch.get_layer())
+				{
+					++m_num_layers;
+				}
 
-				//todo:implement fill buffers from new batch
-				fill_buffers_from_new_batch(current_batch, m_final_vertex_data, m_final_index_data);
+				++m_num_batches;
 
-				//todo:temporarily do nothing
+				fill_buffers_from_new_batch(current_batch);
 
 				prev_batch = &current_batch;
 			}
 		}
 	}
 
-	void FSlateBatchData::fill_buffers_from_new_batch(FSlateRenderBatch& batch, FSlateVertexArray& final_vertices,
-		FSlateIndexArray& final_indices)
+	void FSlateBatchData::fill_buffers_from_new_batch(FSlateRenderBatch& batch)
+	{
+		if(!batch.has_vertex_data())
+		{
+			return;
+		}
+
+		FFinalDataCopy& copy = m_final_data_copies.emplace_back();
+		copy.m_source_vertices = batch.m_source_vertices;
+		copy.m_source_indices = batch.m_source_indices;
+		copy.m_source_instances = batch.m_source_instances;
+		copy.m_base_vertex = 0;
+
+		if(batch.is_instanced())
+		{
+			copy.m_source_instance_offset = batch.m_instance_offset;
+			copy.m_num_instances = batch.m_num_instances;
+
+			batch.m_instance_offset = m_num_final_instances;
+
+			m_num_final_instances += batch.m_num_instances;
+		}
+		else
+		{
+			//from the source arrays to the final buffers
+			copy.m_source_vertex_offset = batch.m_vertex_offset;
+			copy.m_num_vertices = batch.m_num_vertices;
+			copy.m_source_index_offset = batch.m_index_offset;
+			copy.m_num_indices = batch.m_num_indices;
+
+			batch.m_vertex_offset = m_num_final_vertices;
+			batch.m_index_offset = m_num_final_indices;
+
+			m_num_final_vertices += batch.m_num_vertices;
+			m_num_final_indices += batch.m_num_indices;
+		}
+	}
+
+	void FSlateBatchData::combine_batches(FSlateRenderBatch& prev_batch, FSlateRenderBatch& batch)
 	{
-		if(batch.has_vertex_data())
+		FFinalDataCopy& copy = m_final_data_copies.emplace_back();
+		copy.m_source_vertices = batch.m_source_vertices;
+		copy.m_source_indices = batch.m_source_indices;
+		copy.m_source_instances = batch.m_source_instances;
+
+		if(batch.is_instanced())
 		{
-			const int32_t source_vertex_offset = batch.m_vertex_offset;
-			const int32_t source_index_offset = batch.m_index_offset;//from another array to copy to this array
+			//instances don't reference each other, they are simply appended
+			copy.m_source_instance_offset = batch.m_instance_offset;
+			copy.m_num_instances = batch.m_num_instances;
+			copy.m_base_vertex = 0;
+
+			m_num_final_instances += batch.m_num_instances;
 
-			batch.m_vertex_offset = final_vertices.size();
-			batch.m_index_offset = final_indices.size();
+			prev_batch.m_num_instances += batch.m_num_instances;
 
-			m_final_vertex_data.insert(m_final_vertex_data.end(), (*batch.m_source_vertices).begin() + source_vertex_offset, (*batch.m_source_vertices).begin() + source_vertex_offset + batch.m_num_vertices);
-			m_final_index_data.insert(m_final_index_data.end(), (*batch.m_source_indices).begin() + source_index_offset, (*batch.m_source_indices).begin() + source_index_offset + batch.m_num_indices);
+			batch.m_instance_offset = prev_batch.m_instance_offset;
+			batch.m_num_instances = 0;
+
+			return;
 		}
+
+		copy.m_source_vertex_offset = batch.m_vertex_offset;
+		copy.m_num_vertices = batch.m_num_vertices;
+		copy.m_source_index_offset = batch.m_index_offset;
+		copy.m_num_indices = batch.m_num_indices;
+
+		//indices of batch are local to its own vertices, move them behind the vertices of prev batch
+		copy.m_base_vertex = prev_batch.m_num_vertices;
+
+		m_num_final_vertices += batch.m_num_vertices;
+		m_num_final_indices += batch.m_num_indices;
+
+		prev_batch.m_num_vertices += batch.m_num_vertices;
+		prev_batch.m_num_indices += batch.m_num_indices;
+
+		//the batch now lives in prev batch
+		batch.m_vertex_offset = prev_batch.m_vertex_offset;
+		batch.m_index_offset = prev_batch.m_index_offset;
+		batch.m_num_vertices = 0;
+		batch.m_num_indices = 0;
+	}
+
+	void FSlateBatchData::copy_final_data(FSlateVertex* out_vertices, SlateIndex* out_indices, FSlateQuadInstance* out_instances) const
+	{
+		//the copies are in the order of the final buffers
+		for(const FFinalDataCopy& copy : m_final_data_copies)
+		{
+			if(copy.m_num_instances > 0)
+			{
+				std::memcpy(out_instances, copy.m_source_instances->data() + copy.m_source_instance_offset, copy.m_num_instances * sizeof(FSlateQuadInstance));
+				out_instances += copy.m_num_instances;
+				continue;
+			}
+
+			std::memcpy(out_vertices, copy.m_source_vertices->data() + copy.m_source_vertex_offset, copy.m_num_vertices * sizeof(FSlateVertex));
+			out_vertices += copy.m_num_vertices;
+
+			const SlateIndex* source_indices = copy.m_source_indices->data() + copy.m_source_index_offset;
+			if(copy.m_base_vertex == 0)
+			{
+				std::memcpy(out_indices, source_indices, copy.m_num_indices * sizeof(SlateIndex));
+			}
+			else
+			{
+				for(int32_t index = 0; index < copy.m_num_indices; ++index)
+				{
+					out_indices[index] = static_cast<SlateIndex>(source_indices[index] + copy.m_base_vertex);
+				}
+			}
+			out_indices += copy.m_num_indices;
+		}
+	}
+
+	bool FSlateBatchData::is_batch_compatible(const FSlateRenderBatch& prev_batch, const FSlateRenderBatch& batch)
+	{
+		//empty batches are never written to the final buffers, so the next batch can't be appended to them
+		if(!prev_batch.has_vertex_data() || !batch.has_vertex_data())
+		{
+			return false;
+		}
+
+		if(prev_batch.is_instanced() != batch.is_instanced())
+		{
+			return false;
+		}
+
+		//rebased indices must still fit in the index type
+		if(!batch.is_instanced() && uint64_t(prev_batch.m_num_vertices) + batch.m_num_vertices > uint64_t(std::numeric_limits<SlateIndex>::max()) + 1)
+		{
+			return false;
+		}
+
+		return prev_batch.m_layer_id == batch.m_layer_id
+			&& prev_batch.m_shader_resource == batch.m_shader_resource
+			&& prev_batch.m_draw_primitive_type == batch.m_draw_primitive_type
+			&& prev_batch.m_draw_effects == batch.m_draw_effects;
 	}
 
 	void FSlateElementBatcher::add_elements(FSlateWindowElementList& element_list)
 	{
 		//todo:implement viewport size
 		//glm::vec2 view_port_size = element_list.get_paint_window();
-		m_batch_data = &element_list.get_batch_data();//get the batch data from element list, don't owner the life time of batch data
-
 		glm::vec2 view_port_size = element_list.get_paint_window()->get_view_port_size();//if this is 0, will get the client size
 
+		if(FSlateCachedElementData* cached_element_data = element_list.get_cached_element_data())
+		{
+			//cached elements are only batched again after their invalidation root painted them again
+			if(cached_element_data->needs_rebatch())
+			{
+				m_batch_data = &cached_element_data->get_cached_batch_data();
+				m_batch_data->reset_data();
+
+				m_b_skipped_pending_resources = false;
+
+				add_elements_internal(cached_element_data->get_cached_draw_elements(), view_port_size);
+
+				//elements waiting for their texture are missing from the cache, batch it again next frame
+				if(!m_b_skipped_pending_resources)
+				{
+					cached_element_data->mark_batched();
+				}
+			}
+
+			element_list.get_batch_data().add_cached_render_batches(cached_element_data->get_cached_batch_data());
+		}
+
+		m_batch_data = &element_list.get_batch_data();//get the batch data from element list, don't owner the life time of batch data
+
 		add_elements_internal(element_list.get_uncached_draw_elements(), view_port_size);
 	}
 
@@ -175,6 +354,14 @@ namespace DoDo
 
 		const FSlateShaderResourceProxy* resource_proxy = draw_element_pay_load.get_resource_proxy();//todo:implement this function
 		FSlateShaderResource* resource = nullptr;
+
+		//the proxy has no resource until the texture upload finished, the element is drawn in a later frame
+		if (resource_proxy && resource_proxy->m_resource == nullptr)
+		{
+			m_b_skipped_pending_resources = true;
+			return;
+		}
+
 		if (resource_proxy)
 		{
 			resource = resource_proxy->m_resource;
@@ -189,8 +376,9 @@ namespace DoDo
 
 			if (brush_uv.m_b_is_valid)
 			{
-				size_uv = brush_uv.get_size();
-				start_uv = glm::vec2(brush_uv.m_min.x, brush_uv.m_min.y) + half_texel;
+				//the brush uv region is relative to the texture, map it into the texture's slot when it is atlased
+				size_uv = glm::vec2(brush_uv.get_size().x * resource_proxy->m_size_uv.x, brush_uv.get_size().y * resource_proxy->m_size_uv.y);
+				start_uv = resource_proxy->m_start_uv + glm::vec2(brush_uv.m_min.x * resource_proxy->m_size_uv.x, brush_uv.m_min.y * resource_proxy->m_size_uv.y) + half_texel;
 				end_uv = start_uv + size_uv;
 			}
 			else
@@ -209,6 +397,23 @@ namespace DoDo
 	
 		glm::vec4 secondary_color(0.0f, 0.0f, 0.0f, 0.0f);
 
+		const FMargin& margin = draw_element_pay_load.get_brush_margin();
+
+		const bool b_nine_slice = draw_element_pay_load.get_brush_draw_type() != ESlateBrushDrawType::Image &&
+			(margin.left != 0.0f || margin.top != 0.0f || margin.right != 0.0f || margin.bottom != 0.0f);
+
+		if(!b_nine_slice && m_b_use_instanced_quads && draw_element.get_element_type() == EElementType::ET_Box)
+		{
+			//same horizontal flip as the vertex quad below
+			const glm::vec2 instance_start_uv(end_uv.x, start_uv.y);
+			const glm::vec2 instance_end_uv(start_uv.x, end_uv.y);
+
+			if(add_box_instance<rounding>(draw_element, resource, instance_start_uv, instance_end_uv, tint))
+			{
+				return;
+			}
+		}
+
 		//todo:implement FSlateRenderBatch
 		FSlateRenderBatch& render_batch = create_render_batch(layer, resource, ESlateDrawPrimitive::TriangleList, in_draw_effects, draw_element);
 
@@ -219,16 +424,18 @@ namespace DoDo
 
 		//todo:add shader parameters for extra rounded box parameters
 
-		//the start index of these vertices in the index buffer
-		const uint32_t index_start = 0;
-
-		const FMargin& margin = draw_element_pay_load.get_brush_margin();
+		//indices are local to the batch, the batch's vertex offset is applied as base vertex when drawing
 
 		const glm::vec2 top_right = glm::vec2(bottom_right.x, top_left.y);
 		const glm::vec2 bottom_left = glm::vec2(top_left.x, bottom_right.y);
 
-		if (draw_element_pay_load.get_brush_draw_type() != ESlateBrushDrawType::Image &&
-			(margin.left != 0.0f || margin.top != 0.0f || margin.right != 0.0f || margin.bottom != 0.0f))
+		//these are the same for every vertex of the box
+		const FSlateVertexColor packed_tint = make_vertex_color(tint);
+		const FSlateVertexColor packed_secondary_color = make_vertex_color(secondary_color);
+		const uint16_t pixel_size_x = (uint16_t)(int32_t)(local_size.x * draw_scale);
+		const uint16_t pixel_size_y = (uint16_t)(int32_t)(local_size.y * draw_scale);
+
+		if (b_nine_slice)
 		{
 			//create 9 quads for the box element based on the following diagram
 			//     ___LeftMargin    ___RightMargin
@@ -267,89 +474,74 @@ namespace DoDo
 			glm::vec2 position = top_left;
 			glm::vec2 end_pos = bottom_right;
 
-			render_batch.add_vertex(FSlateVertex::Make<rounding>(render_transform, glm::vec2(position.x, position.y), local_size, draw_scale, glm::vec4(start_uv.x, start_uv.y, tiling.x, tiling.y), tint, secondary_color));//0
-			render_batch.add_vertex(FSlateVertex::Make<rounding>(render_transform, glm::vec2(position.x, top_margin_y), local_size, draw_scale, glm::vec4(start_uv.x, top_margin_v, tiling.x, tiling.y), tint, secondary_color));//1
-			render_batch.add_vertex(FSlateVertex::Make<rounding>(render_transform, glm::vec2(left_margin_x, position.y), local_size, draw_scale, glm::vec4(left_margin_u, start_uv.y, tiling.x, tiling.y), tint, secondary_color));//2 
-			render_batch.add_vertex(FSlateVertex::Make<rounding>(render_transform, glm::vec2(left_margin_x, top_margin_y), local_size, draw_scale, glm::vec4(left_margin_u, top_margin_v, tiling.x, tiling.y), tint, secondary_color));//3
-			render_batch.add_vertex(FSlateVertex::Make<rounding>(render_transform, glm::vec2(right_margin_x, position.y), local_size, draw_scale, glm::vec4(right_margin_u, start_uv.y, tiling.x, tiling.y), tint, secondary_color));//4
-			render_batch.add_vertex(FSlateVertex::Make<rounding>(render_transform, glm::vec2(right_margin_x, top_margin_y), local_size, draw_scale, glm::vec4(right_margin_u, top_margin_y, tiling.x, tiling.y), tint, secondary_color));//5
-			render_batch.add_vertex(FSlateVertex::Make<rounding>(render_transform, glm::vec2(end_pos.x, position.y), local_size, draw_scale, glm::vec4(end_uv.x, start_uv.y, tiling.x, tiling.y), tint, secondary_color));//6
-			render_batch.add_vertex(FSlateVertex::Make<rounding>(render_transform, glm::vec2(end_pos.x, top_margin_y), local_size, draw_scale, glm::vec4(end_uv.x, top_margin_v, tiling.x, tiling.y), tint, secondary_color));//7
-
-			render_batch.add_vertex(FSlateVertex::Make<rounding>(render_transform, glm::vec2(position.x, bottom_margin_y), local_size, draw_scale, glm::vec4(start_uv.x, bottom_margin_v, tiling.x, tiling.y), tint, secondary_color));//8
-			render_batch.add_vertex(FSlateVertex::Make<rounding>(render_transform, glm::vec2(left_margin_x, bottom_margin_y), local_size, draw_scale, glm::vec4(left_margin_u, bottom_margin_v, tiling.x, tiling.y), tint, secondary_color));//9
-			render_batch.add_vertex(FSlateVertex::Make<rounding>(render_transform, glm::vec2(right_margin_x, bottom_margin_y), local_size, draw_scale, glm::vec4(right_margin_u, bottom_margin_v, tiling.x, tiling.y), tint, secondary_color));//10
-			render_batch.add_vertex(FSlateVertex::Make<rounding>(render_transform, glm::vec2(end_pos.x, bottom_margin_y), local_size, draw_scale, glm::vec4(end_uv.x, bottom_margin_v, tiling.x, tiling.y), tint, secondary_color));//11
-			render_batch.add_vertex(FSlateVertex::Make<rounding>(render_transform, glm::vec2(position.x, end_pos.y), local_size, draw_scale, glm::vec4(start_uv.x, end_uv.y, tiling.x, tiling.y), tint, secondary_color));//12
-			render_batch.add_vertex(FSlateVertex::Make<rounding>(render_transform, glm::vec2(left_margin_x, end_pos.y), local_size, draw_scale, glm::vec4(left_margin_u, end_uv.y, tiling.x, tiling.y), tint, secondary_color));//13
-			render_batch.add_vertex(FSlateVertex::Make<rounding>(render_transform, glm::vec2(right_margin_x, end_pos.y), local_size, draw_scale, glm::vec4(right_margin_u, end_uv.y, tiling.x, tiling.y), tint, secondary_color));//14
-			render_batch.add_vertex(FSlateVertex::Make<rounding>(render_transform, glm::vec2(end_pos.x, end_pos.y), local_size, draw_scale, glm::vec4(end_uv.x, end_uv.y, tiling.x, tiling.y), tint, secondary_color));//15
-
-			//top
-			render_batch.add_index(index_start + 0);
-			render_batch.add_index(index_start + 1);
-			render_batch.add_index(index_start + 2);
-			render_batch.add_index(index_start + 2);
-			render_batch.add_index(index_start + 1);
-			render_batch.add_index(index_start + 3);
-
-			render_batch.add_index(index_start + 2);
-			render_batch.add_index(index_start + 3);
-			render_batch.add_index(index_start + 4);
-			render_batch.add_index(index_start + 4);
-			render_batch.add_index(index_start + 3);
-			render_batch.add_index(index_start + 5);
-
-			render_batch.add_index(index_start + 4);
-			render_batch.add_index(index_start + 5);
-			render_batch.add_index(index_start + 6);
-			render_batch.add_index(index_start + 6);
-			render_batch.add_index(index_start + 5);
-			render_batch.add_index(index_start + 7);
-
-			//middle
-			render_batch.add_index(index_start + 1);
-			render_batch.add_index(index_start + 8);
-			render_batch.add_index(index_start + 3);
-			render_batch.add_index(index_start + 3);
-			render_batch.add_index(index_start + 8);
-			render_batch.add_index(index_start + 9);
-
-			render_batch.add_index(index_start + 3);
-			render_batch.add_index(index_start + 9);
-			render_batch.add_index(index_start + 5);
-			render_batch.add_index(index_start + 5);
-			render_batch.add_index(index_start + 9);
-			render_batch.add_index(index_start + 10);
-
-			render_batch.add_index(index_start + 5);
-			render_batch.add_index(index_start + 10);
-			render_batch.add_index(index_start + 7);
-			render_batch.add_index(index_start + 7);
-			render_batch.add_index(index_start + 10);
-			render_batch.add_index(index_start + 11);
-
-			//bottom
-			render_batch.add_index(index_start + 8);
-			render_batch.add_index(index_start + 12);
-			render_batch.add_index(index_start + 9);
-			render_batch.add_index(index_start + 9);
-			render_batch.add_index(index_start + 12);
-			render_batch.add_index(index_start + 13);
-
-			render_batch.add_index(index_start + 9);
-			render_batch.add_index(index_start + 13);
-			render_batch.add_index(index_start + 10);
-			render_batch.add_index(index_start + 10);
-			render_batch.add_index(index_start + 13);
-			render_batch.add_index(index_start + 14);
-
-			render_batch.add_index(index_start + 10);
-			render_batch.add_index(index_start + 14);
-			render_batch.add_index(index_start + 11);
-			render_batch.add_index(index_start + 11);
-			render_batch.add_index(index_start + 14);
-			render_batch.add_index(index_start + 15);
+			const glm::vec2 local_positions[16] = {
+				glm::vec2(position.x, position.y),//0
+				glm::vec2(position.x, top_margin_y),//1
+				glm::vec2(left_margin_x, position.y),//2
+				glm::vec2(left_margin_x, top_margin_y),//3
+				glm::vec2(right_margin_x, position.y),//4
+				glm::vec2(right_margin_x, top_margin_y),//5
+				glm::vec2(end_pos.x, position.y),//6
+				glm::vec2(end_pos.x, top_margin_y),//7
+
+				glm::vec2(position.x, bottom_margin_y),//8
+				glm::vec2(left_margin_x, bottom_margin_y),//9
+				glm::vec2(right_margin_x, bottom_margin_y),//10
+				glm::vec2(end_pos.x, bottom_margin_y),//11
+				glm::vec2(position.x, end_pos.y),//12
+				glm::vec2(left_margin_x, end_pos.y),//13
+				glm::vec2(right_margin_x, end_pos.y),//14
+				glm::vec2(end_pos.x, end_pos.y)//15
+			};
+
+			const glm::vec2 uvs[16] = {
+				glm::vec2(start_uv.x, start_uv.y),//0
+				glm::vec2(start_uv.x, top_margin_v),//1
+				glm::vec2(left_margin_u, start_uv.y),//2
+				glm::vec2(left_margin_u, top_margin_v),//3
+				glm::vec2(right_margin_u, start_uv.y),//4
+				glm::vec2(right_margin_u, top_margin_v),//5
+				glm::vec2(end_uv.x, start_uv.y),//6
+				glm::vec2(end_uv.x, top_margin_v),//7
+
+				glm::vec2(start_uv.x, bottom_margin_v),//8
+				glm::vec2(left_margin_u, bottom_margin_v),//9
+				glm::vec2(right_margin_u, bottom_margin_v),//10
+				glm::vec2(end_uv.x, bottom_margin_v),//11
+				glm::vec2(start_uv.x, end_uv.y),//12
+				glm::vec2(left_margin_u, end_uv.y),//13
+				glm::vec2(right_margin_u, end_uv.y),//14
+				glm::vec2(end_uv.x, end_uv.y)//15
+			};
+
+			//transform all corners in one pass, then write the vertices straight into the batch
+			glm::vec2 positions[16];
+			transform_points(render_transform, local_positions, positions, 16);
+
+			FSlateVertex* vertices = render_batch.add_uninitialized_vertices(16);
+			for (int32_t vertex_index = 0; vertex_index < 16; ++vertex_index)
+			{
+				vertices[vertex_index].set_transformed<rounding>(positions[vertex_index], glm::vec4(uvs[vertex_index].x, uvs[vertex_index].y, tiling.x, tiling.y), packed_tint, packed_secondary_color, pixel_size_x, pixel_size_y);
+			}
+
+			static const SlateIndex nine_slice_indices[54] = {
+				//top
+				0, 1, 2, 2, 1, 3,
+				2, 3, 4, 4, 3, 5,
+				4, 5, 6, 6, 5, 7,
+
+				//middle
+				1, 8, 3, 3, 8, 9,
+				3, 9, 5, 5, 9, 10,
+				5, 10, 7, 7, 10, 11,
+
+				//bottom
+				8, 12, 9, 9, 12, 13,
+				9, 13, 10, 10, 13, 14,
+				10, 14, 11, 11, 14, 15
+			};
+
+			render_batch.add_indices(nine_slice_indices, 54);
 		}
 		else
 		{
@@ -364,18 +556,64 @@ namespace DoDo
 			end_uv.x = uv_max.x - (end_uv.x - uv_min.x);
 
 			//add four vertices to the list of verts to be added to the vertex buffer
-			render_batch.add_vertex(FSlateVertex::Make<rounding>(render_transform, top_left, local_size, draw_scale, glm::vec4(start_uv.x, start_uv.y, tiling.x, tiling.y), tint, secondary_color));
-			render_batch.add_vertex(FSlateVertex::Make<rounding>(render_transform, top_right, local_size, draw_scale, glm::vec4(end_uv.x, start_uv.y, tiling.x, tiling.y), tint, secondary_color));
-			render_batch.add_vertex(FSlateVertex::Make<rounding>(render_transform, bottom_left, local_size, draw_scale, glm::vec4(start_uv.x, end_uv.y, tiling.x, tiling.y), tint, secondary_color));
-			render_batch.add_vertex(FSlateVertex::Make<rounding>(render_transform, bottom_right, local_size, draw_scale, glm::vec4(end_uv.x, end_uv.y, tiling.x, tiling.y), tint, secondary_color));
-
-			render_batch.add_index(index_start + 0);
-			render_batch.add_index(index_start + 1);
-			render_batch.add_index(index_start + 2);
-
-			render_batch.add_index(index_start + 2);
-			render_batch.add_index(index_start + 1);
-			render_batch.add_index(index_start + 3);
+			const glm::vec2 local_positions[4] = { top_left, top_right, bottom_left, bottom_right };
+
+			const glm::vec2 uvs[4] = {
+				glm::vec2(start_uv.x, start_uv.y),
+				glm::vec2(end_uv.x, start_uv.y),
+				glm::vec2(start_uv.x, end_uv.y),
+				glm::vec2(end_uv.x, end_uv.y)
+			};
+
+			glm::vec2 positions[4];
+			transform_points(render_transform, local_positions, positions, 4);
+
+			FSlateVertex* vertices = render_batch.add_uninitialized_vertices(4);
+			for (int32_t vertex_index = 0; vertex_index < 4; ++vertex_index)
+			{
+				vertices[vertex_index].set_transformed<rounding>(positions[vertex_index], glm::vec4(uvs[vertex_index].x, uvs[vertex_index].y, tiling.x, tiling.y), packed_tint, packed_secondary_color, pixel_size_x, pixel_size_y);
+			}
+
+			static const SlateIndex quad_indices[6] = {
+				0, 1, 2,
+				2, 1, 3
+			};
+
+			render_batch.add_indices(quad_indices, 6);
+		}
+	}
+
+	template <ESlateVertexRounding rounding>
+	bool FSlateElementBatcher::add_box_instance(const FSlateDrawElement& draw_element, FSlateShaderResource* resource, const glm::vec2& start_uv, const glm::vec2& end_uv, const glm::vec4& tint)
+	{
+		const FSlateRenderTransform& render_transform = draw_element.get_render_transform();
+
+		float m00, m01, m10, m11;
+		render_transform.get_matrix().get_matrix(m00, m01, m10, m11);
+
+		//rotated and sheared boxes stay on the vertex path
+		if(m01 != 0.0f || m10 != 0.0f || !FSlateQuadInstance::can_store_uv(start_uv, end_uv))
+		{
+			return false;
+		}
+
+		const glm::vec2 local_size = draw_element.get_local_size();
+
+		FSlateRenderBatch& render_batch = m_batch_data->add_instanced_render_batch(draw_element.get_layer(), resource, draw_element.get_draw_effects());
+
+		FSlateQuadInstance& instance = render_batch.add_instance();
+		instance.m_origin = render_transform.get_translation();
+		instance.m_axis_x = glm::vec2(m00 * local_size.x, 0.0f);
+		instance.m_axis_y = glm::vec2(0.0f, m11 * local_size.y);
+
+		if(rounding == ESlateVertexRounding::Enabled)
+		{
+			//todo:implement round
 		}
+
+		instance.set_uv_rect(start_uv, end_uv);
+		instance.m_color = make_vertex_color(tint);
+
+		return true;
 	}
 }
@@ -18,8 +18,13 @@ namespace DoDo
 			: m_first_render_batch_index(-1)//todo:modify this to -1
 			, m_num_layers(0)
 			, m_num_batches(0)
+			, m_num_merged_batches(0)
+			, m_num_final_vertices(0)
+			, m_num_final_indices(0)
+			, m_num_final_instances(0)
 			, m_total_vertex_offset(0)
 			, m_total_index_offset(0)
+			, m_total_instance_offset(0)
 		{}
 
 		FSlateRenderBatch& add_render_batch(
@@ -29,25 +34,45 @@ namespace DoDo
 			ESlateDrawEffect in_draw_effects
 		);
 
+		/*adds a batch of quad instances, see FSlateQuadInstance*/
+		FSlateRenderBatch& add_instanced_render_batch(
+			int32_t in_layer,
+			FSlateShaderResource* shader_resource,
+			ESlateDrawEffect in_draw_effects
+		);
+
 		void reset_data();
 
 		/*
-		 * creates rendering data from batched elements
+		 * sorts and merges the render batches and assigns their offsets in the final buffers
+		 * nothing is copied yet, the renderer sizes it's buffers with the final counts and calls copy_final_data
 		 */
 		void merge_render_batches();
 
+		/*
+		 * writes the merged vertices, indices and instances straight into the destination, e.g. mapped gpu memory
+		 * the destinations must hold the final counts of the last merge_render_batches
+		 */
+		void copy_final_data(FSlateVertex* out_vertices, SlateIndex* out_indices, FSlateQuadInstance* out_instances) const;
+
 		/*
 		 * returns a list of element batches for this window
 		 */
 		const std::vector<FSlateRenderBatch>& get_render_batches() const { return m_render_batches; }
 
+		/*
+		 * adds the batches of cached elements, their vertices stay in the cached batch data and are copied on merge
+		 */
+		void add_cached_render_batches(const FSlateBatchData& cached_batch_data);
+
 		int32_t get_first_render_batch_index() const { return m_first_render_batch_index; }
 
 		const FSlateVertexArray& get_vertex_data() const { return m_uncached_source_batch_vertices; }
 		const FSlateIndexArray& get_index_data() const { return m_uncached_source_batch_indices; }
 
-		const FSlateVertexArray& get_final_vertex_data() const { return m_final_vertex_data; }
-		const FSlateIndexArray& get_final_index_data() const { return m_final_index_data; }
+		uint32_t get_num_final_vertices() const { return m_num_final_vertices; }
+		uint32_t get_num_final_indices() const { return m_num_final_indices; }
+		uint32_t get_num_final_instances() const { return m_num_final_instances; }
 
 		void set_total_vertex_offset(uint32_t offset) { m_total_vertex_offset = offset; }
 		void set_total_index_offset(uint32_t offset) { m_total_index_offset = offset; }
@@ -55,9 +80,31 @@ namespace DoDo
 		uint32_t get_total_vertex_offset() const { return m_total_vertex_offset; }
 		uint32_t get_total_index_offset() const { return m_total_index_offset; }
 
-		//todo:to implement merge render batches
+		void set_total_instance_offset(uint32_t offset) { m_total_instance_offset = offset; }
+		uint32_t get_total_instance_offset() const { return m_total_instance_offset; }
+
+		/*number of final render batches after merging, this is the draw call count*/
+		int32_t get_num_final_batches() const { return m_num_batches; }
+
+		/*number of render batches that were folded into a previous compatible batch*/
+		int32_t get_num_merged_batches() const { return m_num_merged_batches; }
+
 	protected:
-		void fill_buffers_from_new_batch(FSlateRenderBatch& batch, FSlateVertexArray& final_vertices, FSlateIndexArray& final_indices);
+		/*records the copy of batch to the end of the final buffers*/
+		void fill_buffers_from_new_batch(FSlateRenderBatch& batch);
+
+		/*
+		 * appends the vertices and indices of batch to the end of prev batch, indices are rebased to prev batch's vertices
+		 * the batches are drawn with prev batch's vertex offset as the base vertex
+		 * instanced batches just append their instances
+		 * note:prev batch must be the last batch written into the final buffers
+		 */
+		void combine_batches(FSlateRenderBatch& prev_batch, FSlateRenderBatch& batch);
+
+		/*
+		 * two batches can be drawn with one draw call when they share layer, shader resource, primitive type, draw effects and are both instanced or not
+		 */
+		static bool is_batch_compatible(const FSlateRenderBatch& prev_batch, const FSlateRenderBatch& batch);
 
 	private:
 		//todo:implement FSlateVertexArray and other information
@@ -70,18 +117,49 @@ namespace DoDo
 
 		FSlateIndexArray m_uncached_source_batch_indices;
 
-		FSlateVertexArray m_final_vertex_data;
+		FSlateQuadInstanceArray m_uncached_source_batch_instances;
 
-		FSlateIndexArray m_final_index_data;
+		/*a range of a source array that goes next in the final buffers*/
+		struct FFinalDataCopy
+		{
+			const FSlateVertexArray* m_source_vertices = nullptr;
+			const FSlateIndexArray* m_source_indices = nullptr;
+			const FSlateQuadInstanceArray* m_source_instances = nullptr;
+
+			int32_t m_source_vertex_offset = 0;
+			int32_t m_num_vertices = 0;
+
+			int32_t m_source_index_offset = 0;
+			int32_t m_num_indices = 0;
+
+			int32_t m_source_instance_offset = 0;
+			int32_t m_num_instances = 0;
+
+			/*added to the indices of batches merged into a previous batch*/
+			int32_t m_base_vertex = 0;
+		};
+
+		std::vector<FFinalDataCopy> m_final_data_copies;
+
+		uint32_t m_num_final_vertices;
+
+		uint32_t m_num_final_indices;
+
+		uint32_t m_num_final_instances;
 
 		int32_t m_num_layers;
 
 		/*number of final render batches, it is not the same as RenderBatches.Num()*/
 		int32_t m_num_batches;
 
+		/*number of render batches merged into another batch during merge_render_batches*/
+		int32_t m_num_merged_batches;
+
 		uint32_t m_total_vertex_offset;//todo:this record video memory buffer offset since last window element list
 
 		uint32_t m_total_index_offset;
+
+		uint32_t m_total_instance_offset;
 	};
 
 	/*
@@ -90,6 +168,17 @@ namespace DoDo
 	class FSlateElementBatcher
 	{
 	public:
+		FSlateElementBatcher()
+			: m_batch_data(nullptr)
+			, m_b_use_instanced_quads(false)
+			, m_b_skipped_pending_resources(false)
+		{}
+
+		/*
+		 * simple boxes are batched as FSlateQuadInstance instead of vertices, the renderer must have the instanced quad pipeline
+		 * 9-slice and rotated boxes always use vertices
+		 */
+		void set_use_instanced_quads(bool b_use_instanced_quads) { m_b_use_instanced_quads = b_use_instanced_quads; }
 
 		/*
 		 * batches elements to be rendered
@@ -107,6 +196,13 @@ namespace DoDo
 		template<ESlateVertexRounding rounding>
 		void add_box_element(const FSlateDrawElement& draw_element);
 
+		/*
+		 * adds a box without margins as one quad instance
+		 * @return false if the box can't be drawn as a instance, nothing is added then
+		 */
+		template<ESlateVertexRounding rounding>
+		bool add_box_instance(const FSlateDrawElement& draw_element, FSlateShaderResource* resource, const glm::vec2& start_uv, const glm::vec2& end_uv, const glm::vec4& tint);
+
 		FSlateRenderBatch& create_render_batch(
 			int32_t layer,
 			FSlateShaderResource* shader_resource,
@@ -118,6 +214,11 @@ namespace DoDo
 	private:
 		/*uncached batch data currently being filled in*/
 		FSlateBatchData* m_batch_data;//life time owns by the FSlateWindowElementList
+
+		bool m_b_use_instanced_quads;
+
+		/*an element was left out because its texture is still uploading*/
+		bool m_b_skipped_pending_resources;
 	};
 
 	
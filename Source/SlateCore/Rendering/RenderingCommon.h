@@ -4,8 +4,26 @@
 #include "Core/Misc/EnumClassFlags.h"//ENUM_CLASS_FLAGS
 #include "SlateRenderTransform.h"
 
+#include "glm/common.hpp"//glm::clamp
+
 //#include <vulkan/vulkan.h>
 
+/*
+ * use 32 bit indices so a single render batch can address more than 65536 vertices
+ * set from the build, see SLATE_USE_32BIT_INDICES option in the cmake lists
+ */
+#ifndef SLATE_USE_32BIT_INDICES
+#define SLATE_USE_32BIT_INDICES 0
+#endif
+
+/*
+ * store the vertex colors as r8g8b8a8 unorm instead of four floats, this shrinks FSlateVertex from 60 to 36 bytes
+ * set from the build, see SLATE_USE_PACKED_VERTEX_COLOR option in the cmake lists
+ */
+#ifndef SLATE_USE_PACKED_VERTEX_COLOR
+#define SLATE_USE_PACKED_VERTEX_COLOR 1
+#endif
+
 namespace DoDo
 {
 	//struct VertexInputDesription
@@ -32,6 +50,31 @@ namespace DoDo
 		Disabled,
 		Enabled
 	};
+
+#if SLATE_USE_PACKED_VERTEX_COLOR
+	/*vertex color packed to 8 bits per channel, the vertex shader reads it back as a normalized vec4*/
+	struct FSlateVertexColor
+	{
+		uint8_t r;
+		uint8_t g;
+		uint8_t b;
+		uint8_t a;
+	};
+
+	inline FSlateVertexColor make_vertex_color(const glm::vec4& in_color)
+	{
+		const glm::vec4 scaled = glm::clamp(in_color, 0.0f, 1.0f) * 255.0f + 0.5f;
+
+		return { (uint8_t)scaled.x, (uint8_t)scaled.y, (uint8_t)scaled.z, (uint8_t)scaled.w };
+	}
+#else
+	typedef glm::vec4 FSlateVertexColor;
+
+	inline FSlateVertexColor make_vertex_color(const glm::vec4& in_color)
+	{
+		return in_color;
+	}
+#endif
 	/*a struct which defines a basic vertex seen by the slate vertex buffers and shaders*/
 	struct FSlateVertex
 	{
@@ -45,10 +88,10 @@ namespace DoDo
 		glm::vec2 m_position;
 
 		/*vertex color*/
-		glm::vec4 m_color;
+		FSlateVertexColor m_color;
 
 		/*secondary vertex color, generally used for outlines*/
-		glm::vec4 m_secondary_color;
+		FSlateVertexColor m_secondary_color;
 
 		/*local size of the element*/
 		uint16_t m_pixel_size[2];
@@ -91,6 +134,31 @@ namespace DoDo
 			return vertex;
 		}
 
+		/*
+		 * fills a vertex whose position is already in window space, colors are already packed
+		 * used by the batcher when it transforms all corners of an element at once
+		 */
+		template<ESlateVertexRounding Rounding>
+		void set_transformed(const glm::vec2 in_position, const glm::vec4& in_tex_coords, const FSlateVertexColor in_color, const FSlateVertexColor in_secondary_color, const uint16_t in_pixel_size_x, const uint16_t in_pixel_size_y)
+		{
+			tex_coords[0] = in_tex_coords.x;
+			tex_coords[1] = in_tex_coords.y;
+			tex_coords[2] = in_tex_coords.z;
+			tex_coords[3] = in_tex_coords.w;
+
+			m_position = in_position;
+
+			if(Rounding == ESlateVertexRounding::Enabled)
+			{
+				//todo:implement round
+			}
+
+			m_color = in_color;
+			m_secondary_color = in_secondary_color;
+			m_pixel_size[0] = in_pixel_size_x;
+			m_pixel_size[1] = in_pixel_size_y;
+		}
+
 	private:
 		template<ESlateVertexRounding Rounding>
 		void init_common(const FSlateRenderTransform& render_transform, const glm::vec2 in_local_position, const glm::vec4 in_color, const glm::vec4 in_secondary_color)
@@ -103,13 +171,56 @@ namespace DoDo
 				//todo:implement round
 			}
 
-			m_color = in_color;
-			m_secondary_color = in_secondary_color;
+			m_color = make_vertex_color(in_color);
+			m_secondary_color = make_vertex_color(in_secondary_color);
 		}
 
 		
 	};
 
+#if SLATE_USE_PACKED_VERTEX_COLOR
+	static_assert(sizeof(FSlateVertex) == 36, "packed FSlateVertex layout changed, check the vertex input description");
+#endif
+
+	/*
+	 * a simple box drawn as one instance, the instanced quad vertex shader expands it to the four corners
+	 * corner = origin + u * axis_x + v * axis_y, uv goes from the start uv at the origin to the end uv at the far corner
+	 * replaces 4 FSlateVertex and 6 indices
+	 */
+	struct FSlateQuadInstance
+	{
+		/*window space position of the top left corner*/
+		glm::vec2 m_origin;
+
+		/*window space edges from the top left corner to the top right and bottom left corners*/
+		glm::vec2 m_axis_x;
+		glm::vec2 m_axis_y;
+
+		/*start uv and end uv, normalized to 16 bits, the vertex shader reads them as a vec4*/
+		uint16_t m_uv_rect[4];
+
+		FSlateVertexColor m_color;
+
+		/*@return false when the uv can't be stored in the normalized uv rect, the box must use vertices then*/
+		static bool can_store_uv(const glm::vec2& start_uv, const glm::vec2& end_uv)
+		{
+			return start_uv.x >= 0.0f && start_uv.x <= 1.0f && start_uv.y >= 0.0f && start_uv.y <= 1.0f
+				&& end_uv.x >= 0.0f && end_uv.x <= 1.0f && end_uv.y >= 0.0f && end_uv.y <= 1.0f;
+		}
+
+		void set_uv_rect(const glm::vec2& start_uv, const glm::vec2& end_uv)
+		{
+			m_uv_rect[0] = (uint16_t)(start_uv.x * 65535.0f + 0.5f);
+			m_uv_rect[1] = (uint16_t)(start_uv.y * 65535.0f + 0.5f);
+			m_uv_rect[2] = (uint16_t)(end_uv.x * 65535.0f + 0.5f);
+			m_uv_rect[3] = (uint16_t)(end_uv.y * 65535.0f + 0.5f);
+		}
+	};
+
+#if SLATE_USE_PACKED_VERTEX_COLOR
+	static_assert(sizeof(FSlateQuadInstance) == 36, "FSlateQuadInstance layout changed, check the instance input description");
+#endif
+
 	/*
 	VertexInputDesription FSlateVertex::get_vertex_description()
 	{
@@ -186,5 +297,12 @@ namespace DoDo
 
 	typedef std::vector<FSlateDrawElement> FSlateDrawElementArray;
 	typedef std::vector<FSlateVertex> FSlateVertexArray;
-	typedef std::vector<uint16_t> FSlateIndexArray;
+	typedef std::vector<FSlateQuadInstance> FSlateQuadInstanceArray;
+#if SLATE_USE_32BIT_INDICES
+	typedef uint32_t SlateIndex;
+#else
+	typedef uint16_t SlateIndex;
+#endif
+
+	typedef std::vector<SlateIndex> FSlateIndexArray;
 }
@@ -0,0 +1,281 @@
+#include <PreCompileHeader.h>
+
+#include "SlateDamageTracker.h"
+
+#include "ElementBatcher.h"//FSlateBatchData depends on it
+
+#include "SlateRenderBatch.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace DoDo
+{
+	/*fnv-1a over 8 byte words, the hash only has to tell the batches of two frames apart*/
+	static uint64_t hash_bytes(uint64_t hash, const void* data, size_t size)
+	{
+		const uint8_t* bytes = static_cast<const uint8_t*>(data);
+
+		const uint64_t prime = 1099511628211ull;
+
+		for(; size >= sizeof(uint64_t); size -= sizeof(uint64_t), bytes += sizeof(uint64_t))
+		{
+			uint64_t word;
+			std::memcpy(&word, bytes, sizeof(uint64_t));
+			hash = (hash ^ word) * prime;
+		}
+
+		for(; size > 0; --size, ++bytes)
+		{
+			hash = (hash ^ *bytes) * prime;
+		}
+
+		return hash;
+	}
+
+	static FSlateRect union_rects(const FSlateRect& a, const FSlateRect& b)
+	{
+		return FSlateRect(std::min(a.left, b.left), std::min(a.top, b.top), std::max(a.right, b.right), std::max(a.bottom, b.bottom));
+	}
+
+	static float get_area(const FSlateRect& rect)
+	{
+		return (rect.right - rect.left) * (rect.bottom - rect.top);
+	}
+
+	FSlateDamageTracker::FSlateDamageTracker()
+		: m_history(max_history_frames)
+		, m_view_port_size(0.0f, 0.0f)
+		, m_frame_number(0)
+		, m_b_invalidated(true)
+	{
+	}
+
+	void FSlateDamageTracker::gather_damage(const FSlateBatchData& batch_data, const glm::vec2& view_port_size)
+	{
+		++m_frame_number;
+
+		FFrameDamage& frame_damage = m_history[m_frame_number % max_history_frames];
+		frame_damage.m_frame_number = m_frame_number;
+		frame_damage.m_rects.clear();
+		frame_damage.m_b_full = m_b_invalidated || view_port_size != m_view_port_size;
+
+		m_b_invalidated = false;
+		m_view_port_size = view_port_size;
+
+		m_signatures.clear();
+		for(const FSlateRenderBatch& render_batch : batch_data.get_render_batches())
+		{
+			if(render_batch.has_vertex_data())
+			{
+				m_signatures.push_back(make_signature(render_batch));
+			}
+		}
+
+		std::sort(m_signatures.begin(), m_signatures.end(), [](const FBatchSignature& a, const FBatchSignature& b)
+		{
+			return a.m_hash < b.m_hash;
+		});
+
+		if(!frame_damage.m_b_full)
+		{
+			//both lists are sorted, a batch without an equal batch in the other frame appeared, disappeared or changed
+			size_t current_index = 0;
+			size_t previous_index = 0;
+			while(current_index < m_signatures.size() && previous_index < m_previous_signatures.size())
+			{
+				const FBatchSignature& current = m_signatures[current_index];
+				const FBatchSignature& previous = m_previous_signatures[previous_index];
+
+				if(current.m_hash == previous.m_hash)
+				{
+					++current_index;
+					++previous_index;
+				}
+				else if(current.m_hash < previous.m_hash)
+				{
+					frame_damage.m_rects.push_back(current.m_bounds);
+					++current_index;
+				}
+				else
+				{
+					frame_damage.m_rects.push_back(previous.m_bounds);
+					++previous_index;
+				}
+			}
+
+			for(; current_index < m_signatures.size(); ++current_index)
+			{
+				frame_damage.m_rects.push_back(m_signatures[current_index].m_bounds);
+			}
+
+			for(; previous_index < m_previous_signatures.size(); ++previous_index)
+			{
+				frame_damage.m_rects.push_back(m_previous_signatures[previous_index].m_bounds);
+			}
+
+			if(!merge_damage_rects(frame_damage.m_rects, m_view_port_size))
+			{
+				frame_damage.m_b_full = true;
+				frame_damage.m_rects.clear();
+			}
+		}
+
+		std::swap(m_signatures, m_previous_signatures);
+	}
+
+	bool FSlateDamageTracker::get_damage_since(uint64_t since_frame, std::vector<FSlateRect>& out_rects) const
+	{
+		out_rects.clear();
+
+		//never drawn, or the history doesn't reach back to the image's frame
+		if(since_frame == UINT64_MAX || since_frame > m_frame_number || m_frame_number - since_frame > max_history_frames)
+		{
+			return false;
+		}
+
+		for(uint64_t frame_number = since_frame + 1; frame_number <= m_frame_number; ++frame_number)
+		{
+			const FFrameDamage& frame_damage = m_history[frame_number % max_history_frames];
+			if(frame_damage.m_b_full)
+			{
+				return false;
+			}
+
+			out_rects.insert(out_rects.end(), frame_damage.m_rects.begin(), frame_damage.m_rects.end());
+		}
+
+		if(!merge_damage_rects(out_rects, m_view_port_size))
+		{
+			out_rects.clear();
+			return false;
+		}
+
+		return true;
+	}
+
+	FSlateDamageTracker::FBatchSignature FSlateDamageTracker::make_signature(const FSlateRenderBatch& render_batch)
+	{
+		uint64_t hash = 14695981039346656037ull;
+
+		const int32_t layer = render_batch.get_layer();
+		const FSlateShaderResource* shader_resource = render_batch.get_shader_resource();
+		hash = hash_bytes(hash, &layer, sizeof(layer));
+		hash = hash_bytes(hash, &shader_resource, sizeof(shader_resource));
+		hash = hash_bytes(hash, &render_batch.m_draw_primitive_type, sizeof(render_batch.m_draw_primitive_type));
+		hash = hash_bytes(hash, &render_batch.m_draw_effects, sizeof(render_batch.m_draw_effects));
+
+		glm::vec2 min_position(std::numeric_limits<float>::max());
+		glm::vec2 max_position(std::numeric_limits<float>::lowest());
+
+		if(render_batch.is_instanced())
+		{
+			const FSlateQuadInstance* instances = render_batch.m_source_instances->data() + render_batch.m_instance_offset;
+
+			hash = hash_bytes(hash, instances, render_batch.m_num_instances * sizeof(FSlateQuadInstance));
+
+			for(int32_t instance_index = 0; instance_index < render_batch.m_num_instances; ++instance_index)
+			{
+				const FSlateQuadInstance& instance = instances[instance_index];
+
+				const glm::vec2 corners[4] = { instance.m_origin, instance.m_origin + instance.m_axis_x, instance.m_origin + instance.m_axis_y,
+					instance.m_origin + instance.m_axis_x + instance.m_axis_y };
+
+				for(const glm::vec2& corner : corners)
+				{
+					min_position = glm::min(min_position, corner);
+					max_position = glm::max(max_position, corner);
+				}
+			}
+		}
+		else
+		{
+			const FSlateVertex* vertices = render_batch.m_source_vertices->data() + render_batch.m_vertex_offset;
+			const SlateIndex* indices = render_batch.m_source_indices->data() + render_batch.m_index_offset;
+
+			hash = hash_bytes(hash, vertices, render_batch.m_num_vertices * sizeof(FSlateVertex));
+			hash = hash_bytes(hash, indices, render_batch.m_num_indices * sizeof(SlateIndex));
+
+			for(int32_t vertex_index = 0; vertex_index < render_batch.m_num_vertices; ++vertex_index)
+			{
+				min_position = glm::min(min_position, vertices[vertex_index].m_position);
+				max_position = glm::max(max_position, vertices[vertex_index].m_position);
+			}
+		}
+
+		FBatchSignature signature;
+		signature.m_hash = hash;
+
+		//whole pixels, one more on every side for pixels the rasterizer touches at the edges
+		signature.m_bounds = FSlateRect(std::floor(min_position.x) - 1.0f, std::floor(min_position.y) - 1.0f, std::ceil(max_position.x) + 1.0f, std::ceil(max_position.y) + 1.0f);
+
+		return signature;
+	}
+
+	bool FSlateDamageTracker::merge_damage_rects(std::vector<FSlateRect>& rects, const glm::vec2& view_port_size)
+	{
+		const FSlateRect view_port_rect(0.0f, 0.0f, view_port_size.x, view_port_size.y);
+
+		//off screen batches damage nothing
+		size_t num_rects = 0;
+		for(const FSlateRect& rect : rects)
+		{
+			bool b_overlapping = false;
+			const FSlateRect clamped_rect = rect.intersection_with(view_port_rect, b_overlapping);
+			if(b_overlapping)
+			{
+				rects[num_rects++] = clamped_rect;
+			}
+		}
+		rects.resize(num_rects);
+
+		//uniting is quadratic, lots of small changes are redrawn as their bounds
+		if(rects.size() > size_t(max_damage_rects) * 16)
+		{
+			for(size_t rect_index = 1; rect_index < rects.size(); ++rect_index)
+			{
+				rects[0] = union_rects(rects[0], rects[rect_index]);
+			}
+			rects.resize(1);
+		}
+
+		//a united rect can overlap rects that were checked before, so start over after every union
+		bool b_united = true;
+		while(b_united)
+		{
+			b_united = false;
+			for(size_t a = 0; a < rects.size() && !b_united; ++a)
+			{
+				for(size_t b = a + 1; b < rects.size(); ++b)
+				{
+					if(FSlateRect::do_rectangles_intersect(rects[a], rects[b]))
+					{
+						rects[a] = union_rects(rects[a], rects[b]);
+						rects.erase(rects.begin() + b);
+						b_united = true;
+						break;
+					}
+				}
+			}
+		}
+
+		if(rects.size() > size_t(max_damage_rects))
+		{
+			for(size_t rect_index = 1; rect_index < rects.size(); ++rect_index)
+			{
+				rects[0] = union_rects(rects[0], rects[rect_index]);
+			}
+			rects.resize(1);
+		}
+
+		float damaged_area = 0.0f;
+		for(const FSlateRect& rect : rects)
+		{
+			damaged_area += get_area(rect);
+		}
+
+		return damaged_area <= full_redraw_area_ratio * view_port_size.x * view_port_size.y;
+	}
+}
@@ -0,0 +1,105 @@
+#pragma once
+
+#include "Core/Core.h"
+
+#include "SlateCore/Layout/SlateRect.h"//FSlateRect
+
+#include "glm/glm.hpp"
+
+namespace DoDo
+{
+	class FSlateBatchData;
+	class FSlateRenderBatch;
+
+	/*
+	 * finds the parts of a window that changed since the previous frame
+	 * every render batch is reduced to its pixel bounds and a hash of its state and vertices, a batch that is only in one of the two frames
+	 * damages its bounds, so a widget that moved damages its old and its new place and a blinking cursor only damages itself
+	 * the damage of the last frames is kept, an image that was drawn some frames ago, e.g. an older swap chain image, redraws everything
+	 * that changed since it was drawn
+	 * note:identical batches that swap their order inside a layer aren't seen
+	 */
+	class FSlateDamageTracker
+	{
+	public:
+		/*more damage rects are merged into their bounds, every rect draws the batches of the window again*/
+		static const int32_t max_damage_rects = 4;
+
+		/*frames of damage kept, an image drawn longer ago is redrawn fully*/
+		static const int32_t max_history_frames = 8;
+
+		/*redrawing more than this part of the window is done with a full redraw*/
+		static constexpr float full_redraw_area_ratio = 0.5f;
+
+		FSlateDamageTracker();
+
+		/*
+		 * compares the render batches of the frame with the previous frame and records the damage
+		 * call it after the window was batched and before merge_render_batches, merging changes the batches
+		 *
+		 * @param view_port_size the damage is clamped to it, a different size than in the previous frame damages everything
+		 */
+		void gather_damage(const FSlateBatchData& batch_data, const glm::vec2& view_port_size);
+
+		/*
+		 * the rects to redraw in an image that holds the frame since_frame
+		 *
+		 * @param since_frame the get_frame_number when the image was drawn last, UINT64_MAX if it was never drawn
+		 * @param out_rects pixel aligned and not overlapping, empty if nothing changed
+		 * @return false if the whole image must be redrawn
+		 */
+		bool get_damage_since(uint64_t since_frame, std::vector<FSlateRect>& out_rects) const;
+
+		/*damages the whole window in the next gather_damage, e.g. when batches were left out of the draw*/
+		void invalidate_all() { m_b_invalidated = true; }
+
+		/*number of gather_damage calls, an image drawn after the last one holds this frame*/
+		uint64_t get_frame_number() const { return m_frame_number; }
+
+	private:
+		/*a render batch of one frame*/
+		struct FBatchSignature
+		{
+			uint64_t m_hash;
+
+			FSlateRect m_bounds;
+		};
+
+		struct FFrameDamage
+		{
+			uint64_t m_frame_number;
+
+			/*the whole window changed, the rects are empty*/
+			bool m_b_full;
+
+			std::vector<FSlateRect> m_rects;
+
+			FFrameDamage()
+				: m_frame_number(0)
+				, m_b_full(true)
+			{}
+		};
+
+		static FBatchSignature make_signature(const FSlateRenderBatch& render_batch);
+
+		/*
+		 * unites overlapping rects until none overlap and clamps them to the view port
+		 * @return false if the rects cover too much of the view port to be worth a partial redraw
+		 */
+		static bool merge_damage_rects(std::vector<FSlateRect>& rects, const glm::vec2& view_port_size);
+
+		/*signatures of the previous frame sorted by hash, kept between frames to keep their memory*/
+		std::vector<FBatchSignature> m_previous_signatures;
+
+		std::vector<FBatchSignature> m_signatures;
+
+		/*ring of the damage of the last frames, indexed by frame number*/
+		std::vector<FFrameDamage> m_history;
+
+		glm::vec2 m_view_port_size;
+
+		uint64_t m_frame_number;
+
+		bool m_b_invalidated;
+	};
+}
@@ -19,7 +19,9 @@ namespace DoDo
 			FSlateVertexArray* in_source_vertex_array,
 			FSlateIndexArray* in_source_index_array,
 			int32_t in_vertex_offset,
-			int32_t in_index_offset
+			int32_t in_index_offset,
+			FSlateQuadInstanceArray* in_source_instance_array = nullptr,
+			int32_t in_instance_offset = 0
 		);//todo:implement FSlateVertexArray, FSlateIndexArray, InVertexOffset, InIndexOffset
 
 		void add_vertex(FSlateVertex&& vertex)//move
@@ -28,12 +30,36 @@ namespace DoDo
 			++m_num_vertices;
 		}
 
-		void add_index(uint16_t index)
+		void add_index(SlateIndex index)
 		{
 			m_source_indices->push_back(index);
 			++m_num_indices;
 		}
 
+		/*
+		 * grows the source vertex array by num vertices and returns the first new vertex, the caller must fill all of them
+		 */
+		FSlateVertex* add_uninitialized_vertices(int32_t num)
+		{
+			const size_t first_vertex = m_source_vertices->size();
+			m_source_vertices->resize(first_vertex + num);
+			m_num_vertices += num;
+			return m_source_vertices->data() + first_vertex;
+		}
+
+		void add_indices(const SlateIndex* indices, int32_t num)
+		{
+			m_source_indices->insert(m_source_indices->end(), indices, indices + num);
+			m_num_indices += num;
+		}
+
+		/*adds one quad to a instanced batch*/
+		FSlateQuadInstance& add_instance()
+		{
+			++m_num_instances;
+			return m_source_instances->emplace_back();
+		}
+
 		uint32_t get_vertex_offset() const
 		{
 			return m_vertex_offset;
@@ -44,11 +70,14 @@ namespace DoDo
 			return m_index_offset;
 		}
 
-		bool has_vertex_data()
+		bool has_vertex_data() const
 		{
-			return m_num_vertices > 0 && m_num_indices > 0;
+			return is_instanced() ? m_num_instances > 0 : m_num_vertices > 0 && m_num_indices > 0;
 		}
 
+		/*instanced batches draw quads from the instance array instead of vertices and indices*/
+		bool is_instanced() const { return m_source_instances != nullptr; }
+
 		int32_t get_layer() const { return m_layer_id; }
 
 		const FSlateShaderResource* get_shader_resource() const { return m_shader_resource; }
@@ -60,6 +89,9 @@ namespace DoDo
 		FSlateVertexArray* m_source_vertices;//don't owner the life time of FSlateVertexArray, this is owned by the element batcher
 
 		FSlateIndexArray* m_source_indices;
+
+		/*only set for instanced batches, don't owner the life time*/
+		FSlateQuadInstanceArray* m_source_instances;
 		/*the layer we need to sort by*/
 		int32_t m_layer_id;
 
@@ -73,6 +105,11 @@ namespace DoDo
 
 		int32_t m_index_offset;//this is number
 
+		/*number of quads in a instanced batch*/
+		int32_t m_num_instances;
+
+		int32_t m_instance_offset;//this is number
+
 		int32_t m_next_batch_index;//next batch
 
 		ESlateDrawPrimitive m_draw_primitive_type;
@@ -37,6 +37,15 @@ namespace DoDo
 		}
 	}
 
+	void FSlotBase::invalidate(EInvalidateWidgetReason invalidate_reason)
+	{
+		//the owner invalidates it's invalidation root, the cached elements of the slot content are stale
+		if(SWidget* owner_widget = get_owner_widget())
+		{
+			owner_widget->Invalidate(invalidate_reason);
+		}
+	}
+
 	void FSlotBase::set_owner(const FChildren& children)
 	{
 		if(m_owner != &children)
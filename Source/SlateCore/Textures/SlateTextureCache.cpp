@@ -0,0 +1,201 @@
+#include <PreCompileHeader.h>
+
+#include "SlateTextureCache.h"
+
+namespace DoDo {
+	static const char cache_magic[4] = { 'D', 'D', 'T', 'C' };
+
+	static const uint64_t cache_pixel_alignment = 16;
+
+	bool FSlateTextureCache::open(const DoDoUtf8String& cache_path)
+	{
+		close();
+
+		if (!m_mapped_file.open(cache_path.c_str()))
+		{
+			return false;
+		}
+
+		const uint8_t* data = m_mapped_file.get_data();
+		const uint64_t file_size = m_mapped_file.get_size();
+
+		const FHeader* header = (const FHeader*)data;
+
+		if (file_size < sizeof(FHeader) || std::memcmp(header->m_magic, cache_magic, sizeof(cache_magic)) != 0 || header->m_version != cache_version
+			|| file_size < sizeof(FHeader) + (uint64_t)header->m_num_entries * sizeof(FEntry))
+		{
+			close();
+			return false;
+		}
+
+		const FEntry* entries = (const FEntry*)(data + sizeof(FHeader));
+
+		for (uint32_t entry_index = 0; entry_index < header->m_num_entries; ++entry_index)
+		{
+			const FEntry& entry = entries[entry_index];
+
+			const uint64_t pixel_size = (uint64_t)entry.m_width * entry.m_height * 4;
+
+			//a truncated file keeps the entries that are still complete
+			if (entry.m_path_offset + entry.m_path_length > file_size || entry.m_pixel_offset + pixel_size > file_size)
+			{
+				continue;
+			}
+
+			const DoDoUtf8String source_path(std::string((const char*)data + entry.m_path_offset, entry.m_path_length));
+
+			m_entries.insert({ source_path, &entry });
+		}
+
+		return true;
+	}
+
+	void FSlateTextureCache::close()
+	{
+		m_entries.clear();
+
+		m_mapped_file.close();
+	}
+
+	const uint8_t* FSlateTextureCache::find(const DoDoUtf8String& source_path, uint32_t& out_width, uint32_t& out_height) const
+	{
+		auto it = m_entries.find(source_path);
+
+		if (it == m_entries.end())
+		{
+			return nullptr;
+		}
+
+		const FEntry& entry = *it->second;
+
+		int64_t modification_time = 0;
+		uint64_t source_size = 0;
+
+		//stale entries are decoded from the source again
+		if (!get_source_state(source_path, modification_time, source_size) || modification_time != entry.m_source_modification_time || source_size != entry.m_source_size)
+		{
+			return nullptr;
+		}
+
+		out_width = entry.m_width;
+		out_height = entry.m_height;
+
+		return m_mapped_file.get_data() + entry.m_pixel_offset;
+	}
+
+	bool FSlateTextureCache::write(const DoDoUtf8String& cache_path, const std::vector<FSlateCookedTexture>& textures)
+	{
+		std::vector<FEntry> entries;
+		std::vector<const FSlateCookedTexture*> written_textures;
+
+		for (const FSlateCookedTexture& texture : textures)
+		{
+			FEntry entry;
+
+			//images that are gone can't be validated later
+			if (!get_source_state(texture.m_source_path, entry.m_source_modification_time, entry.m_source_size))
+			{
+				continue;
+			}
+
+			entry.m_path_length = (uint32_t)std::strlen(texture.m_source_path.c_str());
+			entry.m_width = texture.m_width;
+			entry.m_height = texture.m_height;
+			entry.m_padding = 0;
+
+			entries.push_back(entry);
+			written_textures.push_back(&texture);
+		}
+
+		//paths follow the table, the pixels follow the paths
+		uint64_t offset = sizeof(FHeader) + entries.size() * sizeof(FEntry);
+
+		for (FEntry& entry : entries)
+		{
+			entry.m_path_offset = offset;
+			offset += entry.m_path_length;
+		}
+
+		for (FEntry& entry : entries)
+		{
+			offset = (offset + cache_pixel_alignment - 1) & ~(cache_pixel_alignment - 1);
+			entry.m_pixel_offset = offset;
+			offset += (uint64_t)entry.m_width * entry.m_height * 4;
+		}
+
+		FHeader header;
+		std::memcpy(header.m_magic, cache_magic, sizeof(cache_magic));
+		header.m_version = cache_version;
+		header.m_num_entries = (uint32_t)entries.size();
+		header.m_padding = 0;
+
+		const std::filesystem::path final_path(cache_path.c_str());
+		const std::filesystem::path temporary_path(std::string(cache_path.c_str()) + ".tmp");
+
+		std::error_code error;
+		std::filesystem::create_directories(final_path.parent_path(), error);
+
+		{
+			std::ofstream file(temporary_path, std::ios::binary | std::ios::trunc);
+
+			if (!file)
+			{
+				return false;
+			}
+
+			file.write((const char*)&header, sizeof(FHeader));
+			file.write((const char*)entries.data(), entries.size() * sizeof(FEntry));
+
+			for (const FSlateCookedTexture* texture : written_textures)
+			{
+				file.write(texture->m_source_path.c_str(), std::strlen(texture->m_source_path.c_str()));
+			}
+
+			const char zeros[cache_pixel_alignment] = {};
+
+			for (size_t entry_index = 0; entry_index < entries.size(); ++entry_index)
+			{
+				const uint64_t padding = entries[entry_index].m_pixel_offset - (uint64_t)file.tellp();
+				file.write(zeros, padding);
+
+				file.write((const char*)written_textures[entry_index]->m_pixels, (std::streamsize)entries[entry_index].m_width * entries[entry_index].m_height * 4);
+			}
+
+			if (!file)
+			{
+				file.close();
+				std::filesystem::remove(temporary_path, error);
+				return false;
+			}
+		}
+
+		//a reader never sees a half written cache
+		std::filesystem::rename(temporary_path, final_path, error);
+
+		if (error)
+		{
+			std::filesystem::remove(temporary_path, error);
+			return false;
+		}
+
+		return true;
+	}
+
+	bool FSlateTextureCache::get_source_state(const DoDoUtf8String& source_path, int64_t& out_modification_time, uint64_t& out_size)
+	{
+		std::error_code error;
+
+		const std::filesystem::path path(source_path.c_str());
+
+		out_size = (uint64_t)std::filesystem::file_size(path, error);
+
+		if (error)
+		{
+			return false;
+		}
+
+		out_modification_time = (int64_t)std::filesystem::last_write_time(path, error).time_since_epoch().count();
+
+		return !error;
+	}
+}
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <vector>
+
+#include <map>
+
+#include "Core/String/DoDoString.h"//FSlateTextureCache depends on it
+
+#include "Core/Misc/MappedFile.h"//FSlateTextureCache depends on it
+
+namespace DoDo {
+	/*decoded pixels of one image, written by FSlateTextureCache::write*/
+	struct FSlateCookedTexture
+	{
+		/*the image file the pixels were decoded from, also the key of the entry*/
+		DoDoUtf8String m_source_path;
+
+		uint32_t m_width;
+
+		uint32_t m_height;
+
+		/*tightly packed rgba8 pixels, must stay valid until write returned*/
+		const uint8_t* m_pixels;
+
+		FSlateCookedTexture(const DoDoUtf8String& in_source_path, uint32_t in_width, uint32_t in_height, const uint8_t* in_pixels)
+			: m_source_path(in_source_path)
+			, m_width(in_width)
+			, m_height(in_height)
+			, m_pixels(in_pixels)
+		{}
+	};
+
+	/*
+	 * cooked texture cache, the decoded rgba8 pixels of the style images in one memory mapped file
+	 * an entry is only used while the size and modification time of its source image match the ones it was cooked from
+	 *
+	 * layout: header, entry table, source paths, pixels of every entry aligned to 16 bytes
+	 * the file is written and read on the same platform, so the structs are stored as they are in memory
+	 */
+	class FSlateTextureCache
+	{
+	public:
+		/*bump when the layout of the file changes, files of other versions are ignored*/
+		static constexpr uint32_t cache_version = 1;
+
+		/*
+		 * maps the cache file and reads its entry table, the pixels stay on disk until they are used
+		 *
+		 * @return false if the file is missing or not a cache of this version
+		 */
+		bool open(const DoDoUtf8String& cache_path);
+
+		/*unmaps the file, pixels returned by find are invalid afterwards*/
+		void close();
+
+		bool is_open() const { return m_mapped_file.is_open(); }
+
+		/*
+		 * @return the pixels of the image inside the mapping, nullptr if there is no entry or the image changed since it was cooked
+		 */
+		const uint8_t* find(const DoDoUtf8String& source_path, uint32_t& out_width, uint32_t& out_height) const;
+
+		/*
+		 * writes a new cache file, it is written next to the old one first and then replaces it
+		 * the caller must close a cache opened from the same path before
+		 *
+		 * @return false if the file couldn't be written
+		 */
+		static bool write(const DoDoUtf8String& cache_path, const std::vector<FSlateCookedTexture>& textures);
+	private:
+		struct FHeader
+		{
+			char m_magic[4];
+
+			uint32_t m_version;
+
+			uint32_t m_num_entries;
+
+			uint32_t m_padding;
+		};
+
+		struct FEntry
+		{
+			/*source image state when it was cooked*/
+			int64_t m_source_modification_time;
+
+			uint64_t m_source_size;
+
+			/*byte offsets from the start of the file*/
+			uint64_t m_path_offset;
+
+			uint64_t m_pixel_offset;
+
+			uint32_t m_path_length;
+
+			uint32_t m_width;
+
+			uint32_t m_height;
+
+			uint32_t m_padding;
+		};
+
+		/*
+		 * @return false if the file doesn't exist
+		 */
+		static bool get_source_state(const DoDoUtf8String& source_path, int64_t& out_modification_time, uint64_t& out_size);
+
+		FMappedFile m_mapped_file;
+
+		/*entries of the mapped file by source path*/
+		std::map<DoDoUtf8String, const FEntry*> m_entries;
+	};
+}
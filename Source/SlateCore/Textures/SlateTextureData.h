@@ -10,11 +10,23 @@ namespace DoDo {
 	*/
 	struct FSlateTextureData
 	{
-		FSlateTextureData(uint32_t in_width = 0, uint32_t in_height = 0, uint32_t in_bytes_per_pixel = 0, const std::vector<uint8_t>& in_bytes = std::vector<uint8_t>())
-			: m_bytes(in_bytes)
+		FSlateTextureData(uint32_t in_width = 0, uint32_t in_height = 0, uint32_t in_bytes_per_pixel = 0, std::vector<uint8_t> in_bytes = std::vector<uint8_t>())
+			: m_bytes(std::move(in_bytes))
 			, m_width(in_width)
 			, m_height(in_height)
 			, m_bytes_per_pixel(in_bytes_per_pixel)
+			, m_external_bytes(nullptr)
+		{
+		}
+
+		/*
+		* references pixels owned by someone else, e.g. a mapped texture cache, they must outlive the upload
+		*/
+		FSlateTextureData(uint32_t in_width, uint32_t in_height, uint32_t in_bytes_per_pixel, const uint8_t* in_external_bytes)
+			: m_width(in_width)
+			, m_height(in_height)
+			, m_bytes_per_pixel(in_bytes_per_pixel)
+			, m_external_bytes(in_external_bytes)
 		{
 		}
 
@@ -28,9 +40,10 @@ namespace DoDo {
 			return m_height;
 		}
 
-		const std::vector<uint8_t>& get_raw_bytes() const
+		/*tightly packed pixels, width * height * bytes per pixel*/
+		const uint8_t* get_data() const
 		{
-			return m_bytes;
+			return m_external_bytes != nullptr ? m_external_bytes : m_bytes.data();
 		}
 	private:
 		/*raw uncompressed texture data*/
@@ -44,6 +57,9 @@ namespace DoDo {
 
 		/*the number of bytes of each pixel*/
 		uint32_t m_bytes_per_pixel;
+
+		/*pixels not owned by the texture data, used instead of m_bytes if set*/
+		const uint8_t* m_external_bytes;
 	};
 
 	typedef std::shared_ptr<FSlateTextureData> FSlateTextureDataPtr;
@@ -0,0 +1,108 @@
+#include <PreCompileHeader.h>
+
+#include "TextureAtlas.h"
+
+namespace DoDo {
+	FSlateTextureAtlas::FSlateTextureAtlas(uint32_t in_width, uint32_t in_height, uint32_t in_bytes_per_pixel, uint32_t in_padding)
+		: m_atlas_data((size_t)in_width * in_height * in_bytes_per_pixel, 0)
+		, m_atlas_width(in_width)
+		, m_atlas_height(in_height)
+		, m_bytes_per_pixel(in_bytes_per_pixel)
+		, m_padding(in_padding)
+		, m_used_pixels(0)
+		, m_b_needs_update(false)
+	{
+	}
+
+	const FAtlasedTextureSlot* FSlateTextureAtlas::add_texture(uint32_t texture_width, uint32_t texture_height, const uint8_t* data)
+	{
+		if(texture_width == 0 || texture_height == 0 || data == nullptr)
+		{
+			return nullptr;
+		}
+
+		const uint32_t slot_width = texture_width + m_padding * 2;
+		const uint32_t slot_height = texture_height + m_padding * 2;
+
+		FShelf* shelf = find_shelf(slot_width, slot_height);
+
+		if(shelf == nullptr)
+		{
+			return nullptr;
+		}
+
+		m_slots.push_back(std::make_unique<FAtlasedTextureSlot>(shelf->m_used_width, shelf->m_y, slot_width, slot_height, m_padding));
+
+		shelf->m_used_width += slot_width;
+
+		const FAtlasedTextureSlot& new_slot = *m_slots.back();
+
+		copy_data_into_slot(new_slot, texture_width, texture_height, data);
+
+		m_used_pixels += (uint64_t)slot_width * slot_height;
+
+		m_b_needs_update = true;
+
+		return &new_slot;
+	}
+
+	float FSlateTextureAtlas::get_occupancy() const
+	{
+		return (float)((double)m_used_pixels / ((double)m_atlas_width * m_atlas_height));
+	}
+
+	FSlateTextureAtlas::FShelf* FSlateTextureAtlas::find_shelf(uint32_t slot_width, uint32_t slot_height)
+	{
+		FShelf* best_shelf = nullptr;
+
+		for(FShelf& shelf : m_shelves)
+		{
+			if(shelf.m_height >= slot_height && m_atlas_width - shelf.m_used_width >= slot_width)
+			{
+				if(best_shelf == nullptr || shelf.m_height < best_shelf->m_height)
+				{
+					best_shelf = &shelf;
+				}
+			}
+		}
+
+		if(best_shelf != nullptr)
+		{
+			return best_shelf;
+		}
+
+		const uint32_t next_shelf_y = m_shelves.empty() ? 0 : m_shelves.back().m_y + m_shelves.back().m_height;
+
+		if(slot_width > m_atlas_width || next_shelf_y + slot_height > m_atlas_height)
+		{
+			return nullptr;
+		}
+
+		m_shelves.push_back({ next_shelf_y, slot_height, 0 });
+
+		return &m_shelves.back();
+	}
+
+	void FSlateTextureAtlas::copy_data_into_slot(const FAtlasedTextureSlot& slot, uint32_t texture_width, uint32_t texture_height, const uint8_t* data)
+	{
+		const size_t source_stride = (size_t)texture_width * m_bytes_per_pixel;
+		const size_t atlas_stride = (size_t)m_atlas_width * m_bytes_per_pixel;
+
+		for(uint32_t row = 0; row < slot.m_height; ++row)
+		{
+			//padding rows repeat the first or last row of the texture
+			const uint32_t source_row = (uint32_t)std::clamp((int32_t)row - (int32_t)slot.m_padding, 0, (int32_t)texture_height - 1);
+
+			const uint8_t* source = data + source_row * source_stride;
+			uint8_t* dest = m_atlas_data.data() + (slot.m_y + row) * atlas_stride + (size_t)slot.m_x * m_bytes_per_pixel;
+
+			for(uint32_t padding_index = 0; padding_index < slot.m_padding; ++padding_index)
+			{
+				std::memcpy(dest + padding_index * m_bytes_per_pixel, source, m_bytes_per_pixel);
+				std::memcpy(dest + (slot.m_padding + texture_width + padding_index) * m_bytes_per_pixel, source + source_stride - m_bytes_per_pixel, m_bytes_per_pixel);
+			}
+
+			std::memcpy(dest + slot.m_padding * m_bytes_per_pixel, source, source_stride);
+		}
+	}
+}
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <vector>
+
+#include <memory>
+
+namespace DoDo {
+	/*
+	* a rectangle of an atlas page that holds one texture, the padding is part of the rectangle
+	*/
+	struct FAtlasedTextureSlot
+	{
+		/*top left corner of the slot in the page, in pixels*/
+		uint32_t m_x;
+		uint32_t m_y;
+
+		/*size of the slot including the padding on both sides*/
+		uint32_t m_width;
+		uint32_t m_height;
+
+		/*pixels around the texture that repeat its border, so filtering doesn't sample the neighbours*/
+		uint32_t m_padding;
+
+		FAtlasedTextureSlot(uint32_t in_x, uint32_t in_y, uint32_t in_width, uint32_t in_height, uint32_t in_padding)
+			: m_x(in_x)
+			, m_y(in_y)
+			, m_width(in_width)
+			, m_height(in_height)
+			, m_padding(in_padding)
+		{}
+	};
+
+	/*
+	* platform independent atlas page, packs textures into shelves
+	* a shelf is a row as high as the first texture placed in it, textures are appended from left to right
+	* the renderer uploads get_atlas_data() when needs_update() is true
+	*/
+	class FSlateTextureAtlas
+	{
+	public:
+		FSlateTextureAtlas(uint32_t in_width, uint32_t in_height, uint32_t in_bytes_per_pixel, uint32_t in_padding);
+
+		/*
+		* copies a texture into the page
+		*
+		* @param texture_width width of the texture in pixels
+		* @param texture_height height of the texture in pixels
+		* @param data tightly packed pixels of the texture, width * height * bytes per pixel
+		* @return the slot of the texture, nullptr if the page is full
+		*/
+		const FAtlasedTextureSlot* add_texture(uint32_t texture_width, uint32_t texture_height, const uint8_t* data);
+
+		/*
+		* @return the used fraction of the page, 0 to 1, the padding counts as used
+		*/
+		float get_occupancy() const;
+
+		uint32_t get_width() const { return m_atlas_width; }
+
+		uint32_t get_height() const { return m_atlas_height; }
+
+		uint32_t get_bytes_per_pixel() const { return m_bytes_per_pixel; }
+
+		const std::vector<uint8_t>& get_atlas_data() const { return m_atlas_data; }
+
+		/*true when textures were added since the last upload*/
+		bool needs_update() const { return m_b_needs_update; }
+
+		void mark_updated() { m_b_needs_update = false; }
+	private:
+		struct FShelf
+		{
+			uint32_t m_y;
+
+			uint32_t m_height;
+
+			/*x of the next free pixel*/
+			uint32_t m_used_width;
+		};
+
+		/*finds the shelf with the least wasted height, opens a new one below the last shelf if none fits*/
+		FShelf* find_shelf(uint32_t slot_width, uint32_t slot_height);
+
+		/*copies the texture into the slot and repeats its border into the padding*/
+		void copy_data_into_slot(const FAtlasedTextureSlot& slot, uint32_t texture_width, uint32_t texture_height, const uint8_t* data);
+
+		std::vector<uint8_t> m_atlas_data;
+
+		std::vector<FShelf> m_shelves;
+
+		/*unique_ptr keeps the slots at the same address while the page grows*/
+		std::vector<std::unique_ptr<FAtlasedTextureSlot>> m_slots;
+
+		uint32_t m_atlas_width;
+
+		uint32_t m_atlas_height;
+
+		uint32_t m_bytes_per_pixel;
+
+		uint32_t m_padding;
+
+		uint64_t m_used_pixels;
+
+		bool m_b_needs_update;
+	};
+}
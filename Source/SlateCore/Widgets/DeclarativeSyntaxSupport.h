@@ -1,6 +1,7 @@
 #pragma once
 
 #include "SlateCore/Layout/Visibility.h"//FSlateBaseNamedArgs depends on it
+#include "SlateCore/Layout/Clipping.h"//FSlateBaseNamedArgs depends on it
 
 namespace DoDo
 {
@@ -245,6 +246,8 @@ namespace DoDo
 		SLATE_PRIVATE_ATTRIBUTE_VARIABLE(bool, IsEnabled) = true;
 		SLATE_PRIVATE_ATTRIBUTE_VARIABLE(glm::vec2, RenderTransformPivot) = glm::vec2(0.0f, 0.0f);
 
+		EWidgetClipping _Clipping = EWidgetClipping::Inherit;
+
 		std::vector<std::shared_ptr<ISlateMetaData>> m_meta_data;
 	};
 
@@ -275,6 +278,13 @@ namespace DoDo
 			return Me();
 		}
 
+		/*cull the children of this widget against its bounds, see EWidgetClipping*/
+		WidgetArgsType& Clipping(EWidgetClipping in_clipping)
+		{
+			_Clipping = in_clipping;
+			return Me();
+		}
+
 		//todo:implement two arguments
 	};
 
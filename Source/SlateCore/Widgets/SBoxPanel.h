@@ -78,12 +78,16 @@ namespace DoDo {
 				m_size_rule = in_size_param.m_size_rule;
 
 				m_size_value.Assign(*this, std::move(in_size_param.m_value));
+
+				invalidate(EInvalidateWidgetReason::Layout);
 			}
 
 			/*set the max size in SlateUnit this slot can be*/
 			void set_max_size(TAttribute<float> in_max_size)
 			{
 				m_max_size.Assign(*this, std::move(in_max_size));
+
+				invalidate(EInvalidateWidgetReason::Layout);
 			}
 
 		private:
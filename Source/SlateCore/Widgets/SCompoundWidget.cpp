@@ -4,6 +4,7 @@
 #include "SlateCore/Layout/FlowDirection.h"//On_Arrange_Children depends on it
 #include "SlateCore/Layout/LayoutUtils.h"//On_Arrange_Children depends on it
 #include "SlateCore/Styling/WidgetStyle.h"
+#include "SlateCore/Rendering/DrawElements.h"//FSlateWindowElementList depends on it
 
 namespace DoDo {
 	/*
@@ -45,6 +46,12 @@ namespace DoDo {
 
 			FArrangedWidget& the_child = arranged_children[0];
 
+			if(is_child_widget_culled(my_culling_rect, the_child))
+			{
+				out_draw_elements.add_culled_widget();
+				return layer_id;
+			}
+
 			//todo:implement FWidgetStyle
 			FWidgetStyle compounded_widget_style;
 
@@ -4,6 +4,7 @@
 
 #include "SlateCore/Layout/ArrangedChildren.h"
 #include "SlateCore/Types/PaintArgs.h"
+#include "SlateCore/Rendering/DrawElements.h"//FSlateWindowElementList depends on it
 
 namespace DoDo
 {
@@ -37,7 +38,12 @@ namespace DoDo
 		{
 			const FArrangedWidget& current_widget = arranged_children[child_index];
 
-			//todo:implement culling
+			//don't paint children that are entirely outside of the culling rect, this also skips their whole sub tree
+			if(is_child_widget_culled(my_culling_rect, current_widget))
+			{
+				out_draw_elements.add_culled_widget();
+				continue;
+			}
 
 			//dispatch to virtual function
 			const int32_t curr_widgets_max_layer_id = current_widget.m_widget->paint(args, current_widget.m_geometry, my_culling_rect, out_draw_elements, layer_id,
@@ -9,7 +9,10 @@
 #include "SlateCore/Types/SlateAttributeDescriptor.h"
 
 #include "SlateCore/Types/PaintArgs.h"//FPaintArgs depends on it
+#include "SlateCore/Layout/ArrangedWidget.h"//FArrangedWidget depends on it
+#include "SlateCore/Rendering/DrawElements.h"//FSlateWindowElementList depends on it
 #include "SlateCore/Types/SlateMouseEventsMetaData.h"//FSlateMouseEventsMetaData depends on it
+#include "SlateCore/FastUpdate/SlateInvalidationRoot.h"//FSlateInvalidationRoot depends on it
 
 namespace DoDo {
 	//this function will be called at FSlateWidgetClassData construct
@@ -105,7 +108,36 @@ namespace DoDo {
 			in_validate_reason |= EInvalidateWidgetReason::Layout;
 		}
 
-		//todo:implement left part
+		//the cached elements of the owning invalidation root are stale now
+		for(SWidget* widget = this; widget != nullptr;)
+		{
+			if(FSlateInvalidationRoot* invalidation_root = widget->get_as_invalidation_root())
+			{
+				invalidation_root->invalidate_root();
+				break;
+			}
+
+			std::shared_ptr<SWidget> paint_parent = widget->m_persistent_state.m_paint_parent.lock();
+			widget = paint_parent.get();
+		}
+	}
+
+	void SWidget::force_volatile(bool b_force)
+	{
+		if(m_b_force_volatile != b_force)
+		{
+			m_b_force_volatile = b_force;
+			Invalidate(EInvalidateWidgetReason::Volatility);
+		}
+	}
+
+	void SWidget::set_clipping(EWidgetClipping in_clipping)
+	{
+		if(m_clipping != in_clipping)
+		{
+			m_clipping = in_clipping;
+			Invalidate(EInvalidateWidgetReason::Paint);
+		}
 	}
 
 	const FGeometry& SWidget::get_paint_space_geometry() const
@@ -140,6 +172,8 @@ namespace DoDo {
 
 	SWidget::SWidget()
 		: m_b_is_hovered_attribute_set(false)
+		, m_b_force_volatile(false)
+		, m_clipping(EWidgetClipping::Inherit)
 		, m_hovered_attribute(*this, false)
 		, m_b_has_registered_slate_attribute(false)
 		, m_Visibility_Attribute(*this, EVisibility::visible)
@@ -154,6 +188,8 @@ namespace DoDo {
 		//todo:to fix this
 		//m_Visibility_Attribute.Assign(*this, args._Visibility);
 
+		m_clipping = args._Clipping;
+
 		//------append a array to this array------
 		for(size_t i = 0; i < args.m_meta_data.size(); ++i)
 		{
@@ -190,6 +226,7 @@ namespace DoDo {
 		m_persistent_state.m_allotted_geometry = allotted_geometry;
 		m_persistent_state.m_desktop_geometry = desktop_space_geometry;
 		m_persistent_state.m_widget_style = in_widget_style;
+		m_persistent_state.m_culling_bounds = my_culling_rect;
 
 		//todo:assign user index
 		m_persistent_state.m_incoming_flow_direction = g_slate_flow_direction;
@@ -200,12 +237,72 @@ namespace DoDo {
 		//todo:update paint args
 		FPaintArgs updated_args = args.with_new_parent(this);
 
+		//volatile widgets and their children are painted every frame, outside of the cached elements
+		const bool b_paint_volatile = is_volatile() && out_draw_elements.get_cached_element_data() != nullptr;
+		if(b_paint_volatile)
+		{
+			if(!out_draw_elements.is_painting_volatile())
+			{
+				out_draw_elements.get_cached_element_data()->add_volatile_widget(shared_from_this());
+			}
+			out_draw_elements.begin_volatile_paint();
+		}
+
+		//the persistent state keeps the incoming rect, paint_fast_path calculates the culling rect again from it
+		const FSlateRect culling_bounds = calculate_culling_rect(allotted_geometry, my_culling_rect);
+
+		//elements made by this widget are culled against its culling rect
+		out_draw_elements.push_culling_rect(culling_bounds);
+
 		//paint the geometry of this widget
-		int32_t new_layer_id = On_Paint(updated_args, allotted_geometry, my_culling_rect, out_draw_elements, layer_id, in_widget_style, b_parent_enabled);
+		int32_t new_layer_id = On_Paint(updated_args, allotted_geometry, culling_bounds, out_draw_elements, layer_id, in_widget_style, b_parent_enabled);
+
+		out_draw_elements.pop_culling_rect();
+
+		if(b_paint_volatile)
+		{
+			out_draw_elements.end_volatile_paint();
+		}
 
 		return new_layer_id;
 	}
 
+	int32_t SWidget::paint_fast_path(const FPaintArgs& args, FSlateWindowElementList& out_draw_elements) const
+	{
+		return paint(args, m_persistent_state.m_allotted_geometry, m_persistent_state.m_culling_bounds, out_draw_elements, m_persistent_state.m_layer_id,
+			m_persistent_state.m_widget_style, m_persistent_state.m_b_parent_enabled);
+	}
+
+	bool SWidget::is_child_widget_culled(const FSlateRect& my_culling_rect, const FArrangedWidget& arranged_child) const
+	{
+		if(!my_culling_rect.is_valid())
+		{
+			return false;
+		}
+
+		//the render bounding rect is axis aligned, so rotated children are culled conservatively
+		return !FSlateRect::do_rectangles_intersect(my_culling_rect, arranged_child.m_geometry.get_render_bounding_rect());
+	}
+
+	FSlateRect SWidget::calculate_culling_rect(const FGeometry& allotted_geometry, const FSlateRect& incoming_culling_rect) const
+	{
+		if(m_clipping != EWidgetClipping::ClipToBounds)
+		{
+			return incoming_culling_rect;
+		}
+
+		const FSlateRect render_bounds = allotted_geometry.get_render_bounding_rect();
+
+		if(!incoming_culling_rect.is_valid())
+		{
+			return render_bounds;
+		}
+
+		//no overlap gives an empty rect, it culls all children
+		bool b_overlapping = false;
+		return incoming_culling_rect.intersection_with(render_bounds, b_overlapping);
+	}
+
 	FReply SWidget::On_Key_Down(const FGeometry& my_geometry, const FKeyEvent& in_key_event)
 	{
 		//todo:implement support focus
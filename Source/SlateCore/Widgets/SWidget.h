@@ -18,6 +18,7 @@
 #include "Slate/Widgets/Input/Reply.h"
 #include "SlateCore/FastUpdate/WidgetProxy.h"
 #include "SlateCore/Layout/FlowDirection.h"
+#include "SlateCore/Layout/Clipping.h"//m_clipping depends on it
 #include "SlateCore/Types/ISlateMetaData.h"
 #include "SlateCore/Types/WidgetMouseEventsDelegate.h"//FPointerEventHandler depends on it
 
@@ -35,6 +36,8 @@ namespace DoDo
 	class FSlateWindowElementList;
 	class FWidgetStyle;
 	class FArrangedChildren;
+	class FArrangedWidget;
+	class FSlateInvalidationRoot;
 	struct FPointerEvent;
 	class SWidget : public FSlateControlledConstruction, public std::enable_shared_from_this<SWidget>
 	{
@@ -127,6 +130,22 @@ namespace DoDo
 		 */
 		void Invalidate(EInvalidateWidgetReason in_validate_reason);
 
+		/*
+		 * volatile widgets are painted every frame, their elements are never kept in the cached elements of the invalidation root
+		 * use it for widgets whose look changes without calling Invalidate
+		 */
+		void force_volatile(bool b_force);
+
+		bool is_volatile() const { return m_b_force_volatile; }
+
+		/*sets whether the children of this widget are culled against its bounds, see EWidgetClipping*/
+		void set_clipping(EWidgetClipping in_clipping);
+
+		EWidgetClipping get_clipping() const { return m_clipping; }
+
+		/*@return the invalidation root if this widget is one, e.g. SWindow*/
+		virtual FSlateInvalidationRoot* get_as_invalidation_root() { return nullptr; }
+
 	protected:
 		/*
 		a slate attribute that is member variable of a SWidget
@@ -271,7 +290,7 @@ namespace DoDo
 		 *
 		 * @param Args all the arguments necessary to paint this widget(@todo ump: move all params into this struct)
 		 * @param AllottedGeometry the FGeometry that describes an area in which the widget should appear
-		 * @param MyCullingRect the clipping rectangle allocated for this widget and it's children
+		 * @param MyCullingRect the clipping rectangle allocated for this widget and it's children, intersected with the bounds of the widget if it clips
 		 * @param OutDrawElements a list of FDrawElements to populate with the output
 		 * @param LayerId the layer onto which this widget should be rendered
 		 * @param InColorAndOpacity color and opacity to be applied to all the descendants of the widget being paintes
@@ -280,6 +299,13 @@ namespace DoDo
 		 */
 		int32_t paint(const FPaintArgs& args, const FGeometry& allotted_geometry, const FSlateRect& my_culling_rect, FSlateWindowElementList& out_draw_elements, int32_t layer_id, const FWidgetStyle& in_widget_style, bool b_parent_enabled) const;
 
+		/*
+		 * paints this widget again with the state of it's last paint, used by the invalidation root for volatile widgets
+		 *
+		 * @return the maximum layer id attained by this widget or any of it's children
+		 */
+		int32_t paint_fast_path(const FPaintArgs& args, FSlateWindowElementList& out_draw_elements) const;
+
 		/*
 		 * called after a key is pressed when this widget has focus(this event bubbles if not handled)
 		 *
@@ -317,6 +343,24 @@ namespace DoDo
 			return in_parent_enabled && Is_Enabled();
 		}
 
+	protected:
+		/*
+		 * checks if the arranged child is outside the culling rect, culled children and their descendants are not painted
+		 * an invalid culling rect culls nothing
+		 *
+		 * @param MyCullingRect the culling rect of this widget
+		 * @param ArrangedChild the child to test, in window space
+		 * @return true if the child should not be painted
+		 */
+		bool is_child_widget_culled(const FSlateRect& my_culling_rect, const FArrangedWidget& arranged_child) const;
+
+		/*
+		 * the culling rect this widget paints itself and its children with
+		 * a widget that clips to its bounds intersects the culling rect of its parent with its render bounds, so nested clipping widgets
+		 * cull against the smallest of their rects
+		 */
+		FSlateRect calculate_culling_rect(const FGeometry& allotted_geometry, const FSlateRect& incoming_culling_rect) const;
+
 	private:
 		/*
 		 * the widget should respond by populating the OutDrawElements array with FDrawElements
@@ -350,6 +394,11 @@ namespace DoDo
 		/*is the attribute IsHovered is set?*/
 		uint8_t m_b_is_hovered_attribute_set : 1;
 
+		/*is this widget painted every frame, see force_volatile*/
+		uint8_t m_b_force_volatile : 1;
+
+		EWidgetClipping m_clipping;
+
 	private:
 
 		mutable FSlateWidgetPersistentState m_persistent_state;
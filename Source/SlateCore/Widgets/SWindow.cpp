@@ -26,7 +26,8 @@ namespace DoDo {
 	{
 		m_child_slot.operator[](in_content);
 
-		//todo:call Invalidate, child order
+		//the cached elements belong to the old content
+		invalidate_root();
 	}
 
 	bool SWindow::is_screen_space_mouse_within(glm::vec2 screen_space_mouse_coordinate) const
@@ -34,6 +35,12 @@ namespace DoDo {
 		//const glm::vec2 local_mouse_coordinate = screen_space_mouse_coordinate - m_screen_position;//get the local mouse position
 		const glm::vec2 local_mouse_coordinate = screen_space_mouse_coordinate;
 
+		if (!m_native_window)
+		{
+			//offscreen windows aren't on the screen
+			return false;
+		}
+
 		return m_native_window->is_point_in_window(local_mouse_coordinate.x, local_mouse_coordinate.y);//check mouse in the native window
 	}
 
@@ -42,6 +49,7 @@ namespace DoDo {
 		, m_initial_desired_size(glm::vec2(0.0f, 0.0f))
 		, m_size(glm::vec2(0.0f, 0.0f))
 		, m_view_port_size(glm::vec2(0.0f, 0.0f))
+		, m_b_offscreen(false)
 		, m_hittest_grid(std::make_unique<FHittestGrid>())
 	{
 	}
@@ -51,6 +59,10 @@ namespace DoDo {
 		this->m_type = in_args._Type;
 		this->m_title = in_args._Title;
 
+		this->m_b_offscreen = in_args._Offscreen;
+
+		set_allow_element_cache(in_args._AllowElementCache);
+
 		//calculate initial window position
 		glm::vec2 window_position = in_args._ScreenPosition;
 
@@ -100,6 +112,12 @@ namespace DoDo {
 		//todo:clear hittest grid
 		const bool hittest_cleared = m_hittest_grid->Set_Hittest_Area(get_position_in_screen(), get_view_port_size());
 
+		//widgets are only added to the grid when they are painted, the cached ones must be painted again
+		if(hittest_cleared)
+		{
+			invalidate_root();
+		}
+
 		//------construct paint args------
 		FPaintArgs paint_args(nullptr, get_hittest_grid(), get_position_in_screen(), current_time, delta_time);
 		//------construct paint args------
@@ -110,13 +128,19 @@ namespace DoDo {
 		context.m_in_coming_layer_id = 0;
 
 		m_persistent_state.m_allotted_geometry = get_window_geometry_in_window();
-		//todo:implement culling bounds
 
 		FSlateInvalidationResult result = paint_invalidation_root(context);//call FSlateInvalidationRoot's function, to slow path
 
 		return result.m_max_layer_id_painted;
 	}
 
+	FSlateRect SWindow::get_clipping_rectangle_in_window() const
+	{
+		const glm::vec2 view_size = get_view_port_size();
+
+		return FSlateRect(0.0f, 0.0f, view_size.x, view_size.y);
+	}
+
 	std::shared_ptr<Window> SWindow::get_native_window()
 	{
 		return m_native_window;//holds the life time
@@ -159,7 +183,12 @@ namespace DoDo {
 
 	void SWindow::show_window()
 	{
-		if(m_native_window)
+		if(m_b_offscreen)
+		{
+			Application::get().get_renderer()->create_offscreen_view_port(std::static_pointer_cast<SWindow>(shared_from_this()),
+				static_cast<uint32_t>(m_initial_desired_size.x), static_cast<uint32_t>(m_initial_desired_size.y));
+		}
+		else if(m_native_window)
 		{
 			//we can only create a viewport after the window has been shown(otherwise the swap chain creation may fail)
 			Application::get().get_renderer()->create_view_port(std::static_pointer_cast<SWindow>(shared_from_this()));
@@ -194,7 +223,8 @@ namespace DoDo {
 		{
 			m_size = new_size;
 
-			//todo:implement invalidate root child order
+			//cached elements were laid out for the old size
+			invalidate_root();
 		}
 	}
 
@@ -226,7 +256,8 @@ namespace DoDo {
 	{
 		//todo:clear hittest grid
 
-		const FSlateRect window_culling_bounds;
+		//everything outside of the window is culled
+		const FSlateRect window_culling_bounds = get_clipping_rectangle_in_window();
 		const int32_t layer_id = 0;
 
 		//todo:get geometry
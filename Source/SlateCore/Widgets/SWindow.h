@@ -20,6 +20,8 @@ namespace DoDo
 			, _ScreenPosition(glm::vec2(0.0f, 0.0f))
 			, _ClientSize(glm::vec2(0.0f, 0.0f))
 			, _AdjustInitialSizeAndPositionForDPIScale(true)
+			, _AllowElementCache(true)
+			, _Offscreen(false)
 		{}
 			/*type of this window*/
 			SLATE_ARGUMENT(EWindowType, Type)
@@ -31,6 +33,10 @@ namespace DoDo
 			SLATE_ARGUMENT(glm::vec2, ClientSize)
 			/*if the initial ClientSize and ScreenPosition arguments should be automatically adjusted to account for DPI scale*/
 			SLATE_ARGUMENT(bool, AdjustInitialSizeAndPositionForDPIScale)
+			/*keep the elements of non volatile widgets between frames, see FSlateInvalidationRoot::set_allow_element_cache*/
+			SLATE_ARGUMENT(bool, AllowElementCache)
+			/*draw into an image of the client size instead of a native window, see Renderer::create_offscreen_view_port*/
+			SLATE_ARGUMENT(bool, Offscreen)
 
 			SLATE_DEFAULT_SLOT(FArguments, Content)//declare a slot
 
@@ -72,6 +78,9 @@ namespace DoDo
 		/*@return the geometry of the window in window space(i.e. position and absolute position are 0)*/
 		FGeometry get_window_geometry_in_window() const;
 
+		/*@return the clipping rectangle of the window in window space, used as the root culling rect*/
+		FSlateRect get_clipping_rectangle_in_window() const;
+
 		/*paint the window and all of it's contents, not the same as Paint()*/
 		int32_t paint_window(double current_time, float delta_time, FSlateWindowElementList& out_draw_elements, const FWidgetStyle& in_widget_style, bool b_parent_enabled);//todo:implement FWidgetStyle
 
@@ -120,6 +129,12 @@ namespace DoDo
 		/*make the window visible*/
 		void show_window();
 
+		/*@return true if the window is drawn into an image and has no native window*/
+		bool is_offscreen() const
+		{
+			return m_b_offscreen;
+		}
+
 		/*
 		* sets the native os window associated with this SWindow
 		* 
@@ -174,6 +189,9 @@ namespace DoDo
 		/*size of the viewport, if (0, 0) then it is equal to size*/
 		glm::vec2 m_view_port_size;
 
+		/*drawn into an image, read it back with Renderer::read_back_view_port*/
+		bool m_b_offscreen;
+
 	protected:
 		/*the native window that is backing this slate window*/
 		//todo:implement FGenericWindow
@@ -190,6 +208,10 @@ namespace DoDo
 
 	protected:
 
+		//------SWidget overrides------
+		virtual FSlateInvalidationRoot* get_as_invalidation_root() override { return this; }
+		//------SWidget overrides------
+
 		//------FSlateInvalidationRoot overrides------
 		virtual int32_t paint_slow_path(const FSlateInvalidationContext& context) override;
 		//------FSlateInvalidationRoot overrides------
@@ -4,7 +4,41 @@
 
 #include "Core/Delegates/Delegates.h"
 
+#include "SlateCore/Rendering/RenderingCommon.h"
+
+#include "Renderer/Renderer.h"
+
+#include "Platform/Application/NullApplication.h"
+
+#include "Platform/NullRenderer/SlateNullRenderer.h"
+
+#include "SlateCore/Rendering/ElementBatcher.h"
+
+#include "SlateCore/Rendering/SlateDamageTracker.h"
+
+#include "SlateCore/Widgets/SWindow.h"
+
+#include "SlateCore/Layout/Children.h"
+
+#include "SlateCore/Textures/SlateTextureCache.h"
+
+#include "Slate/Widgets/Layout/SBorder.h"
+
+#include "Slate/Widgets/Layout/SConstraintCanvas.h"
+
+#include "Platform/SoftwareRenderer/SlateSoftwareRasterizer.h"
+
+#include "Platform/SoftwareRenderer/SlateSoftwareTextureManager.h"
+
+#include "Core/Misc/QueuedThreadPool.h"
+
 #include <fstream>
+#include <chrono>
+#include <filesystem>
+#include <cstring>
+
+//ctest reports a test returning this as skipped, see SKIP_RETURN_CODE in the cmake lists
+static const int32_t skipped_test_result = 77;
 
 //------test for delegates------
 typedef DoDo::Delegate_Event<int32_t(int32_t, int32_t)> Mouse_Move_Event;
@@ -33,6 +67,1046 @@ public:
 };
 //------test for delegates------
 
+//------test for vertex transform------
+//transforms the 16 corners of a 9-slice box with both the per vertex path and the batched path, then compares and times them
+int32_t test_transform_points()
+{
+    const DoDo::FSlateRenderTransform render_transform(DoDo::FMatrix2x2(0.8f, 0.6f, -0.6f, 0.8f), glm::vec2(120.0f, 45.0f));
+
+    glm::vec2 local_positions[16];
+    for (int32_t i = 0; i < 16; ++i)
+    {
+        local_positions[i] = glm::vec2((i % 4) * 33.0f, (i / 4) * 17.0f);
+    }
+
+    //every count, so the avx2 (SLATE_USE_AVX2), sse2 and scalar tails all run
+    for (int32_t num_points = 1; num_points <= 16; ++num_points)
+    {
+        glm::vec2 simd_positions[16];
+        glm::vec2 scalar_positions[16];
+        DoDo::transform_points(render_transform, local_positions, simd_positions, num_points);
+        DoDo::transform_points_scalar(render_transform, local_positions, scalar_positions, num_points);
+
+        for (int32_t i = 0; i < num_points; ++i)
+        {
+            if (glm::abs(simd_positions[i].x - scalar_positions[i].x) > 1e-4f || glm::abs(simd_positions[i].y - scalar_positions[i].y) > 1e-4f)
+            {
+                std::cout << "transform_points mismatch at " << i << " of " << num_points << std::endl;
+                return -1;
+            }
+        }
+    }
+
+    //------microbenchmark------
+    const int32_t num_boxes = 200000;
+    const glm::vec2 local_size(99.0f, 51.0f);
+    const glm::vec4 tex_coords(0.0f, 0.0f, 1.0f, 1.0f);
+    const glm::vec4 tint(1.0f, 0.5f, 0.25f, 1.0f);
+    const glm::vec4 secondary_color(0.0f, 0.0f, 0.0f, 0.0f);
+
+    DoDo::FSlateVertexArray vertices;
+    vertices.reserve(num_boxes * 16);
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int32_t box = 0; box < num_boxes; ++box)
+    {
+        for (int32_t i = 0; i < 16; ++i)
+        {
+            vertices.emplace_back(DoDo::FSlateVertex::Make<DoDo::ESlateVertexRounding::Disabled>(render_transform, local_positions[i], local_size, 1.0f, tex_coords, tint, secondary_color));
+        }
+    }
+    const double per_vertex_seconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+
+    vertices.clear();
+
+    start = std::chrono::high_resolution_clock::now();
+    for (int32_t box = 0; box < num_boxes; ++box)
+    {
+        const DoDo::FSlateVertexColor packed_tint = DoDo::make_vertex_color(tint);
+        const DoDo::FSlateVertexColor packed_secondary_color = DoDo::make_vertex_color(secondary_color);
+
+        glm::vec2 positions[16];
+        DoDo::transform_points(render_transform, local_positions, positions, 16);
+
+        const size_t first_vertex = vertices.size();
+        vertices.resize(first_vertex + 16);
+        for (int32_t i = 0; i < 16; ++i)
+        {
+            vertices[first_vertex + i].set_transformed<DoDo::ESlateVertexRounding::Disabled>(positions[i], tex_coords, packed_tint, packed_secondary_color, 99, 51);
+        }
+    }
+    const double batched_seconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+
+    const double num_vertices = double(num_boxes) * 16.0;
+    std::cout << "per vertex make: " << num_vertices / per_vertex_seconds << " vertices/s" << std::endl;
+    std::cout << "batched transform: " << num_vertices / batched_seconds << " vertices/s" << std::endl;
+    //------microbenchmark------
+
+    return 0;
+}
+//------test for vertex transform------
+
+//------test for headless frames------
+//ticks the test widget on the null application and the null renderer, so no window system or gpu is needed
+int32_t test_headless_frames()
+{
+    const double fixed_delta_time = 1.0 / 60.0;
+
+    std::shared_ptr<DoDo::FNullApplication> null_application = DoDo::FNullApplication::create_null_application(fixed_delta_time);
+
+    DoDo::Application::Create(null_application);
+
+    std::shared_ptr<DoDo::Renderer> renderer = DoDo::Renderer::Create(DoDo::ERendererType::Null);
+
+    DoDo::Application::get().Initialize_Renderer(renderer);
+
+    DoDo::Application::get().test_create_widget();
+
+    const DoDo::FSlateNullRenderer& null_renderer = static_cast<const DoDo::FSlateNullRenderer&>(*renderer);
+
+    const int32_t num_frames = 300;
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int32_t frame = 0; frame < num_frames; ++frame)
+    {
+        //sweep the cursor over the window and click once a second, hit testing runs like with a real mouse
+        null_application->move_cursor(glm::vec2(200.0f + (frame * 7) % 1280, 200.0f + (frame * 3) % 720));
+        if (frame % 60 == 30)
+        {
+            null_application->press_mouse_button(DoDo::EMouseButtons::Left);
+            null_application->release_mouse_button(DoDo::EMouseButtons::Left);
+        }
+
+        DoDo::Application::get().Tick();
+
+        if (frame > 0 && glm::abs(DoDo::Application::get().get_delta_time() - (float)fixed_delta_time) > 1e-4f)
+        {
+            std::cout << "null application clock isn't fixed" << std::endl;
+            return -1;
+        }
+    }
+    const double seconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+
+    const DoDo::FSlateNullFrameStats& frame_stats = null_renderer.get_frame_stats();
+    if (frame_stats.m_num_windows != 1 || frame_stats.m_num_batches == 0)
+    {
+        std::cout << "headless frame wasn't batched" << std::endl;
+        return -1;
+    }
+
+    std::cout << "headless frame: " << seconds * 1000.0 / num_frames << " ms, " << frame_stats.m_num_batches << " batches, "
+        << frame_stats.m_num_vertices << " vertices, " << frame_stats.m_num_instances << " instances" << std::endl;
+
+    DoDo::Application::shut_down();
+
+    return 0;
+}
+//------test for headless frames------
+
+//------test for damage tracking------
+//a background, a button and a blinking cursor as one quad instance each
+void add_damage_test_batches(DoDo::FSlateBatchData& batch_data, bool b_cursor_visible, float button_x)
+{
+    batch_data.reset_data();
+
+    const glm::vec4 quads[3] = { glm::vec4(0.0f, 0.0f, 800.0f, 600.0f), glm::vec4(button_x, 100.0f, 80.0f, 30.0f), glm::vec4(400.0f, 300.0f, 2.0f, 16.0f) };
+
+    for (int32_t quad_index = 0; quad_index < (b_cursor_visible ? 3 : 2); ++quad_index)
+    {
+        DoDo::FSlateQuadInstance& instance = batch_data.add_instanced_render_batch(quad_index, nullptr, DoDo::ESlateDrawEffect::None).add_instance();
+        instance.m_origin = glm::vec2(quads[quad_index].x, quads[quad_index].y);
+        instance.m_axis_x = glm::vec2(quads[quad_index].z, 0.0f);
+        instance.m_axis_y = glm::vec2(0.0f, quads[quad_index].w);
+        instance.set_uv_rect(glm::vec2(0.0f, 0.0f), glm::vec2(1.0f, 1.0f));
+        instance.m_color = DoDo::make_vertex_color(glm::vec4(1.0f, 1.0f, 1.0f, 1.0f));
+    }
+}
+
+int32_t test_damage_tracker()
+{
+    const glm::vec2 view_port_size(800.0f, 600.0f);
+
+    DoDo::FSlateDamageTracker damage_tracker;
+    DoDo::FSlateBatchData batch_data;
+    std::vector<DoDo::FSlateRect> damage_rects;
+
+    //the first frame has nothing to compare with
+    add_damage_test_batches(batch_data, false, 100.0f);
+    damage_tracker.gather_damage(batch_data, view_port_size);
+    if (damage_tracker.get_damage_since(UINT64_MAX, damage_rects))
+    {
+        std::cout << "a new image must be drawn fully" << std::endl;
+        return -1;
+    }
+
+    const uint64_t first_frame = damage_tracker.get_frame_number();
+
+    add_damage_test_batches(batch_data, false, 100.0f);
+    damage_tracker.gather_damage(batch_data, view_port_size);
+    if (!damage_tracker.get_damage_since(first_frame, damage_rects) || !damage_rects.empty())
+    {
+        std::cout << "an unchanged frame has damage" << std::endl;
+        return -1;
+    }
+
+    //the cursor shows up, an image two frames old needs the same rect
+    add_damage_test_batches(batch_data, true, 100.0f);
+    damage_tracker.gather_damage(batch_data, view_port_size);
+    if (!damage_tracker.get_damage_since(first_frame, damage_rects) || damage_rects.size() != 1 || damage_rects[0].left != 399.0f || damage_rects[0].right != 403.0f)
+    {
+        std::cout << "cursor damage is wrong" << std::endl;
+        return -1;
+    }
+
+    //the button moves, its old and new place are damaged
+    add_damage_test_batches(batch_data, true, 300.0f);
+    damage_tracker.gather_damage(batch_data, view_port_size);
+    if (!damage_tracker.get_damage_since(damage_tracker.get_frame_number() - 1, damage_rects) || damage_rects.size() != 2)
+    {
+        std::cout << "moved button damage is wrong" << std::endl;
+        return -1;
+    }
+
+    //older than the history
+    for (int32_t frame = 0; frame < DoDo::FSlateDamageTracker::max_history_frames; ++frame)
+    {
+        add_damage_test_batches(batch_data, true, 300.0f);
+        damage_tracker.gather_damage(batch_data, view_port_size);
+    }
+    if (damage_tracker.get_damage_since(first_frame, damage_rects))
+    {
+        std::cout << "an image older than the damage history must be drawn fully" << std::endl;
+        return -1;
+    }
+
+    return 0;
+}
+//------test for damage tracking------
+
+//------test for element cache------
+//the window of the test widget keeps its elements, an unchanged frame reuses the cached batches and an invalidated child rebatches them
+int32_t test_element_cache()
+{
+    std::shared_ptr<DoDo::FNullApplication> null_application = DoDo::FNullApplication::create_null_application(1.0 / 60.0);
+
+    DoDo::Application::Create(null_application);
+
+    std::shared_ptr<DoDo::Renderer> renderer = DoDo::Renderer::Create(DoDo::ERendererType::Null);
+
+    DoDo::Application::get().Initialize_Renderer(renderer);
+
+    std::shared_ptr<DoDo::SWindow> window = DoDo::Application::get().test_create_widget();
+
+    const DoDo::FSlateNullRenderer& null_renderer = static_cast<const DoDo::FSlateNullRenderer&>(*renderer);
+
+    if (!window->is_element_cache_allowed())
+    {
+        std::cout << "windows don't cache their elements" << std::endl;
+        return -1;
+    }
+
+    //the first frame paints and batches everything
+    DoDo::Application::get().Tick();
+    const DoDo::FSlateNullFrameStats first_frame_stats = null_renderer.get_frame_stats();
+    if (first_frame_stats.m_num_rebatched_windows != 1 || first_frame_stats.m_num_cached_batches == 0)
+    {
+        std::cout << "the first frame didn't fill the cache" << std::endl;
+        return -1;
+    }
+
+    DoDo::Application::get().Tick();
+    const DoDo::FSlateNullFrameStats unchanged_frame_stats = null_renderer.get_frame_stats();
+    if (unchanged_frame_stats.m_num_rebatched_windows != 0 || unchanged_frame_stats.m_num_cached_batches != first_frame_stats.m_num_cached_batches
+        || unchanged_frame_stats.m_num_batches != first_frame_stats.m_num_batches)
+    {
+        std::cout << "an unchanged frame didn't reuse the cached batches" << std::endl;
+        return -1;
+    }
+
+    //the border inside the window
+    std::shared_ptr<DoDo::SWidget> child = window->Get_Children()->get_child_at(0);
+    child->Invalidate(DoDo::EInvalidateWidgetReason::Paint);
+
+    DoDo::Application::get().Tick();
+    if (null_renderer.get_frame_stats().m_num_rebatched_windows != 1)
+    {
+        std::cout << "an invalidated child didn't rebatch the window" << std::endl;
+        return -1;
+    }
+
+    DoDo::Application::shut_down();
+
+    return 0;
+}
+//------test for element cache------
+
+//------test for texture cache------
+//the cache only checks the size and modification time of the source file, so any bytes stand in for the image
+int32_t test_texture_cache()
+{
+    const std::filesystem::path directory = std::filesystem::temp_directory_path() / "dodo_texture_cache_test";
+    std::filesystem::create_directories(directory);
+
+    const std::filesystem::path source_path = directory / "image.png";
+    const DoDo::DoDoUtf8String source(source_path.string());
+    const DoDo::DoDoUtf8String cache_path((directory / "TextureCache.bin").string());
+
+    std::ofstream(source_path, std::ios::binary | std::ios::trunc) << "not really a png";
+
+    const uint8_t pixels[2 * 3 * 4] = { 255, 0, 0, 255, 0, 255, 0, 255, 0, 0, 255, 255, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12 };
+
+    std::vector<DoDo::FSlateCookedTexture> cooked_textures;
+    cooked_textures.emplace_back(source, 2, 3, pixels);
+    if (!DoDo::FSlateTextureCache::write(cache_path, cooked_textures))
+    {
+        std::cout << "texture cache wasn't written" << std::endl;
+        return -1;
+    }
+
+    uint32_t width = 0;
+    uint32_t height = 0;
+
+    {
+        DoDo::FSlateTextureCache texture_cache;
+        const uint8_t* cached_pixels = texture_cache.open(cache_path) ? texture_cache.find(source, width, height) : nullptr;
+        if (cached_pixels == nullptr || width != 2 || height != 3 || std::memcmp(cached_pixels, pixels, sizeof(pixels)) != 0)
+        {
+            std::cout << "mapped texture cache doesn't hold the written pixels" << std::endl;
+            return -1;
+        }
+    }
+
+    //same size, newer modification time
+    std::filesystem::last_write_time(source_path, std::filesystem::last_write_time(source_path) + std::chrono::seconds(10));
+    {
+        DoDo::FSlateTextureCache texture_cache;
+        if (!texture_cache.open(cache_path) || texture_cache.find(source, width, height) != nullptr)
+        {
+            std::cout << "texture cache entry wasn't rejected after the source was touched" << std::endl;
+            return -1;
+        }
+    }
+
+    //cooked again, then the source grows
+    if (!DoDo::FSlateTextureCache::write(cache_path, cooked_textures))
+    {
+        std::cout << "texture cache wasn't written" << std::endl;
+        return -1;
+    }
+    std::ofstream(source_path, std::ios::binary | std::ios::app) << "more bytes";
+    {
+        DoDo::FSlateTextureCache texture_cache;
+        if (!texture_cache.open(cache_path) || texture_cache.find(source, width, height) != nullptr)
+        {
+            std::cout << "texture cache entry wasn't rejected after the source changed its size" << std::endl;
+            return -1;
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::remove_all(directory, error);
+
+    return 0;
+}
+//------test for texture cache------
+
+//------test for offscreen read back------
+int32_t test_offscreen_read_back()
+{
+    std::shared_ptr<DoDo::FNullApplication> null_application = DoDo::FNullApplication::create_null_application(1.0 / 60.0);
+
+    DoDo::Application::Create(null_application);
+
+    std::shared_ptr<DoDo::Renderer> renderer = DoDo::Renderer::Create(DoDo::ERendererType::Software);
+
+    DoDo::Application::get().Initialize_Renderer(renderer);
+
+    //SNew expands to unqualified names of the namespace
+    using namespace DoDo;
+
+    //the border's brush is a white color brush, tinted red it fills the window
+    std::shared_ptr<SWindow> window;
+    SAssignNew(window, SWindow)
+        .ClientSize(glm::vec2(64.0f, 48.0f))
+        .AdjustInitialSizeAndPositionForDPIScale(false)
+        .Offscreen(true)
+        [
+            SNew(SBorder)
+            .BorderBackgroundColor(glm::vec4(1.0f, 0.0f, 0.0f, 1.0f))
+        ];
+
+    DoDo::Application::get().add_window(window);
+
+    std::vector<uint8_t> pixels;
+    uint32_t width = 0;
+    uint32_t height = 0;
+    if (renderer->read_back_view_port(window.get(), pixels, width, height))
+    {
+        std::cout << "a window that wasn't drawn was read back" << std::endl;
+        return -1;
+    }
+
+    DoDo::Application::get().Tick();
+
+    if (!renderer->read_back_view_port(window.get(), pixels, width, height) || width != 64 || height != 48 || pixels.size() != width * height * 4)
+    {
+        std::cout << "the offscreen view port wasn't read back" << std::endl;
+        return -1;
+    }
+
+    const uint8_t* center = pixels.data() + ((height / 2) * width + width / 2) * 4;
+    if (center[0] != 255 || center[1] != 0 || center[2] != 0 || center[3] != 255)
+    {
+        std::cout << "the center pixel is " << (int32_t)center[0] << " " << (int32_t)center[1] << " " << (int32_t)center[2] << " " << (int32_t)center[3]
+            << " instead of the border color" << std::endl;
+        return -1;
+    }
+
+    DoDo::Application::shut_down();
+
+    return 0;
+}
+//------test for offscreen read back------
+
+//------test for software rasterizer------
+void add_rasterizer_test_triangle(DoDo::FSlateBatchData& batch_data, int32_t layer, const glm::vec2 (&positions)[3], const glm::vec4& color)
+{
+    DoDo::FSlateRenderBatch& render_batch = batch_data.add_render_batch(layer, nullptr, DoDo::ESlateDrawPrimitive::TriangleList, DoDo::ESlateDrawEffect::None);
+
+    DoDo::FSlateVertex* vertices = render_batch.add_uninitialized_vertices(3);
+    for (int32_t vertex_index = 0; vertex_index < 3; ++vertex_index)
+    {
+        vertices[vertex_index].set_transformed<DoDo::ESlateVertexRounding::Disabled>(positions[vertex_index], glm::vec4(0.0f), DoDo::make_vertex_color(color),
+            DoDo::make_vertex_color(color), 0, 0);
+    }
+
+    static const DoDo::SlateIndex triangle_indices[3] = { 0, 1, 2 };
+    render_batch.add_indices(triangle_indices, 3);
+}
+
+bool check_rasterizer_test_pixel(const DoDo::FSlateSoftwareFramebuffer& framebuffer, uint32_t x, uint32_t y, const uint8_t (&expected)[4])
+{
+    const uint8_t* pixel = framebuffer.m_pixels.data() + ((size_t)y * framebuffer.m_width + x) * 4;
+    if (std::memcmp(pixel, expected, 4) != 0)
+    {
+        std::cout << "pixel " << x << " " << y << " is " << (int32_t)pixel[0] << " " << (int32_t)pixel[1] << " " << (int32_t)pixel[2] << " " << (int32_t)pixel[3]
+            << " instead of " << (int32_t)expected[0] << " " << (int32_t)expected[1] << " " << (int32_t)expected[2] << " " << (int32_t)expected[3] << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+//a solid quad, a textured quad across two tiles and a square split on its diagonal, drawn with different numbers of threads
+int32_t test_software_rasterizer()
+{
+    const uint8_t clear_color[4] = { 0, 0, 102, 255 };
+    const uint8_t red[4] = { 255, 0, 0, 255 };
+    const uint8_t green[4] = { 0, 255, 0, 255 };
+    const uint8_t blue[4] = { 0, 0, 255, 255 };
+    const uint8_t white[4] = { 255, 255, 255, 255 };
+
+    DoDo::FSlateSoftwareTexture white_texture(1, 1, std::vector<uint8_t>(white, white + 4));
+
+    //2x2 texels, every texel covers 16x16 pixels of the quad
+    std::vector<uint8_t> texels;
+    for (const uint8_t* texel : { red, green, blue, white })
+    {
+        texels.insert(texels.end(), texel, texel + 4);
+    }
+    DoDo::FSlateSoftwareTexture texture(2, 2, std::move(texels));
+
+    DoDo::FSlateBatchData batch_data;
+
+    //the solid quad covers the pixels 4..35 x 4..19
+    add_rasterizer_test_triangle(batch_data, 0, { glm::vec2(4.0f, 4.0f), glm::vec2(36.0f, 4.0f), glm::vec2(4.0f, 20.0f) }, glm::vec4(1.0f, 0.0f, 0.0f, 1.0f));
+    add_rasterizer_test_triangle(batch_data, 0, { glm::vec2(4.0f, 20.0f), glm::vec2(36.0f, 4.0f), glm::vec2(36.0f, 20.0f) }, glm::vec4(1.0f, 0.0f, 0.0f, 1.0f));
+
+    //the textured quad covers the pixels 40..71 x 24..55, across the first tile edge at x 64
+    DoDo::FSlateQuadInstance& instance = batch_data.add_instanced_render_batch(1, &texture, DoDo::ESlateDrawEffect::None).add_instance();
+    instance.m_origin = glm::vec2(40.0f, 24.0f);
+    instance.m_axis_x = glm::vec2(32.0f, 0.0f);
+    instance.m_axis_y = glm::vec2(0.0f, 32.0f);
+    instance.set_uv_rect(glm::vec2(0.0f, 0.0f), glm::vec2(1.0f, 1.0f));
+    instance.m_color = DoDo::make_vertex_color(glm::vec4(1.0f, 1.0f, 1.0f, 1.0f));
+
+    //the edges of the square run through pixel centers, the top left rule gives every pixel to one triangle
+    //the diagonal is the left edge of the upper triangle and the right edge of the lower one
+    add_rasterizer_test_triangle(batch_data, 2, { glm::vec2(80.5f, 8.5f), glm::vec2(96.5f, 8.5f), glm::vec2(96.5f, 24.5f) }, glm::vec4(0.0f, 1.0f, 0.0f, 1.0f));
+    add_rasterizer_test_triangle(batch_data, 2, { glm::vec2(80.5f, 8.5f), glm::vec2(96.5f, 24.5f), glm::vec2(80.5f, 24.5f) }, glm::vec4(0.0f, 0.0f, 1.0f, 1.0f));
+
+    batch_data.merge_render_batches();
+
+    std::vector<DoDo::FSlateVertex> vertices(batch_data.get_num_final_vertices());
+    std::vector<DoDo::SlateIndex> indices(batch_data.get_num_final_indices());
+    std::vector<DoDo::FSlateQuadInstance> instances(batch_data.get_num_final_instances());
+    batch_data.copy_final_data(vertices.data(), indices.data(), instances.data());
+
+    std::vector<uint8_t> first_pixels;
+    for (int32_t num_threads : { 1, 2, 7 })
+    {
+        DoDo::FQueuedThreadPool thread_pool(num_threads);
+        DoDo::FSlateSoftwareRasterizer rasterizer(&thread_pool);
+
+        DoDo::FSlateSoftwareFramebuffer framebuffer;
+        framebuffer.resize(160, 72);
+        rasterizer.clear(framebuffer, clear_color);
+        rasterizer.draw_batches(batch_data, vertices.data(), indices.data(), instances.data(), &white_texture, framebuffer);
+
+        const bool b_pixels_match =
+            //solid quad and its edges
+            check_rasterizer_test_pixel(framebuffer, 4, 4, red) && check_rasterizer_test_pixel(framebuffer, 35, 19, red)
+            && check_rasterizer_test_pixel(framebuffer, 3, 4, clear_color) && check_rasterizer_test_pixel(framebuffer, 36, 19, clear_color)
+            && check_rasterizer_test_pixel(framebuffer, 35, 20, clear_color)
+            //one pixel of every texel, the green and white texels are in the second tile
+            && check_rasterizer_test_pixel(framebuffer, 40, 24, red) && check_rasterizer_test_pixel(framebuffer, 71, 24, green)
+            && check_rasterizer_test_pixel(framebuffer, 40, 55, blue) && check_rasterizer_test_pixel(framebuffer, 71, 55, white)
+            && check_rasterizer_test_pixel(framebuffer, 72, 55, clear_color) && check_rasterizer_test_pixel(framebuffer, 71, 56, clear_color);
+        if (!b_pixels_match)
+        {
+            return -1;
+        }
+
+        //the left and top edges of the square are in, the right and bottom edges are out, the diagonal belongs to the upper triangle
+        for (uint32_t y = 7; y <= 25; ++y)
+        {
+            for (uint32_t x = 79; x <= 97; ++x)
+            {
+                const bool b_inside = x >= 80 && x < 96 && y >= 8 && y < 24;
+                const bool b_upper = x - 80 >= y - 8;
+                if (!check_rasterizer_test_pixel(framebuffer, x, y, b_inside ? (b_upper ? green : blue) : clear_color))
+                {
+                    return -1;
+                }
+            }
+        }
+
+        if (first_pixels.empty())
+        {
+            first_pixels = framebuffer.m_pixels;
+        }
+        else if (first_pixels != framebuffer.m_pixels)
+        {
+            std::cout << "drawing with " << num_threads << " threads changed the pixels" << std::endl;
+            return -1;
+        }
+    }
+
+    return 0;
+}
+//------test for software rasterizer------
+
+//------test for vulkan offscreen read back------
+//draws a border inside a border into an offscreen window with the renderer and reads one frame back
+//@return 1 if the renderer can't be initialized, e.g. there is no vulkan device
+int32_t read_back_offscreen_scene(DoDo::ERendererType renderer_type, std::vector<uint8_t>& out_pixels, uint32_t& out_width, uint32_t& out_height)
+{
+    std::shared_ptr<DoDo::FNullApplication> null_application = DoDo::FNullApplication::create_null_application(1.0 / 60.0);
+
+    DoDo::Application::Create(null_application);
+
+    std::shared_ptr<DoDo::Renderer> renderer = DoDo::Renderer::Create(renderer_type);
+
+    DoDo::Application::get().Initialize_Renderer(renderer);
+
+    if (!renderer->initialize())
+    {
+        return 1;
+    }
+
+    using namespace DoDo;
+
+    std::shared_ptr<SWindow> window;
+    SAssignNew(window, SWindow)
+        .ClientSize(glm::vec2(96.0f, 64.0f))
+        .AdjustInitialSizeAndPositionForDPIScale(false)
+        .Offscreen(true)
+        [
+            SNew(SBorder)
+            .BorderBackgroundColor(glm::vec4(1.0f, 0.0f, 0.0f, 1.0f))
+            .Padding(FMargin(8.0f, 12.0f))
+            [
+                SNew(SBorder)
+                .BorderBackgroundColor(glm::vec4(0.0f, 1.0f, 0.0f, 1.0f))
+            ]
+        ];
+
+    DoDo::Application::get().add_window(window);
+
+    DoDo::Application::get().Tick();
+
+    const bool b_read_back = renderer->read_back_view_port(window.get(), out_pixels, out_width, out_height);
+
+    DoDo::Application::shut_down();
+
+    return b_read_back ? 0 : -1;
+}
+
+//the gpu and the software rasterizer follow the same rules, the same scene gives the same pixels
+int32_t test_vulkan_offscreen_read_back()
+{
+    std::vector<uint8_t> vulkan_pixels;
+    uint32_t vulkan_width = 0;
+    uint32_t vulkan_height = 0;
+    const int32_t vulkan_result = read_back_offscreen_scene(DoDo::ERendererType::Vulkan, vulkan_pixels, vulkan_width, vulkan_height);
+    if (vulkan_result == 1)
+    {
+        std::cout << "no vulkan device, skipped" << std::endl;
+        return skipped_test_result;
+    }
+
+    std::vector<uint8_t> software_pixels;
+    uint32_t software_width = 0;
+    uint32_t software_height = 0;
+    if (vulkan_result != 0 || read_back_offscreen_scene(DoDo::ERendererType::Software, software_pixels, software_width, software_height) != 0)
+    {
+        std::cout << "the offscreen view port wasn't read back" << std::endl;
+        return -1;
+    }
+
+    if (vulkan_width != software_width || vulkan_height != software_height || vulkan_pixels.size() != software_pixels.size())
+    {
+        std::cout << "the read back sizes differ" << std::endl;
+        return -1;
+    }
+
+    //one step of rounding is allowed for the conversion of the colors on the gpu
+    for (size_t channel_index = 0; channel_index < vulkan_pixels.size(); ++channel_index)
+    {
+        if (std::abs((int32_t)vulkan_pixels[channel_index] - (int32_t)software_pixels[channel_index]) > 1)
+        {
+            const size_t pixel_index = channel_index / 4;
+            std::cout << "pixel " << pixel_index % vulkan_width << " " << pixel_index / vulkan_width << " differs from the software rasterizer" << std::endl;
+            return -1;
+        }
+    }
+
+    return 0;
+}
+//------test for vulkan offscreen read back------
+
+//------test for damage redraw------
+//one or two small boxes on a canvas, the window paints no background around them
+std::shared_ptr<DoDo::SWidget> make_damage_redraw_canvas(bool b_with_second_box)
+{
+    using namespace DoDo;
+
+    if (!b_with_second_box)
+    {
+        return SNew(SConstraintCanvas)
+            + SConstraintCanvas::Slot()
+            .Offset(FMargin(8.0f, 8.0f, 16.0f, 16.0f))
+            [
+                SNew(SBorder)
+                .BorderBackgroundColor(glm::vec4(0.0f, 1.0f, 0.0f, 1.0f))
+            ];
+    }
+
+    return SNew(SConstraintCanvas)
+        + SConstraintCanvas::Slot()
+        .Offset(FMargin(8.0f, 8.0f, 16.0f, 16.0f))
+        [
+            SNew(SBorder)
+            .BorderBackgroundColor(glm::vec4(0.0f, 1.0f, 0.0f, 1.0f))
+        ]
+        + SConstraintCanvas::Slot()
+        .Offset(FMargin(40.0f, 8.0f, 16.0f, 16.0f))
+        [
+            SNew(SBorder)
+            .BorderBackgroundColor(glm::vec4(1.0f, 0.0f, 0.0f, 1.0f))
+        ];
+}
+
+//a removed widget is only damage, the redraw of its area must clear the old pixels of the image
+int32_t test_damage_redraw_clears_removed_widgets()
+{
+    std::shared_ptr<DoDo::FNullApplication> null_application = DoDo::FNullApplication::create_null_application(1.0 / 60.0);
+
+    DoDo::Application::Create(null_application);
+
+    std::shared_ptr<DoDo::Renderer> renderer = DoDo::Renderer::Create(DoDo::ERendererType::Vulkan);
+
+    DoDo::Application::get().Initialize_Renderer(renderer);
+
+    if (!renderer->initialize())
+    {
+        std::cout << "no vulkan device, skipped" << std::endl;
+        return skipped_test_result;
+    }
+
+    using namespace DoDo;
+
+    std::shared_ptr<SWindow> window;
+    SAssignNew(window, SWindow)
+        .ClientSize(glm::vec2(96.0f, 64.0f))
+        .AdjustInitialSizeAndPositionForDPIScale(false)
+        .Offscreen(true)
+        [
+            make_damage_redraw_canvas(true)
+        ];
+
+    DoDo::Application::get().add_window(window);
+
+    DoDo::Application::get().Tick();
+
+    //the damage is the bounds of the two boxes, well under the part of the window that is redrawn fully
+    window->set_content(make_damage_redraw_canvas(false));
+
+    DoDo::Application::get().Tick();
+
+    std::vector<uint8_t> pixels;
+    uint32_t width = 0;
+    uint32_t height = 0;
+    if (!renderer->read_back_view_port(window.get(), pixels, width, height) || width != 96 || height != 64)
+    {
+        std::cout << "the offscreen view port wasn't read back" << std::endl;
+        return -1;
+    }
+
+    const uint8_t clear_color[4] = { 0, 0, 102, 255 };
+    const uint8_t green[4] = { 0, 255, 0, 255 };
+
+    const uint8_t* removed_box_pixel = pixels.data() + (16 * width + 48) * 4;
+    const uint8_t* kept_box_pixel = pixels.data() + (16 * width + 16) * 4;
+    for (int32_t channel = 0; channel < 4; ++channel)
+    {
+        if (std::abs((int32_t)removed_box_pixel[channel] - (int32_t)clear_color[channel]) > 1)
+        {
+            std::cout << "the removed box is still drawn" << std::endl;
+            return -1;
+        }
+
+        if (std::abs((int32_t)kept_box_pixel[channel] - (int32_t)green[channel]) > 1)
+        {
+            std::cout << "the kept box is gone" << std::endl;
+            return -1;
+        }
+    }
+
+    DoDo::Application::shut_down();
+
+    return 0;
+}
+//------test for damage redraw------
+
+//------test for element cache layout------
+bool check_element_cache_test_pixel(const std::vector<uint8_t>& pixels, uint32_t width, uint32_t x, uint32_t y, const uint8_t (&expected)[4])
+{
+    const uint8_t* pixel = pixels.data() + ((size_t)y * width + x) * 4;
+    for (int32_t channel = 0; channel < 4; ++channel)
+    {
+        if (std::abs((int32_t)pixel[channel] - (int32_t)expected[channel]) > 1)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+//the padding of a cached border changes, the inner border must be drawn with the new layout on the next frame
+int32_t test_element_cache_layout()
+{
+    std::shared_ptr<DoDo::FNullApplication> null_application = DoDo::FNullApplication::create_null_application(1.0 / 60.0);
+
+    DoDo::Application::Create(null_application);
+
+    std::shared_ptr<DoDo::Renderer> renderer = DoDo::Renderer::Create(DoDo::ERendererType::Software);
+
+    DoDo::Application::get().Initialize_Renderer(renderer);
+
+    using namespace DoDo;
+
+    std::shared_ptr<SBorder> outer_border;
+    std::shared_ptr<SWindow> window;
+    SAssignNew(window, SWindow)
+        .ClientSize(glm::vec2(64.0f, 48.0f))
+        .AdjustInitialSizeAndPositionForDPIScale(false)
+        .Offscreen(true)
+        [
+            SAssignNew(outer_border, SBorder)
+            .BorderBackgroundColor(glm::vec4(1.0f, 0.0f, 0.0f, 1.0f))
+            .Padding(FMargin(16.0f))
+            [
+                SNew(SBorder)
+                .BorderBackgroundColor(glm::vec4(0.0f, 1.0f, 0.0f, 1.0f))
+            ]
+        ];
+
+    DoDo::Application::get().add_window(window);
+
+    if (!window->is_element_cache_allowed())
+    {
+        std::cout << "windows don't cache their elements" << std::endl;
+        return -1;
+    }
+
+    const uint8_t red[4] = { 255, 0, 0, 255 };
+    const uint8_t green[4] = { 0, 255, 0, 255 };
+
+    std::vector<uint8_t> pixels;
+    uint32_t width = 0;
+    uint32_t height = 0;
+
+    //the second frame draws the cached elements
+    DoDo::Application::get().Tick();
+    DoDo::Application::get().Tick();
+
+    if (!renderer->read_back_view_port(window.get(), pixels, width, height) || width != 64 || height != 48)
+    {
+        std::cout << "the offscreen view port wasn't read back" << std::endl;
+        return -1;
+    }
+
+    if (!check_element_cache_test_pixel(pixels, width, 8, 8, red) || !check_element_cache_test_pixel(pixels, width, 32, 24, green))
+    {
+        std::cout << "the padded inner border isn't drawn inside the outer border" << std::endl;
+        return -1;
+    }
+
+    //nothing else invalidates the window
+    outer_border->set_padding(FMargin(4.0f));
+
+    DoDo::Application::get().Tick();
+
+    if (!renderer->read_back_view_port(window.get(), pixels, width, height) || width != 64 || height != 48)
+    {
+        std::cout << "the offscreen view port wasn't read back" << std::endl;
+        return -1;
+    }
+
+    if (!check_element_cache_test_pixel(pixels, width, 8, 8, green) || !check_element_cache_test_pixel(pixels, width, 2, 2, red))
+    {
+        std::cout << "the inner border still has the geometry of the old padding" << std::endl;
+        return -1;
+    }
+
+    DoDo::Application::shut_down();
+
+    return 0;
+}
+//------test for element cache layout------
+
+//------test for batch merging------
+DoDo::FSlateRenderBatch& add_merge_test_batch(DoDo::FSlateBatchData& batch_data, int32_t layer, DoDo::ESlateDrawEffect draw_effect, int32_t num_vertices, const std::vector<DoDo::SlateIndex>& indices)
+{
+    DoDo::FSlateRenderBatch& render_batch = batch_data.add_render_batch(layer, nullptr, DoDo::ESlateDrawPrimitive::TriangleList, draw_effect);
+
+    render_batch.add_uninitialized_vertices(num_vertices);
+    render_batch.add_indices(indices.data(), (int32_t)indices.size());
+
+    return render_batch;
+}
+
+//batches of a layer with the same state are merged and their indices rebased, across layers, states and the index range they are not
+int32_t test_batch_merging()
+{
+    DoDo::FSlateBatchData batch_data;
+
+    //added out of layer order, the merge sorts them stably by layer
+    add_merge_test_batch(batch_data, 0, DoDo::ESlateDrawEffect::None, 4, { 0, 1, 2, 2, 1, 3 });
+    add_merge_test_batch(batch_data, 1, DoDo::ESlateDrawEffect::None, 3, { 0, 1, 2 });
+    add_merge_test_batch(batch_data, 0, DoDo::ESlateDrawEffect::None, 4, { 0, 1, 2, 2, 1, 3 });
+    add_merge_test_batch(batch_data, 1, DoDo::ESlateDrawEffect::NoBlending, 3, { 0, 1, 2 });
+
+    //together they have more vertices than a 16 bit index can address
+    add_merge_test_batch(batch_data, 2, DoDo::ESlateDrawEffect::None, 65000, { 0, 1, 2 });
+    add_merge_test_batch(batch_data, 2, DoDo::ESlateDrawEffect::None, 1000, { 997, 998, 999 });
+
+    batch_data.merge_render_batches();
+
+    const bool b_32bit_indices = sizeof(DoDo::SlateIndex) == sizeof(uint32_t);
+
+    //the batch of the same layer and state, and with 32 bit indices the large batch of layer 2
+    const int32_t expected_merged_batches = b_32bit_indices ? 2 : 1;
+    if (batch_data.get_num_merged_batches() != expected_merged_batches || batch_data.get_num_final_batches() != 6 - expected_merged_batches)
+    {
+        std::cout << "merged " << batch_data.get_num_merged_batches() << " of 6 batches into " << batch_data.get_num_final_batches() << std::endl;
+        return -1;
+    }
+
+    const std::vector<DoDo::FSlateRenderBatch>& render_batches = batch_data.get_render_batches();
+
+    //the linked list only visits the batches that are drawn
+    std::vector<int32_t> drawn_batches;
+    for (int32_t batch_index = batch_data.get_first_render_batch_index(); batch_index != -1; batch_index = render_batches[batch_index].m_next_batch_index)
+    {
+        drawn_batches.push_back(batch_index);
+    }
+
+    const std::vector<int32_t> expected_drawn_batches = b_32bit_indices ? std::vector<int32_t>{ 0, 1, 3, 4 } : std::vector<int32_t>{ 0, 1, 3, 4, 5 };
+    if (drawn_batches != expected_drawn_batches || render_batches[0].m_num_indices != 12 || render_batches[0].m_num_vertices != 8)
+    {
+        std::cout << "the batches of layer 0 weren't merged into the first one" << std::endl;
+        return -1;
+    }
+
+    if (batch_data.get_num_final_vertices() != 4 + 3 + 4 + 3 + 65000 + 1000 || batch_data.get_num_final_indices() != 6 + 3 + 6 + 3 + 3 + 3)
+    {
+        std::cout << "the final buffers have " << batch_data.get_num_final_vertices() << " vertices and " << batch_data.get_num_final_indices() << " indices" << std::endl;
+        return -1;
+    }
+
+    std::vector<DoDo::FSlateVertex> vertices(batch_data.get_num_final_vertices());
+    std::vector<DoDo::SlateIndex> indices(batch_data.get_num_final_indices());
+    batch_data.copy_final_data(vertices.data(), indices.data(), nullptr);
+
+    //the merged batch follows the 4 vertices of the first one, the last batch is rebased only if it was merged
+    const DoDo::SlateIndex last_base_vertex = b_32bit_indices ? 65000 : 0;
+    const std::vector<DoDo::SlateIndex> expected_indices = {
+        0, 1, 2, 2, 1, 3,
+        4, 5, 6, 6, 5, 7,
+        0, 1, 2,
+        0, 1, 2,
+        0, 1, 2,
+        (DoDo::SlateIndex)(997 + last_base_vertex), (DoDo::SlateIndex)(998 + last_base_vertex), (DoDo::SlateIndex)(999 + last_base_vertex) };
+    if (indices != expected_indices)
+    {
+        std::cout << "final indices:";
+        for (const DoDo::SlateIndex index : indices)
+        {
+            std::cout << " " << index;
+        }
+        std::cout << std::endl;
+        return -1;
+    }
+
+    //each drawn batch starts where the batch before it ends in the final buffers
+    int32_t vertex_offset = 0;
+    int32_t index_offset = 0;
+    for (const int32_t batch_index : drawn_batches)
+    {
+        const DoDo::FSlateRenderBatch& render_batch = render_batches[batch_index];
+        if (render_batch.m_vertex_offset != vertex_offset || render_batch.m_index_offset != index_offset)
+        {
+            std::cout << "batch " << batch_index << " starts at vertex " << render_batch.m_vertex_offset << " and index " << render_batch.m_index_offset << std::endl;
+            return -1;
+        }
+
+        vertex_offset += render_batch.m_num_vertices;
+        index_offset += render_batch.m_num_indices;
+    }
+
+    return 0;
+}
+//------test for batch merging------
+//------test for culling------
+//one visible box, the culling canvas adds boxes that are culled and must not change the batched data
+std::shared_ptr<DoDo::SWidget> make_culling_canvas(bool b_with_culled_boxes)
+{
+    using namespace DoDo;
+
+    if (!b_with_culled_boxes)
+    {
+        return SNew(SConstraintCanvas)
+            + SConstraintCanvas::Slot()
+            .Offset(FMargin(8.0f, 8.0f, 16.0f, 16.0f))
+            [
+                SNew(SBorder)
+                .BorderBackgroundColor(glm::vec4(0.0f, 1.0f, 0.0f, 1.0f))
+            ];
+    }
+
+    return SNew(SConstraintCanvas)
+        + SConstraintCanvas::Slot()
+        .Offset(FMargin(8.0f, 8.0f, 16.0f, 16.0f))
+        [
+            SNew(SBorder)
+            .BorderBackgroundColor(glm::vec4(0.0f, 1.0f, 0.0f, 1.0f))
+        ]
+        //outside of the window, a culled widget
+        + SConstraintCanvas::Slot()
+        .Offset(FMargin(100.0f, 100.0f, 16.0f, 16.0f))
+        [
+            SNew(SBorder)
+            .BorderBackgroundColor(glm::vec4(1.0f, 0.0f, 0.0f, 1.0f))
+        ]
+        //inside of the window but outside of the clip rect of its parent, a culled widget
+        + SConstraintCanvas::Slot()
+        .Offset(FMargin(8.0f, 24.0f, 16.0f, 16.0f))
+        [
+            SNew(SConstraintCanvas)
+            .Clipping(EWidgetClipping::ClipToBounds)
+            + SConstraintCanvas::Slot()
+            .Offset(FMargin(20.0f, 0.0f, 8.0f, 8.0f))
+            [
+                SNew(SBorder)
+                .BorderBackgroundColor(glm::vec4(1.0f, 0.0f, 0.0f, 1.0f))
+            ]
+        ]
+        //fully transparent, a culled element
+        + SConstraintCanvas::Slot()
+        .Offset(FMargin(40.0f, 8.0f, 16.0f, 16.0f))
+        [
+            SNew(SBorder)
+            .BorderBackgroundColor(glm::vec4(1.0f, 0.0f, 0.0f, 0.0f))
+        ];
+}
+
+//children outside of the window or the clip rect of their parent make no elements and are counted as culled
+int32_t test_culling()
+{
+    std::shared_ptr<DoDo::FNullApplication> null_application = DoDo::FNullApplication::create_null_application(1.0 / 60.0);
+
+    DoDo::Application::Create(null_application);
+
+    std::shared_ptr<DoDo::Renderer> renderer = DoDo::Renderer::Create(DoDo::ERendererType::Null);
+
+    DoDo::Application::get().Initialize_Renderer(renderer);
+
+    using namespace DoDo;
+
+    //without the element cache every frame is painted, so the culled counters are counted every frame
+    std::shared_ptr<SWindow> window;
+    SAssignNew(window, SWindow)
+        .ClientSize(glm::vec2(64.0f, 48.0f))
+        .AdjustInitialSizeAndPositionForDPIScale(false)
+        .Offscreen(true)
+        .AllowElementCache(false)
+        [
+            make_culling_canvas(false)
+        ];
+
+    DoDo::Application::get().add_window(window);
+
+    const FSlateNullRenderer& null_renderer = static_cast<const FSlateNullRenderer&>(*renderer);
+
+    DoDo::Application::get().Tick();
+
+    const FSlateNullFrameStats visible_stats = null_renderer.get_frame_stats();
+    if (visible_stats.m_num_windows != 1 || visible_stats.m_num_batches == 0)
+    {
+        std::cout << "the visible box wasn't batched" << std::endl;
+        return -1;
+    }
+
+    window->set_content(make_culling_canvas(true));
+
+    DoDo::Application::get().Tick();
+
+    const FSlateNullFrameStats& culled_stats = null_renderer.get_frame_stats();
+    if (culled_stats.m_num_batches != visible_stats.m_num_batches || culled_stats.m_num_vertices != visible_stats.m_num_vertices
+        || culled_stats.m_num_indices != visible_stats.m_num_indices || culled_stats.m_num_instances != visible_stats.m_num_instances)
+    {
+        std::cout << "culled boxes were batched: " << culled_stats.m_num_vertices << " vertices, " << culled_stats.m_num_instances
+            << " instances, expected " << visible_stats.m_num_vertices << " vertices, " << visible_stats.m_num_instances << " instances" << std::endl;
+        return -1;
+    }
+
+    const uint32_t num_culled_widgets = culled_stats.m_num_culled_widgets - visible_stats.m_num_culled_widgets;
+    const uint32_t num_culled_elements = culled_stats.m_num_culled_elements - visible_stats.m_num_culled_elements;
+    if (num_culled_widgets != 2 || num_culled_elements != 1)
+    {
+        std::cout << "culled " << num_culled_widgets << " widgets and " << num_culled_elements << " elements, expected 2 widgets and 1 element" << std::endl;
+        return -1;
+    }
+
+    DoDo::Application::shut_down();
+
+    return 0;
+}
+//------test for culling------
+
 int main(int argc, char* argv[])
 {
     if (argc < 2 || argv[1] == std::string("1"))
@@ -56,6 +1130,54 @@ int main(int argc, char* argv[])
             return -1;
         return 0;
     }
+    else if (argv[1] == std::string("4"))
+    {
+        return test_transform_points();
+    }
+    else if (argv[1] == std::string("5"))
+    {
+        return test_headless_frames();
+    }
+    else if (argv[1] == std::string("6"))
+    {
+        return test_damage_tracker();
+    }
+    else if (argv[1] == std::string("7"))
+    {
+        return test_element_cache();
+    }
+    else if (argv[1] == std::string("8"))
+    {
+        return test_texture_cache();
+    }
+    else if (argv[1] == std::string("9"))
+    {
+        return test_offscreen_read_back();
+    }
+    else if (argv[1] == std::string("10"))
+    {
+        return test_software_rasterizer();
+    }
+    else if (argv[1] == std::string("11"))
+    {
+        return test_vulkan_offscreen_read_back();
+    }
+    else if (argv[1] == std::string("12"))
+    {
+        return test_damage_redraw_clears_removed_widgets();
+    }
+    else if (argv[1] == std::string("13"))
+    {
+        return test_element_cache_layout();
+    }
+    else if (argv[1] == std::string("14"))
+    {
+        return test_batch_merging();
+    }
+    else if (argv[1] == std::string("15"))
+    {
+        return test_culling();
+    }
     else if (argc < 3 || argv[1] == std::string("3"))
     {
         //------test for delegates------